@@ -0,0 +1,492 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "allscale/api/core/data.h"
+#include "allscale/api/core/io.h"
+#include "allscale/api/core/prec.h"
+
+#include "allscale/utils/assert.h"
+#include "allscale/utils/serializer.h"
+
+namespace allscale {
+namespace api {
+namespace core {
+
+	namespace detail {
+
+		constexpr std::uint32_t CHECKPOINT_MAGIC = 0x50434c41;		// "ALCP"
+
+		constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+
+		/**
+		 * The header of a single checkpoint, stored as the payload of a record with the
+		 * header id, followed by the records of all fragments with data in this checkpoint.
+		 */
+		struct CheckpointHeader {
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint64_t sequence;
+			std::uint64_t numItems;
+			std::uint64_t numRecords;
+		};
+
+		/**
+		 * The prefix of each record within a checkpoint, followed by size bytes of payload.
+		 */
+		struct CheckpointRecord {
+			std::uint64_t item;
+			std::uint64_t size;
+		};
+
+		constexpr std::uint64_t CHECKPOINT_HEADER_RECORD = ~std::uint64_t(0);
+
+		/**
+		 * The number of manifest entries, written alternately such that a manifest torn by an
+		 * interrupted update leaves the previous one intact.
+		 */
+		constexpr unsigned CHECKPOINT_MANIFEST_SLOTS = 2;
+
+		/**
+		 * The FNV-1a hash of the given data, validating the content of manifests.
+		 */
+		inline std::uint64_t hashManifest(const std::vector<std::uint64_t>& data) {
+			std::uint64_t hash = 0xcbf29ce484222325ull;
+			for(auto value : data) {
+				for(unsigned i = 0; i < sizeof(value); ++i) {
+					hash = (hash ^ ((value >> (8*i)) & 0xff)) * 0x100000001b3ull;
+				}
+			}
+			return hash;
+		}
+
+	} // end namespace detail
+
+
+	/**
+	 * A manager for checkpoints of a set of data item fragments, storing snapshots in entries of an
+	 * IO manager. A full checkpoint stores the entire region covered by each fragment, while incremental
+	 * checkpoints only store the regions marked as written since the previous checkpoint. Checkpoints form
+	 * a chain of a full checkpoint followed by incremental ones, which is listed in a manifest and replayed
+	 * on restore. Manifests are written alternately to two entries tagged by a generation number and a
+	 * checksum, such that an interrupted update falls back to the previously completed chain. Once a new
+	 * full checkpoint is completed, the entries of the previous chain are removed.
+	 *
+	 * When a checkpoint is requested, the data to be stored is extracted from all fragments in parallel,
+	 * such that the fragments may be modified as soon as the request returns, while the extracted data is
+	 * written to the storage asynchronously, overlapping with subsequent computations.
+	 *
+	 * The registration of fragments and the creation and restoration of checkpoints must not be conducted
+	 * concurrently. Written regions may be marked concurrently by any number of tasks.
+	 */
+	template<typename Manager>
+	class CheckpointManager {
+
+		/**
+		 * The type-erased interface to the fragments covered by checkpoints.
+		 */
+		class Item {
+		public:
+
+			virtual ~Item() {}
+
+			/**
+			 * Extracts the covered or the written region of the fragment, resetting the written region.
+			 *
+			 * @return the extracted data, or null if the extracted region is empty
+			 */
+			virtual std::unique_ptr<utils::Archive> extract(bool full) = 0;
+
+			/**
+			 * Imports previously extracted data into the fragment.
+			 */
+			virtual void insert(const char* data, std::size_t size) = 0;
+
+			/**
+			 * Resets the written region.
+			 */
+			virtual void clear() = 0;
+
+		};
+
+		template<typename Fragment>
+		class FragmentItem : public Item {
+
+			using region_type = typename Fragment::region_type;
+
+			Fragment& fragment;
+
+			// the region written since the last checkpoint, and its lock
+			region_type written;
+			std::mutex lock;
+
+		public:
+
+			FragmentItem(Fragment& fragment)
+				: fragment(fragment), written(fragment.getCoveredRegion()) {}
+
+			void markWritten(const region_type& region) {
+				std::lock_guard<std::mutex> guard(lock);
+				written = region_type::merge(written, region);
+			}
+
+			std::unique_ptr<utils::Archive> extract(bool full) override {
+				region_type covered = fragment.getCoveredRegion();
+				region_type region;
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					region = (full) ? covered : region_type::intersect(written, covered);
+					written = region_type();
+				}
+				if (region.empty()) return nullptr;
+				utils::ArchiveWriter writer;
+				fragment.extract(writer, region);
+				return std::make_unique<utils::Archive>(std::move(writer).toArchive());
+			}
+
+			void insert(const char* data, std::size_t size) override {
+				utils::Archive archive(std::vector<char>(data, data + size));
+				utils::ArchiveReader reader(archive);
+				fragment.insert(reader);
+			}
+
+			void clear() override {
+				std::lock_guard<std::mutex> guard(lock);
+				written = region_type();
+			}
+
+		};
+
+		// the storage of checkpoints
+		Manager& manager;
+
+		// the prefix of the names of all entries
+		std::string name;
+
+		// the covered fragments, in the order of their registration
+		std::vector<std::unique_ptr<Item>> items;
+
+		// an index of the covered fragments
+		std::map<const void*, Item*> index;
+
+		// the sequence numbers of the checkpoints in the current chain
+		std::vector<std::uint64_t> chain;
+
+		// whether the fragments are in the state of the last checkpoint of the chain
+		bool current;
+
+		// the sequence number of the next checkpoint
+		std::uint64_t next;
+
+		// the generation of the next manifest
+		std::uint64_t generation;
+
+		// the completion of the checkpoint currently written
+		treeture<void> pending;
+
+	public:
+
+		/**
+		 * Creates a manager storing checkpoints in the given storage, using entries named by the given prefix.
+		 * A chain left by a previous manager of the same name is continued after being restored, and replaced
+		 * by the first checkpoint otherwise.
+		 */
+		CheckpointManager(Manager& manager, const std::string& name)
+			: manager(manager), name(name), current(false), next(0), generation(0) {
+			readManifest(chain);
+		}
+
+		CheckpointManager(const CheckpointManager&) = delete;
+		CheckpointManager(CheckpointManager&&) = delete;
+
+		~CheckpointManager() {
+			wait();
+		}
+
+		CheckpointManager& operator=(const CheckpointManager&) = delete;
+		CheckpointManager& operator=(CheckpointManager&&) = delete;
+
+		/**
+		 * Adds a fragment to be covered by checkpoints. Fragments have to be added in the same order
+		 * when restoring a checkpoint. Its entire region is considered written.
+		 */
+		template<typename Fragment>
+		void add(Fragment& fragment) {
+			static_assert(is_fragment<Fragment>::value, "Only data item fragments may be checkpointed!");
+			assert_true(index.find(&fragment) == index.end()) << "Fragment has already been added!";
+			items.push_back(std::make_unique<FragmentItem<Fragment>>(fragment));
+			index[&fragment] = items.back().get();
+		}
+
+		/**
+		 * Marks the given region of the given fragment as modified, such that it is included in the next
+		 * incremental checkpoint. Fragments have to be marked whenever they are modified or resized.
+		 */
+		template<typename Fragment>
+		void markWritten(const Fragment& fragment, const typename Fragment::region_type& region) {
+			auto pos = index.find(&fragment);
+			assert_true(pos != index.end()) << "Fragment is not covered by checkpoints!";
+			static_cast<FragmentItem<Fragment>*>(pos->second)->markWritten(region);
+		}
+
+		/**
+		 * Obtains the number of checkpoints of the current chain.
+		 */
+		std::size_t getChainLength() const {
+			return chain.size();
+		}
+
+		/**
+		 * Creates a new checkpoint, waiting for the previous one to be completed. The checkpoint is a full
+		 * one if requested or if there is no restored or created checkpoint to build on, an incremental one
+		 * otherwise. The data is extracted before returning, while it is written asynchronously.
+		 */
+		void checkpoint(bool full = false) {
+
+			// only one checkpoint is written at a time
+			wait();
+			full = full || !current;
+			current = true;
+
+			// extract the data of all fragments in parallel
+			std::vector<std::unique_ptr<utils::Archive>> snapshots(items.size());
+			detail::parallelFor(items.size(), [&](std::size_t i) {
+				snapshots[i] = items[i]->extract(full);
+			});
+
+			// write the checkpoint asynchronously
+			std::uint64_t sequence = next++;
+			auto entry = manager.createEntry(getEntryName(sequence), Mode::Binary);
+			auto out = std::make_shared<OutputStream>(manager.openAsyncOutputStream(entry));
+
+			detail::CheckpointHeader header;
+			header.magic = detail::CHECKPOINT_MAGIC;
+			header.version = detail::CHECKPOINT_VERSION;
+			header.sequence = sequence;
+			header.numItems = items.size();
+			header.numRecords = 0;
+			for(const auto& cur : snapshots) {
+				if (cur) header.numRecords++;
+			}
+			writeRecord(*out, detail::CHECKPOINT_HEADER_RECORD, reinterpret_cast<const char*>(&header), sizeof(header));
+
+			for(std::size_t i = 0; i < snapshots.size(); ++i) {
+				if (!snapshots[i]) continue;
+				const auto& data = snapshots[i]->getBuffer();
+				writeRecord(*out, i, data.data(), data.size());
+				snapshots[i].reset();
+			}
+
+			// extend the chain or start a new one
+			std::vector<std::uint64_t> stale;
+			if (full) {
+				stale.swap(chain);
+			}
+			chain.push_back(sequence);
+
+			// once all data is written, update the manifest and drop the previous chain
+			struct empty {};
+			auto complete = [this,out,chain=chain,stale,generation=generation++](empty) {
+				manager.close(*out);
+				writeManifest(chain, generation);
+				for(auto cur : stale) {
+					manager.remove(manager.createEntry(getEntryName(cur), Mode::Binary));
+				}
+			};
+			pending = prec(
+				[](empty) { return true; },
+				complete,
+				[complete](empty e, const auto&) { complete(e); }
+			)(after(), empty());
+		}
+
+		/**
+		 * Waits for the completion of the checkpoint currently written, if any.
+		 */
+		void wait() {
+			pending.wait();
+		}
+
+		/**
+		 * Restores the data of all fragments from the latest completed chain of checkpoints, replaying the
+		 * checkpoints of the chain in order. Fragments are restored in parallel and have to cover the regions
+		 * stored for them. Subsequent incremental checkpoints extend the restored chain.
+		 *
+		 * @return true if a valid chain of checkpoints for the added fragments has been found and restored,
+		 * 		false otherwise, in which case no fragment has been modified
+		 */
+		bool restore() {
+			wait();
+
+			// locate the checkpoints of the chain
+			std::vector<std::uint64_t> sequences;
+			if (!readManifest(sequences)) return false;
+
+			// map them and collect the records of each fragment
+			struct Record {
+				const char* data;
+				std::size_t size;
+			};
+			std::vector<MemoryMappedInput> inputs;
+			std::vector<std::vector<Record>> records(items.size());
+			bool valid = true;
+			for(auto sequence : sequences) {
+				auto entry = manager.createEntry(getEntryName(sequence), Mode::Binary);
+				if (!manager.exists(entry)) {
+					valid = false;
+					break;
+				}
+				inputs.push_back(manager.shareMemoryMappedInput(entry));
+				if (!indexRecords(inputs.back(), sequence, [&](std::uint64_t item, const char* data, std::size_t size) {
+					records[item].push_back({ data, size });
+				})) {
+					valid = false;
+					break;
+				}
+			}
+
+			// restore the fragments in parallel
+			if (valid) {
+				detail::parallelFor(items.size(), [&](std::size_t i) {
+					for(const auto& cur : records[i]) {
+						items[i]->insert(cur.data, cur.size);
+					}
+					items[i]->clear();
+				});
+				chain = sequences;
+				current = true;
+			}
+
+			for(const auto& cur : inputs) {
+				manager.close(cur);
+			}
+			return valid;
+		}
+
+	private:
+
+		std::string getEntryName(std::uint64_t sequence) const {
+			return name + "." + std::to_string(sequence);
+		}
+
+		std::string getManifestName(std::uint64_t generation) const {
+			return name + ".manifest." + std::to_string(generation % detail::CHECKPOINT_MANIFEST_SLOTS);
+		}
+
+		static void writeRecord(OutputStream& out, std::uint64_t item, const char* data, std::size_t size) {
+			detail::CheckpointRecord record { item, size };
+			out.atomic([&](auto& o) {
+				o.write(reinterpret_cast<const char*>(&record), sizeof(record));
+				o.write(data, size);
+			});
+		}
+
+		void writeManifest(const std::vector<std::uint64_t>& sequences, std::uint64_t generation) {
+			std::vector<std::uint64_t> content;
+			content.push_back(generation);
+			content.push_back(sequences.size());
+			content.insert(content.end(), sequences.begin(), sequences.end());
+			OutputStream out = manager.openOutputStream(manager.createEntry(getManifestName(generation), Mode::Binary));
+			out.write(detail::CHECKPOINT_MAGIC);
+			out.write(detail::CHECKPOINT_VERSION);
+			for(auto cur : content) {
+				out.write(cur);
+			}
+			out.write(detail::hashManifest(content));
+			manager.close(out);
+		}
+
+		/**
+		 * Locates the valid manifest of the latest generation, obtaining the chain listed by it and
+		 * advancing the generation and sequence numbers beyond it.
+		 *
+		 * @return true if a valid manifest listing a non-empty chain has been found, false otherwise
+		 */
+		bool readManifest(std::vector<std::uint64_t>& sequences) {
+			bool found = false;
+			for(unsigned slot = 0; slot < detail::CHECKPOINT_MANIFEST_SLOTS; ++slot) {
+				std::vector<std::uint64_t> content;
+				if (!readManifest(slot, content)) continue;
+				if (found && content[0] < generation) continue;
+				found = true;
+				generation = content[0];
+				sequences.assign(content.begin() + 2, content.end());
+			}
+			if (!found) return false;
+			generation++;
+			next = std::max(next, sequences.back() + 1);
+			return true;
+		}
+
+		bool readManifest(unsigned slot, std::vector<std::uint64_t>& content) {
+			auto entry = manager.createEntry(getManifestName(slot), Mode::Binary);
+			if (!manager.exists(entry)) return false;
+			InputStream in = manager.openInputStream(entry);
+			auto magic = in.read<std::uint32_t>();
+			auto version = in.read<std::uint32_t>();
+			bool valid = in && magic == detail::CHECKPOINT_MAGIC && version == detail::CHECKPOINT_VERSION;
+			for(std::uint64_t i = 0; valid && (i < 2 || i < content[1] + 2); ++i) {
+				content.push_back(in.read<std::uint64_t>());
+				valid = bool(in) && (i != 1 || content[1] > 0);
+			}
+			valid = valid && in.read<std::uint64_t>() == detail::hashManifest(content) && bool(in);
+			manager.close(in);
+			return valid && content[0] % detail::CHECKPOINT_MANIFEST_SLOTS == slot;
+		}
+
+		/**
+		 * Validates the structure of a checkpoint and enumerates the records of its fragments.
+		 */
+		template<typename Visitor>
+		bool indexRecords(const MemoryMappedInput& in, std::uint64_t sequence, const Visitor& visit) const {
+			const char* cur = in.accessArray<char>();
+			const char* end = cur + in.size();
+
+			// the order of records is not fixed, thus the header is obtained while scanning
+			bool found = false;
+			detail::CheckpointHeader header;
+			std::uint64_t numRecords = 0;
+			std::vector<std::pair<std::uint64_t,std::pair<const char*,std::size_t>>> list;
+			while(cur != end) {
+				detail::CheckpointRecord record;
+				if (std::size_t(end - cur) < sizeof(record)) return false;
+				std::memcpy(&record, cur, sizeof(record));
+				cur += sizeof(record);
+				if (record.size > std::size_t(end - cur)) return false;
+
+				if (record.item == detail::CHECKPOINT_HEADER_RECORD) {
+					if (found || record.size != sizeof(header)) return false;
+					std::memcpy(&header, cur, sizeof(header));
+					found = true;
+				} else {
+					if (record.item >= items.size()) return false;
+					list.push_back({ record.item, { cur, std::size_t(record.size) } });
+					numRecords++;
+				}
+				cur += record.size;
+			}
+
+			// check the header
+			if (!found) return false;
+			if (header.magic != detail::CHECKPOINT_MAGIC || header.version != detail::CHECKPOINT_VERSION) return false;
+			if (header.sequence != sequence || header.numItems != items.size() || header.numRecords != numRecords) return false;
+
+			for(const auto& cur : list) {
+				visit(cur.first, cur.second.first, cur.second.second);
+			}
+			return true;
+		}
+
+	};
+
+} // end namespace core
+} // end namespace api
+} // end namespace allscale
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <sys/types.h>
@@ -54,6 +63,14 @@ namespace reference {
 		Text, Binary
 	};
 
+	/**
+	 * Hints on the way the data of memory mapped entries is going to be accessed,
+	 * enabling the OS to adapt its read-ahead and caching policies.
+	 */
+	enum class AccessHint {
+		Normal, Sequential, Random, WillNeed, DontNeed, HugePages
+	};
+
 	/**
 	 * The kind of handle to reference entities within an IO manager.
 	 */
@@ -105,14 +122,32 @@ namespace reference {
 			template<typename T>
 			T read() {
 				T value;
-				in.read((char*)&value, sizeof(T));
+				readBytes((char*)&value, sizeof(T));
 				return value;
 			}
 			template<typename T>
 			IStreamWrapper& read(T& res) {
-				in.read((char*)&res, sizeof(T));
+				readBytes((char*)&res, sizeof(T));
 				return *this;
 			}
+			std::size_t read(char* dst, std::size_t count) {
+				return readBytes(dst, count);
+			}
+			void unread(std::size_t count) {
+				// data read ahead was obtained, so a short read reported while fetching it is void
+				in.clear(in.rdstate() & std::ios_base::badbit);
+				auto pos = in.rdbuf()->pubseekoff(-std::streamoff(count), std::ios_base::cur, std::ios_base::in);
+				assert_true(pos != std::streampos(std::streamoff(-1))) << "Unable to give back " << count << " bytes to the stream!";
+				if (pos == std::streampos(std::streamoff(-1))) in.setstate(std::ios_base::failbit);
+			}
+		private:
+			// raw data is obtained from the stream buffer directly, avoiding the per-call overhead of std::istream::read
+			std::size_t readBytes(char* dst, std::size_t count) {
+				if (!in) return 0;
+				std::size_t res = in.rdbuf()->sgetn(dst, count);
+				if (res < count) in.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+				return res;
+			}
 		};
 
 	private:
@@ -151,6 +186,23 @@ namespace reference {
 			return res;
 		}
 
+		std::size_t read(char* dst, std::size_t count) {
+			std::size_t res = 0;
+			atomic([&](IStreamWrapper& in) {
+				res = in.read(dst, count);
+			});
+			return res;
+		}
+
+		/**
+		 * Steps back by the given number of bytes, returning data read ahead to the stream.
+		 */
+		void unread(std::size_t count) {
+			atomic([&](IStreamWrapper& in) {
+				in.unread(count);
+			});
+		}
+
 		operator bool() const {
 			return (bool)in.in;
 		}
@@ -165,6 +217,184 @@ namespace reference {
 		}
 	};
 
+	/**
+	 * A buffered, asynchronous writer for output streams. Writing threads append data to
+	 * one of a set of buffers selected by their thread ID, such that workers are rarely
+	 * contending for the same lock. Filled buffers are handed to a dedicated background
+	 * thread, writing them to the underlying stream.
+	 *
+	 * @tparam Wrapper the stream wrapper type to be passed to bodies writing data
+	 */
+	template<typename Wrapper>
+	class AsyncStreamWriter {
+
+		// the number of buffers (ideally not less than the number of workers)
+		static constexpr std::size_t NUM_BUFFERS = 64;
+
+		// the fill level of a buffer triggering its hand-off to the background thread
+		static constexpr std::streamoff BUFFER_SIZE = 64 * 1024;
+
+		struct Buffer {
+			std::mutex lock;
+			std::stringstream data;
+			Wrapper wrapper;
+			Buffer() : data(std::ios_base::out | std::ios_base::binary), wrapper(data) {}
+		};
+
+		// a unit of work for the background thread
+		struct Block {
+			std::string data;
+			bool flush;
+		};
+
+		// the stream targeted by this writer
+		std::ostream& target;
+
+		// the per-thread buffers
+		std::array<Buffer,NUM_BUFFERS> buffers;
+
+		// the lock protecting the state shared with the background thread
+		std::mutex queue_lock;
+
+		// signals the background thread that there is work
+		std::condition_variable work_available;
+
+		// signals the completion of blocks to waiting threads
+		std::condition_variable work_done;
+
+		// the blocks to be written
+		std::deque<Block> queue;
+
+		// the number of blocks handed to the background thread
+		std::uint64_t submitted = 0;
+
+		// the number of blocks processed by the background thread
+		std::uint64_t processed = 0;
+
+		// set to stop the background thread
+		bool stopping = false;
+
+		// the background thread
+		std::thread worker;
+
+	public:
+
+		AsyncStreamWriter(std::ostream& target)
+			: target(target), worker([this]{ run(); }) {
+			// text written to the buffers has to be formatted like text written to the target
+			for(auto& cur : buffers) {
+				cur.data.copyfmt(target);
+			}
+		}
+
+		AsyncStreamWriter(const AsyncStreamWriter&) = delete;
+		AsyncStreamWriter(AsyncStreamWriter&&) = delete;
+
+		~AsyncStreamWriter() {
+			// write out all pending data
+			wait(flush());
+
+			// shut down background thread
+			{
+				std::lock_guard<std::mutex> lease(queue_lock);
+				stopping = true;
+			}
+			work_available.notify_one();
+			worker.join();
+		}
+
+		/**
+		 * Runs the given body on the buffer of the current thread. Data written by a single
+		 * body invocation remains contiguous in the output.
+		 */
+		template<typename Body>
+		void atomic(const Body& body) {
+			auto& buffer = buffers[std::hash<std::thread::id>()(std::this_thread::get_id()) % NUM_BUFFERS];
+			std::lock_guard<std::mutex> lease(buffer.lock);
+			body(buffer.wrapper);
+			if (buffer.data.tellp() >= BUFFER_SIZE) submit(buffer);
+		}
+
+		/**
+		 * Hands all buffered data to the background thread and requests the underlying
+		 * stream to be flushed. The result is a ticket to be waited for.
+		 */
+		std::uint64_t flush() {
+			for(auto& cur : buffers) {
+				std::lock_guard<std::mutex> lease(cur.lock);
+				submit(cur);
+			}
+			return enqueue({ std::string(), true });
+		}
+
+		/**
+		 * Determines whether the operation of the given ticket has been completed.
+		 */
+		bool isDone(std::uint64_t ticket) {
+			std::lock_guard<std::mutex> lease(queue_lock);
+			return processed >= ticket;
+		}
+
+		/**
+		 * Blocks until the operation of the given ticket has been completed.
+		 */
+		void wait(std::uint64_t ticket) {
+			std::unique_lock<std::mutex> lease(queue_lock);
+			work_done.wait(lease, [&]{ return processed >= ticket; });
+		}
+
+	private:
+
+		// requires the lock of the given buffer to be held
+		void submit(Buffer& buffer) {
+			if (buffer.data.tellp() <= 0) return;
+			enqueue({ buffer.data.str(), false });
+			buffer.data.str(std::string());
+		}
+
+		std::uint64_t enqueue(Block&& block) {
+			std::uint64_t ticket;
+			{
+				std::lock_guard<std::mutex> lease(queue_lock);
+				queue.push_back(std::move(block));
+				ticket = ++submitted;
+			}
+			work_available.notify_one();
+			return ticket;
+		}
+
+		void run() {
+			std::unique_lock<std::mutex> lease(queue_lock);
+			while(true) {
+
+				// wait for work
+				work_available.wait(lease, [&]{ return stopping || !queue.empty(); });
+				if (queue.empty()) return;
+
+				// take the next block
+				Block block = std::move(queue.front());
+				queue.pop_front();
+
+				// write the block without holding the lock
+				lease.unlock();
+				if (!block.data.empty()) target.write(block.data.data(),block.data.size());
+				if (block.flush) target.flush();
+				lease.lock();
+
+				// report progress
+				processed++;
+				work_done.notify_all();
+			}
+		}
+
+	};
+
+	template<typename Wrapper>
+	constexpr std::size_t AsyncStreamWriter<Wrapper>::NUM_BUFFERS;
+
+	template<typename Wrapper>
+	constexpr std::streamoff AsyncStreamWriter<Wrapper>::BUFFER_SIZE;
+
 	/**
 	 * A stream to store data in the form of a stream of entries.
 	 */
@@ -188,7 +418,12 @@ namespace reference {
 			}
 			template<typename T>
 			OStreamWrapper& write(const T& value) {
-				out.write((char*)&value, sizeof(T));
+				return write((const char*)&value, sizeof(T));
+			}
+			OStreamWrapper& write(const char* src, std::size_t count) {
+				// raw data is passed to the stream buffer directly, avoiding the per-call overhead of std::ostream::write
+				if (!out) return *this;
+				if (out.rdbuf()->sputn(src, count) != (std::streamsize)count) out.setstate(std::ios_base::badbit);
 				return *this;
 			}
 		};
@@ -196,16 +431,58 @@ namespace reference {
 	private:
 		OStreamWrapper out;
 
-		OutputStream(const Entry& entry, std::ostream& out)
-			: IOStream(entry), out(out) {}
+		// the background writer, if this stream is asynchronous
+		std::unique_ptr<AsyncStreamWriter<OStreamWrapper>> async;
+
+		OutputStream(const Entry& entry, std::ostream& out, bool async = false)
+			: IOStream(entry), out(out), async(async ? new AsyncStreamWriter<OStreamWrapper>(out) : nullptr) {}
 
 	public:
 
 		OutputStream(OutputStream&& other)
-			: IOStream(std::move(other)), out(other.out) {}
+			: IOStream(std::move(other)), out(other.out), async(std::move(other.async)) {}
+
+		/**
+		 * Determines whether this stream is writing data asynchronously.
+		 */
+		bool isAsync() const {
+			return bool(async);
+		}
+
+		/**
+		 * Requests all data written so far to be flushed to the underlying storage. The
+		 * result is a ticket to be passed to waitFor(). For synchronous streams, the flush
+		 * is completed before returning.
+		 */
+		std::uint64_t requestFlush() {
+			if (async) return async->flush();
+			std::lock_guard<std::mutex> lease(operation_lock);
+			out.out.flush();
+			return 0;
+		}
+
+		/**
+		 * Waits for the completion of the flush operation of the given ticket.
+		 */
+		void waitFor(std::uint64_t ticket) {
+			if (async) async->wait(ticket);
+		}
+
+		/**
+		 * Flushes all data written so far to the underlying storage.
+		 */
+		void flush() {
+			waitFor(requestFlush());
+		}
 
 		template<typename Body>
 		void atomic(const Body& body) {
+			// asynchronous streams use per-thread buffers
+			if (async) {
+				async->atomic(body);
+				return;
+			}
+
 			// protect output by locking it
 			std::lock_guard<std::mutex> lease(operation_lock);
 
@@ -234,6 +511,12 @@ namespace reference {
 			});
 		}
 
+		void write(const char* src, std::size_t count) {
+			atomic([&](OStreamWrapper& out) {
+				out.write(src, count);
+			});
+		}
+
 		operator bool() const {
 			return (bool)out.out;
 		}
@@ -257,21 +540,85 @@ namespace reference {
 
 		void* base;
 
+		std::size_t size;
+
+		// whether the data is mapped into the address space by the OS, and thus accepts hints
+		bool mapped;
+
 	public:
 
-		MemoryMappedIO(const Entry& entry, void* base)
-			: entry(entry), base(base) {}
+		MemoryMappedIO(const Entry& entry, void* base, std::size_t size, bool mapped)
+			: entry(entry), base(base), size(size), mapped(mapped) {}
 
 		Entry getEntry() const {
 			return entry;
 		}
 
+		std::size_t getSize() const {
+			return size;
+		}
+
+		/**
+		 * Informs the OS on the intended access pattern of the given byte range. Hints
+		 * on data not mapped by the OS (e.g. in-memory buffers) are ignored.
+		 */
+		void advise(AccessHint hint, std::size_t offset, std::size_t length) const {
+#ifndef _MSC_VER
+			if (!mapped || !base || offset >= size) return;
+
+			// align the start of the range to a page boundary
+			auto start = offset - offset % getPageSize();
+			length = std::min(length, size - offset) + (offset - start);
+
+			// apply the advice, if supported by the platform
+			int advice = toNativeAdvice(hint);
+			if (advice < 0) return;
+			madvise(static_cast<char*>(base) + start, length, advice);
+#else
+			// not supported
+			(void)hint; (void)offset; (void)length;
+#endif
+		}
+
+		/**
+		 * Obtains the granularity of memory mappings.
+		 */
+		static std::size_t getPageSize() {
+#ifndef _MSC_VER
+			static const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+			return pageSize;
+#else
+			return 4096;
+#endif
+		}
+
 	protected:
 
 		void* getBase() const {
 			return base;
 		}
 
+	private:
+
+#ifndef _MSC_VER
+		static int toNativeAdvice(AccessHint hint) {
+			switch(hint) {
+			case AccessHint::Normal:     return MADV_NORMAL;
+			case AccessHint::Sequential: return MADV_SEQUENTIAL;
+			case AccessHint::Random:     return MADV_RANDOM;
+			case AccessHint::WillNeed:   return MADV_WILLNEED;
+			case AccessHint::DontNeed:   return MADV_DONTNEED;
+			case AccessHint::HugePages:
+#ifdef MADV_HUGEPAGE
+				return MADV_HUGEPAGE;
+#else
+				return -1;
+#endif
+			}
+			return -1;
+		}
+#endif
+
 	};
 
 	class MemoryMappedInput : public MemoryMappedIO {
@@ -279,8 +626,8 @@ namespace reference {
 		template<typename Factory>
 		friend class IOManager;
 
-		MemoryMappedInput(const Entry& entry, void* base)
-			: MemoryMappedIO(entry,base) {}
+		MemoryMappedInput(const Entry& entry, void* base, std::size_t size, bool mapped)
+			: MemoryMappedIO(entry,base,size,mapped) {}
 
 	public:
 
@@ -306,8 +653,8 @@ namespace reference {
 		template<typename Factory>
 		friend class IOManager;
 
-		MemoryMappedOutput(const Entry& entry, void* base)
-			: MemoryMappedIO(entry,base) {}
+		MemoryMappedOutput(const Entry& entry, void* base, std::size_t size, bool mapped)
+			: MemoryMappedIO(entry,base,size,mapped) {}
 
 	public:
 
@@ -329,7 +676,146 @@ namespace reference {
 	};
 
 	/**
-	 * An IO manager, as the central dispatcher for IO operations.
+	 * A thread-safe register of open handles, indexed by their entries. To avoid contention
+	 * among tasks operating on different entries, the register is split into independently
+	 * locked shards. Opening an entry that is already open has no effect, and the first
+	 * release closes the handle -- unless references have been added by share operations,
+	 * each of which keeps the handle open for one more release.
+	 */
+	template<typename Handle>
+	class HandleRegistry {
+
+		static constexpr std::size_t NUM_SHARDS = 64;
+
+		struct Slot {
+			std::unique_ptr<Handle> handle;
+			std::size_t references;
+		};
+
+		struct Shard {
+			std::mutex lock;
+			std::map<Entry,Slot> slots;
+		};
+
+		std::array<Shard,NUM_SHARDS> shards;
+
+		Shard& getShard(const Entry& entry) {
+			return shards[entry.id % NUM_SHARDS];
+		}
+
+	public:
+
+		/**
+		 * Obtains the handle registered for the given entry, creating and registering
+		 * it using the given factory if not present.
+		 */
+		template<typename Factory>
+		Handle& open(const Entry& entry, const Factory& create) {
+			return obtain(entry, create, false);
+		}
+
+		/**
+		 * Obtains the handle registered for the given entry like open, but adds a reference
+		 * to a present handle, such that it requires an additional release to be closed.
+		 */
+		template<typename Factory>
+		Handle& share(const Entry& entry, const Factory& create) {
+			return obtain(entry, create, true);
+		}
+
+		/**
+		 * Obtains the handle registered for the given entry, or null if there is none.
+		 * The handle remains valid until its last reference is released.
+		 */
+		Handle* find(const Entry& entry) {
+			Shard& shard = getShard(entry);
+			std::lock_guard<std::mutex> guard(shard.lock);
+			auto pos = shard.slots.find(entry);
+			return (pos == shard.slots.end()) ? nullptr : pos->second.handle.get();
+		}
+
+		/**
+		 * Applies the given update to the handle registered for the given entry.
+		 *
+		 * @return true if there was a handle to be updated, false otherwise
+		 */
+		template<typename Op>
+		bool update(const Entry& entry, const Op& op) {
+			Shard& shard = getShard(entry);
+			std::lock_guard<std::mutex> guard(shard.lock);
+			auto pos = shard.slots.find(entry);
+			if (pos == shard.slots.end()) return false;
+			op(*pos->second.handle);
+			return true;
+		}
+
+		/**
+		 * Releases a reference to the handle of the given entry. If it was the last
+		 * reference, the handle is closed using the given operation and removed.
+		 */
+		template<typename Closer>
+		void release(const Entry& entry, const Closer& close) {
+			Shard& shard = getShard(entry);
+			std::lock_guard<std::mutex> guard(shard.lock);
+
+			// check for present
+			auto pos = shard.slots.find(entry);
+			if (pos == shard.slots.end()) return;
+
+			// check whether there are other references
+			if (--pos->second.references > 0) return;
+
+			// close and remove the handle
+			close(*pos->second.handle);
+			shard.slots.erase(pos);
+		}
+
+		/**
+		 * Closes and removes all handles, independently of their reference counts.
+		 */
+		template<typename Closer>
+		void clear(const Closer& close) {
+			for(auto& shard : shards) {
+				std::lock_guard<std::mutex> guard(shard.lock);
+				for(auto& cur : shard.slots) {
+					close(*cur.second.handle);
+				}
+				shard.slots.clear();
+			}
+		}
+
+	private:
+
+		template<typename Factory>
+		Handle& obtain(const Entry& entry, const Factory& create, bool shared) {
+			Shard& shard = getShard(entry);
+			std::lock_guard<std::mutex> guard(shard.lock);
+
+			// check for present
+			auto pos = shard.slots.find(entry);
+			if (pos != shard.slots.end()) {
+				if (shared) pos->second.references++;
+				return *pos->second.handle;
+			}
+
+			// create a new handle
+			Slot& slot = shard.slots[entry];
+			slot.handle = create();
+			slot.references = 1;
+			return *slot.handle;
+		}
+
+	};
+
+	template<typename Handle>
+	constexpr std::size_t HandleRegistry<Handle>::NUM_SHARDS;
+
+
+	/**
+	 * An IO manager, as the central dispatcher for IO operations. All operations
+	 * may be invoked concurrently; the synchronization of accesses to the underlying
+	 * storage is left to the storage manager, such that operations on different
+	 * entries do not need to wait for each other.
 	 */
 	template<typename StorageManager>
 	class IOManager {
@@ -340,44 +826,44 @@ namespace reference {
 		StorageManager store;
 
 		/**
-		 * The central register of all open output streams.
+		 * The central register of all open input streams.
 		 */
-		std::map<Entry,InputStream> inputStreams;
+		HandleRegistry<InputStream> inputStreams;
 
 		/**
 		 * The central register of all open output streams.
 		 */
-		std::map<Entry,OutputStream> outputStreams;
+		HandleRegistry<OutputStream> outputStreams;
 
 		/**
 		 * The central register of all open memory mapped inputs.
 		 */
-		std::map<Entry,MemoryMappedInput> memoryMappedInputs;
+		HandleRegistry<MemoryMappedInput> memoryMappedInputs;
 
 		/**
 		 * The central register of all open memory mapped outputs.
 		 */
-		std::map<Entry,MemoryMappedOutput> memoryMappedOutputs;
+		HandleRegistry<MemoryMappedOutput> memoryMappedOutputs;
 
 	public:
 
 		~IOManager() {
 			// close and destroy all input streams
-			for(auto& cur : inputStreams) {
-				closeStream(cur.second);
-			}
+			inputStreams.clear([&](InputStream& in) {
+				closeStream(in);
+			});
 			// close and destroy all output streams
-			for(auto& cur : outputStreams) {
-				closeStream(cur.second);
-			}
+			outputStreams.clear([&](OutputStream& out) {
+				closeStream(out);
+			});
 			// close and destroy all memory mapped inputs
-			for(auto& cur : memoryMappedInputs) {
-				closeMemoryMappedIO(cur.second);
-			}
+			memoryMappedInputs.clear([&](const MemoryMappedInput& in) {
+				closeMemoryMappedIO(in);
+			});
 			// close and destroy all memory mapped outputs
-			for(auto& cur : memoryMappedOutputs) {
-				closeMemoryMappedIO(cur.second);
-			}
+			memoryMappedOutputs.clear([&](const MemoryMappedOutput& out) {
+				closeMemoryMappedIO(out);
+			});
 		}
 
 		/**
@@ -392,182 +878,187 @@ namespace reference {
 		}
 
 		/**
-		 * Register a new output stream with the given name within the system.
-		 * The call will create the underlying file and prepare output operations.
-		 *
-		 *  NOTE: this method is not thread safe!
+		 * Register a new input stream with the given name within the system.
+		 * The call will open the underlying file and prepare input operations.
 		 *
 		 * @param entry the name of the stream to be opened -- nothing happens if already opened
 		 */
 		InputStream& openInputStream(Entry entry) {
+			return inputStreams.open(entry, [&]() { return createInputStream(entry); });
+		}
 
-			// check for present
-			auto pos = inputStreams.find(entry);
-			if (pos != inputStreams.end()) return pos->second;
-
-			// create new input stream
-			InputStream res(entry, *store.createInputStream(entry));
-
-			// register stream
-			inputStreams.emplace(entry, std::move(res));
-
-			// return result
-			return getInputStream(entry);
+		/**
+		 * Opens an input stream like openInputStream, but keeps a stream that is already
+		 * open alive until this call has been matched by an additional close operation.
+		 * This way, independent tasks may share a stream without coordinating its closing.
+		 *
+		 * @param entry the name of the stream to be opened or shared
+		 */
+		InputStream& shareInputStream(Entry entry) {
+			return inputStreams.share(entry, [&]() { return createInputStream(entry); });
 		}
 
 		/**
 		 * Register a new output stream with the given name within the system.
 		 * The call will create the underlying file and prepare output operations.
 		 *
-		 *  NOTE: this method is not thread safe!
-		 *
 		 * @param entry the name of the stream to be opened -- nothing happens if already opened
+		 * @param async whether data should be buffered and written by a background thread
 		 */
-		OutputStream& openOutputStream(Entry entry) {
-
-			// check for present
-			auto pos = outputStreams.find(entry);
-			if (pos != outputStreams.end()) return pos->second;
-
-			// create new input stream
-			OutputStream res(entry, *store.createOutputStream(entry));
-
-			// register stream
-			outputStreams.emplace(entry, std::move(res));
+		OutputStream& openOutputStream(Entry entry, bool async = false) {
+			return outputStreams.open(entry, [&]() { return createOutputStream(entry, async); });
+		}
 
-			// return result
-			return getOutputStream(entry);
+		/**
+		 * Opens an output stream like openOutputStream, but keeps a stream that is already
+		 * open alive until this call has been matched by an additional close operation.
+		 *
+		 * @param entry the name of the stream to be opened or shared
+		 * @param async whether data should be buffered and written by a background thread
+		 */
+		OutputStream& shareOutputStream(Entry entry, bool async = false) {
+			return outputStreams.share(entry, [&]() { return createOutputStream(entry, async); });
 		}
 
 		/**
 		 * Register a new memory mapped input with the given name within the system.
 		 * The call will load the underlying storage and prepare input operations.
 		 *
-		 *  NOTE: this method is not thread safe!
-		 *
 		 * @param entry the storage entry to be opened -- nothing happens if already opened
 		 */
 		MemoryMappedInput openMemoryMappedInput(Entry entry) {
+			return memoryMappedInputs.open(entry, [&]() { return createMemoryMappedInput(entry); });
+		}
 
-			// check for present
-			auto pos = memoryMappedInputs.find(entry);
-			if (pos != memoryMappedInputs.end()) return pos->second;
-
-			// create new input stream
-			MemoryMappedInput res(entry, store.createMemoryMappedInput(entry));
-
-			// register stream
-			memoryMappedInputs.emplace(entry, std::move(res));
-
-			// return result
-			return getMemoryMappedInput(entry);
+		/**
+		 * Opens a memory mapped input like openMemoryMappedInput, but keeps a mapping that
+		 * is already open alive until this call has been matched by an additional close operation.
+		 *
+		 * @param entry the storage entry to be opened or shared
+		 */
+		MemoryMappedInput shareMemoryMappedInput(Entry entry) {
+			return memoryMappedInputs.share(entry, [&]() { return createMemoryMappedInput(entry); });
 		}
 
 		/**
 		 * Register a new memory mapped output with the given name within the system.
 		 * The call will create the underlying storage and prepare output operations.
 		 *
-		 *  NOTE: this method is not thread safe!
-		 *
 		 * @param entry the storage entry to be opened -- nothing happens if already opened
 		 */
 		MemoryMappedOutput openMemoryMappedOutput(Entry entry, std::size_t size) {
+			return memoryMappedOutputs.open(entry, [&]() { return createMemoryMappedOutput(entry, size); });
+		}
 
-			// check for present
-			auto pos = memoryMappedOutputs.find(entry);
-			if (pos != memoryMappedOutputs.end()) return pos->second;
-
-			// create new input stream
-			MemoryMappedOutput res(entry, store.createMemoryMappedOutput(entry,size));
+		/**
+		 * Opens a memory mapped output like openMemoryMappedOutput, but keeps a mapping that
+		 * is already open alive until this call has been matched by an additional close operation.
+		 *
+		 * @param entry the storage entry to be opened or shared
+		 */
+		MemoryMappedOutput shareMemoryMappedOutput(Entry entry, std::size_t size) {
+			return memoryMappedOutputs.share(entry, [&]() { return createMemoryMappedOutput(entry, size); });
+		}
 
-			// register stream
-			memoryMappedOutputs.emplace(entry, std::move(res));
 
-			// return result
-			return getMemoryMappedOutput(entry);
+		/**
+		 * Changes the size of an open memory mapped output. The data within the
+		 * common prefix is preserved, additional space is zero-initialized. The data
+		 * may be moved, invalidating previously obtained handles and references.
+		 *
+		 *  NOTE: no other thread may access the data of the output concurrently!
+		 *
+		 * @param out the memory mapped output to be resized
+		 * @param size the new size in bytes
+		 * @return an updated handle to the memory mapped output
+		 */
+		MemoryMappedOutput resizeMemoryMappedOutput(const MemoryMappedOutput& out, std::size_t size) {
+			auto entry = out.getEntry();
+			MemoryMappedOutput res = out;
+			bool present = memoryMappedOutputs.update(entry, [&](MemoryMappedOutput& cur) {
+				cur = MemoryMappedOutput(entry, store.resizeMemoryMappedOutput(entry,size), size, StorageManager::isMappedByOS());
+				res = cur;
+			});
+			assert_true(present) << "Unable to resize closed memory mapped output!";
+			return res;
 		}
 
-
 		/**
 		 * Obtains an input stream to read data from a storage entry.
-		 * The storage entry is maintained by the manager and the provided output stream
-		 * is only valid within the current thread.
+		 * The storage entry is maintained by the manager and the provided input stream
+		 * remains valid until the stream is closed.
 		 *
 		 * @param entry the name of the storage entry to be targeted -- must be open
-		 * @return a stream to append data to
+		 * @return a stream to read data from
 		 */
 		InputStream& getInputStream(Entry entry) {
-			assert_true(inputStreams.find(entry) != inputStreams.end());
-			return inputStreams.find(entry)->second;
+			auto res = inputStreams.find(entry);
+			assert_true(res) << "Input stream " << entry.id << " is not open!";
+			return *res;
 		}
 
 		/**
 		 * Obtains an output stream to write data to a storage entry.
 		 * The storage entry is maintained by the manager and the provided output stream
-		 * is only valid within the current thread.
+		 * remains valid until the stream is closed.
 		 *
 		 * @param entry the name of the storage entry to be targeted -- must be open
 		 * @return a stream to append data to
 		 */
 		OutputStream& getOutputStream(Entry entry) {
-			assert_true(outputStreams.find(entry) != outputStreams.end());
-			return outputStreams.find(entry)->second;
+			auto res = outputStreams.find(entry);
+			assert_true(res) << "Output stream " << entry.id << " is not open!";
+			return *res;
 		}
 
 		/**
 		 * Obtains a memory mapped input to read data from a storage entry.
 		 * The storage entry is maintained by the manager and the provided memory mapped
-		 * input is only valid within the current thread.
+		 * input remains valid until the input is closed.
 		 *
 		 * @param entry the name of the storage entry to be targeted -- must be open
 		 * @return a requested memory mapped input
 		 */
 		MemoryMappedInput getMemoryMappedInput(Entry entry) {
-			assert_true(memoryMappedInputs.find(entry) != memoryMappedInputs.end());
-			return memoryMappedInputs.find(entry)->second;
+			MemoryMappedInput res(entry, nullptr, 0, false);
+			bool present = memoryMappedInputs.update(entry, [&](const MemoryMappedInput& cur) { res = cur; });
+			assert_true(present) << "Memory mapped input " << entry.id << " is not open!";
+			return res;
 		}
 
 		/**
 		 * Obtains a memory mapped output to write data to a storage entry.
 		 * The storage entry is maintained by the manager and the provided memory mapped
-		 * output is only valid within the current thread.
+		 * output remains valid until the output is closed or resized.
 		 *
 		 * @param entry the name of the storage entry to be targeted -- must be open
 		 * @return a requested memory mapped output
 		 */
 		MemoryMappedOutput getMemoryMappedOutput(Entry entry) {
-			assert_true(memoryMappedOutputs.find(entry) != memoryMappedOutputs.end());
-			return memoryMappedOutputs.find(entry)->second;
+			MemoryMappedOutput res(entry, nullptr, 0, false);
+			bool present = memoryMappedOutputs.update(entry, [&](const MemoryMappedOutput& cur) { res = cur; });
+			assert_true(present) << "Memory mapped output " << entry.id << " is not open!";
+			return res;
 		}
 
 		/**
-		 * Closes the stream with the given name.
+		 * Closes the stream with the given name, unless it has been shared and not all
+		 * share operations have been matched by a close operation yet.
 		 */
 		void closeInputStream(Entry entry) {
-			// get the stream
-			auto pos = inputStreams.find(entry);
-			if (pos == inputStreams.end()) return;
-
-			// close the stream
-			closeStream(pos->second);
-
-			// erase the entry
-			inputStreams.erase(pos);
+			inputStreams.release(entry, [&](InputStream& in) {
+				closeStream(in);
+			});
 		}
 
 		/**
-		 * Closes the stream with the given name.
+		 * Closes the stream with the given name, unless it has been shared and not all
+		 * share operations have been matched by a close operation yet.
 		 */
 		void closeOutputStream(Entry entry) {
-			// get the stream
-			auto pos = outputStreams.find(entry);
-			if (pos == outputStreams.end()) return;
-
-			// close the stream
-			closeStream(pos->second);
-
-			// erase the entry
-			outputStreams.erase(pos);
+			outputStreams.release(entry, [&](OutputStream& out) {
+				closeStream(out);
+			});
 		}
 
 		/**
@@ -588,28 +1079,18 @@ namespace reference {
 		 * Closes the given memory mapped input.
 		 */
 		void close(const MemoryMappedInput& in) {
-			auto pos = memoryMappedInputs.find(in.getEntry());
-			if (pos == memoryMappedInputs.end()) return;
-
-			// remove memory mapping
-			closeMemoryMappedIO(in);
-
-			// erase entry from register
-			memoryMappedInputs.erase(pos);
+			memoryMappedInputs.release(in.getEntry(), [&](const MemoryMappedInput& cur) {
+				closeMemoryMappedIO(cur);
+			});
 		}
 
 		/**
 		 * Closes the given memory mapped output.
 		 */
 		void close(const MemoryMappedOutput& out) {
-			auto pos = memoryMappedOutputs.find(out.getEntry());
-			if (pos == memoryMappedOutputs.end()) return;
-
-			// remove memory mapping
-			closeMemoryMappedIO(out);
-
-			// erase entry from register
-			memoryMappedOutputs.erase(pos);
+			memoryMappedOutputs.release(out.getEntry(), [&](const MemoryMappedOutput& cur) {
+				closeMemoryMappedIO(cur);
+			});
 		}
 
 		/**
@@ -620,14 +1101,59 @@ namespace reference {
 		}
 
 		/**
-		 * Deletes the entry with the given name.
+		 * Deletes the entry with the given name. Positional operations still in progress
+		 * on the entry are completed before the underlying resources are released.
 		 */
 		void remove(Entry entry) {
 			store.remove(entry);
 		}
 
+		/**
+		 * Writes the given block of data at the given offset of the targeted entry. The
+		 * entry is created if it does not exist and extended if necessary. Positional
+		 * writes to disjoint ranges may be conducted concurrently.
+		 */
+		void writeAt(Entry entry, std::size_t offset, const char* data, std::size_t size) {
+			store.writeAt(entry, offset, data, size);
+		}
+
+		/**
+		 * Reads a block of data from the given offset of the targeted entry. Positional
+		 * reads may be conducted concurrently.
+		 *
+		 * @return the number of bytes read, which is less than size if the end of the entry is reached
+		 */
+		std::size_t readAt(Entry entry, std::size_t offset, char* data, std::size_t size) {
+			return store.readAt(entry, offset, data, size);
+		}
+
+		/**
+		 * Truncates or extends the given entry to the given size.
+		 */
+		void resize(Entry entry, std::size_t size) {
+			store.resize(entry, size);
+		}
+
 	private:
 
+		std::unique_ptr<InputStream> createInputStream(Entry entry) {
+			return std::unique_ptr<InputStream>(new InputStream(entry, *store.createInputStream(entry)));
+		}
+
+		std::unique_ptr<OutputStream> createOutputStream(Entry entry, bool async) {
+			return std::unique_ptr<OutputStream>(new OutputStream(entry, *store.createOutputStream(entry), async));
+		}
+
+		std::unique_ptr<MemoryMappedInput> createMemoryMappedInput(Entry entry) {
+			void* base = store.createMemoryMappedInput(entry);
+			return std::unique_ptr<MemoryMappedInput>(new MemoryMappedInput(entry, base, store.getMemoryMappedSize(entry), StorageManager::isMappedByOS()));
+		}
+
+		std::unique_ptr<MemoryMappedOutput> createMemoryMappedOutput(Entry entry, std::size_t size) {
+			void* base = store.createMemoryMappedOutput(entry,size);
+			return std::unique_ptr<MemoryMappedOutput>(new MemoryMappedOutput(entry, base, size, StorageManager::isMappedByOS()));
+		}
+
 		/**
 		 * Closes the given input stream.
 		 */
@@ -640,6 +1166,8 @@ namespace reference {
 		 * Closes the given output stream.
 		 */
 		void closeStream(OutputStream& out) {
+			// write out pending asynchronous data
+			out.async.reset();
 			// closes the stream
 			store.close(out.out.out);
 		}
@@ -669,131 +1197,520 @@ namespace reference {
 	// ----------------------------------------------------------------------
 
 
+	/**
+	 * A growable byte buffer composed of a list of chunks, such that appending data never
+	 * requires moving previously written data. All chunks but the last are fully occupied.
+	 * If needed, the content is consolidated into a single chunk to be accessed directly.
+	 */
+	class ChunkedBuffer {
+
+	public:
+
+		/**
+		 * The minimum capacity of chunks allocated for appending data.
+		 */
+		static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+		struct Chunk {
+			std::unique_ptr<char[]> data;
+			std::size_t capacity;
+			std::size_t size;
+		};
+
+	private:
+
+		std::vector<Chunk> chunks;
+
+		// the position of each chunk within the content
+		std::vector<std::size_t> offsets;
+
+		std::size_t length = 0;
+
+	public:
+
+		std::size_t size() const {
+			return length;
+		}
+
+		std::size_t getNumChunks() const {
+			return chunks.size();
+		}
+
+		const Chunk& getChunk(std::size_t i) const {
+			return chunks[i];
+		}
+
+		void clear() {
+			chunks.clear();
+			offsets.clear();
+			length = 0;
+		}
+
+		/**
+		 * Obtains the free space at the end of the buffer, adding a chunk with at least the
+		 * given capacity if there is none. The space becomes part of the content once committed.
+		 */
+		std::pair<char*,char*> getFreeSpace(std::size_t hint = CHUNK_SIZE) {
+			if (chunks.empty() || chunks.back().size == chunks.back().capacity) {
+				addChunk((hint > CHUNK_SIZE) ? hint : std::size_t(CHUNK_SIZE));
+			}
+			Chunk& last = chunks.back();
+			return { last.data.get() + last.size, last.data.get() + last.capacity };
+		}
+
+		/**
+		 * Adds the given number of bytes of the free space at the end of the buffer to the content.
+		 */
+		void commit(std::size_t count) {
+			if (count == 0) return;
+			assert_le(count, chunks.back().capacity - chunks.back().size);
+			chunks.back().size += count;
+			length += count;
+		}
+
+		/**
+		 * Appends the given data to the end of this buffer.
+		 */
+		void append(const char* data, std::size_t count) {
+			while(count > 0) {
+				auto space = getFreeSpace(count);
+				auto step = std::min<std::size_t>(count, space.second - space.first);
+				std::memcpy(space.first, data, step);
+				commit(step);
+				data += step;
+				count -= step;
+			}
+		}
+
+		/**
+		 * Overwrites the content at the given position, extending the buffer if necessary.
+		 */
+		void write(std::size_t offset, const char* data, std::size_t count) {
+			if (offset + count > length) resize(offset + count);
+			forEachChunk(offset, count, [&](std::size_t chunk, std::size_t pos, std::size_t n) {
+				std::memcpy(chunks[chunk].data.get() + pos, data, n);
+				data += n;
+			});
+		}
+
+		/**
+		 * Reads up to the given number of bytes starting at the given position.
+		 *
+		 * @return the number of bytes read
+		 */
+		std::size_t read(std::size_t offset, char* data, std::size_t count) const {
+			if (offset >= length) return 0;
+			count = std::min(count, length - offset);
+			forEachChunk(offset, count, [&](std::size_t chunk, std::size_t pos, std::size_t n) {
+				std::memcpy(data, chunks[chunk].data.get() + pos, n);
+				data += n;
+			});
+			return count;
+		}
+
+		/**
+		 * Truncates or zero-extends the content to the given size.
+		 */
+		void resize(std::size_t size) {
+
+			// extend by appending zeros
+			if (size > length) {
+				std::size_t missing = size - length;
+				while(missing > 0) {
+					auto space = getFreeSpace(missing);
+					auto step = std::min<std::size_t>(missing, space.second - space.first);
+					std::memset(space.first, 0, step);
+					commit(step);
+					missing -= step;
+				}
+				return;
+			}
+
+			// truncate by dropping chunks beyond the new end
+			while(!chunks.empty() && offsets.back() >= size && offsets.back() > 0) {
+				chunks.pop_back();
+				offsets.pop_back();
+			}
+			if (!chunks.empty()) chunks.back().size = size - offsets.back();
+			length = size;
+		}
+
+		/**
+		 * Obtains the content as a single block of memory. The block remains valid
+		 * until the size of the buffer is altered.
+		 */
+		char* getContiguous() {
+			return resizeContiguous(length);
+		}
+
+		/**
+		 * Truncates or zero-extends the content to the given size and provides it as a
+		 * single block of memory. The block remains valid until the size of the buffer
+		 * is altered.
+		 */
+		char* resizeContiguous(std::size_t size) {
+
+			// if the content fits into the first chunk, it is accessed directly
+			if (chunks.size() == 1 && chunks.front().capacity >= size) {
+				resize(size);
+				return chunks.front().data.get();
+			}
+
+			// otherwise, the content is moved to a new chunk
+			Chunk merged = createChunk(size);
+			auto copied = read(0, merged.data.get(), size);
+			std::memset(merged.data.get() + copied, 0, size - copied);
+			merged.size = size;
+
+			clear();
+			chunks.push_back(std::move(merged));
+			offsets.push_back(0);
+			length = size;
+			return chunks.front().data.get();
+		}
+
+	private:
+
+		static Chunk createChunk(std::size_t capacity) {
+			// at least one byte is allocated to obtain a valid address
+			return Chunk{ std::unique_ptr<char[]>(new char[std::max<std::size_t>(capacity,1)]), capacity, 0 };
+		}
+
+		void addChunk(std::size_t capacity) {
+			offsets.push_back(length);
+			chunks.push_back(createChunk(capacity));
+		}
+
+		template<typename Op>
+		void forEachChunk(std::size_t offset, std::size_t count, const Op& op) const {
+			if (count == 0) return;
+
+			// locate the chunk containing the start position
+			std::size_t i = std::upper_bound(offsets.begin(), offsets.end(), offset) - offsets.begin() - 1;
+
+			// process the range chunk by chunk
+			while(count > 0) {
+				std::size_t pos = offset - offsets[i];
+				std::size_t n = std::min(count, chunks[i].size - pos);
+				op(i, pos, n);
+				offset += n;
+				count -= n;
+				i++;
+			}
+		}
+
+	};
+
+	/**
+	 * A stream buffer reading the content of a chunked buffer, providing
+	 * direct access to its chunks without copying them.
+	 */
+	class ChunkedBufferReader : public std::streambuf {
+
+		const ChunkedBuffer& buffer;
+
+		// the index of the next chunk to be exposed
+		std::size_t next = 0;
+
+		// the offset of the currently exposed chunk within the buffer
+		std::size_t start = 0;
+
+	public:
+
+		ChunkedBufferReader(const ChunkedBuffer& buffer) : buffer(buffer) {}
+
+	protected:
+
+		int_type underflow() override {
+			// move on to the next non-empty chunk
+			while(gptr() == egptr() && next < buffer.getNumChunks()) {
+				start += egptr() - eback();
+				const auto& chunk = buffer.getChunk(next++);
+				setg(chunk.data.get(), chunk.data.get(), chunk.data.get() + chunk.size);
+			}
+			if (gptr() == egptr()) return traits_type::eof();
+			return traits_type::to_int_type(*gptr());
+		}
+
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+			off_type base = 0;
+			if (dir == std::ios_base::cur) base = off_type(start + (gptr() - eback()));
+			if (dir == std::ios_base::end) base = off_type(buffer.size());
+			return seekpos(pos_type(base + off), which);
+		}
+
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+			off_type trg = off_type(pos);
+			if (!(which & std::ios_base::in) || trg < 0 || trg > off_type(buffer.size())) return pos_type(off_type(-1));
+
+			// locate the chunk containing the target position
+			std::size_t offset = 0;
+			std::size_t i = 0;
+			while(i < buffer.getNumChunks() && offset + buffer.getChunk(i).size <= std::size_t(trg)) {
+				offset += buffer.getChunk(i++).size;
+			}
+
+			// expose the remainder of this chunk
+			start = offset;
+			next = i;
+			setg(nullptr, nullptr, nullptr);
+			if (i < buffer.getNumChunks()) {
+				const auto& chunk = buffer.getChunk(next++);
+				setg(chunk.data.get(), chunk.data.get() + (trg - offset), chunk.data.get() + chunk.size);
+			}
+			return pos;
+		}
+
+	};
+
+	/**
+	 * A stream buffer appending data to a chunked buffer, writing directly
+	 * into the free space of its chunks.
+	 */
+	class ChunkedBufferWriter : public std::streambuf {
+
+		ChunkedBuffer& buffer;
+
+	public:
+
+		ChunkedBufferWriter(ChunkedBuffer& buffer) : buffer(buffer) {}
+
+		~ChunkedBufferWriter() {
+			commit();
+		}
+
+	protected:
+
+		int_type overflow(int_type c) override {
+			commit();
+
+			// obtain new free space
+			auto space = buffer.getFreeSpace();
+			setp(space.first, space.second);
+
+			// write the given character
+			if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+			return c;
+		}
+
+		std::streamsize xsputn(const char* data, std::streamsize count) override {
+
+			// small blocks are placed in the current free space
+			if (count <= epptr() - pptr()) {
+				std::memcpy(pptr(), data, count);
+				pbump((int)count);
+				return count;
+			}
+
+			// larger blocks are appended directly
+			commit();
+			buffer.append(data, count);
+			setp(nullptr, nullptr);
+			return count;
+		}
+
+		int sync() override {
+			commit();
+			return 0;
+		}
+
+	private:
+
+		void commit() {
+			// add the data written into the free space to the buffer
+			buffer.commit(pptr() - pbase());
+			setp(pptr(), epptr());
+		}
+
+	};
+
+	/**
+	 * An input stream reading from a chunked buffer.
+	 */
+	class ChunkedBufferInputStream : public std::istream {
+
+		ChunkedBufferReader reader;
+
+	public:
+
+		ChunkedBufferInputStream(const ChunkedBuffer& buffer)
+			: std::istream(nullptr), reader(buffer) {
+			rdbuf(&reader);
+		}
+
+	};
+
+	/**
+	 * An output stream replacing the content of a chunked buffer.
+	 */
+	class ChunkedBufferOutputStream : public std::ostream {
+
+		ChunkedBufferWriter writer;
+
+	public:
+
+		ChunkedBufferOutputStream(ChunkedBuffer& buffer)
+			: std::ostream(nullptr), writer(buffer) {
+			buffer.clear();
+			rdbuf(&writer);
+		}
+
+	};
+
 	struct BufferStorageFactory {
 
 		struct Buffer {
 			std::string name;
 			Mode mode;
-			std::stringstream* stream;
-		};
-
-		struct MemoryMappedBuffer {
-			std::size_t size;
-			void* base;
+			ChunkedBuffer content;
 		};
 
 		std::size_t counter = 0;
 
 		std::map<Entry, Buffer> buffers;
 
-		std::map<Entry,MemoryMappedBuffer> memoryMappedBuffers;
+		std::map<std::string, Entry> index;
 
-		~BufferStorageFactory() {
-			for(const auto& cur : buffers) delete cur.second.stream;
-			for(const auto& cur : memoryMappedBuffers) free(cur.second.base);
-		}
+		/**
+		 * A lock protecting the buffers against concurrent positional operations.
+		 */
+		mutable std::mutex lock;
 
 		Entry createEntry(const std::string& name, Mode mode) {
+			std::lock_guard<std::mutex> guard(lock);
+
 			// check for present entry
-			for(const auto& cur : buffers) {
-				if (cur.second.name == name) {
-					return cur.first;
-				}
-			}
+			auto pos = index.find(name);
+			if (pos != index.end()) return pos->second;
 
 			// create a new entry
 			Entry id{counter++};
 			Buffer& entry = buffers[id];
 			entry.name = name;
 			entry.mode = mode;
-			entry.stream = nullptr;
+			index[name] = id;
 			return id;
 		}
 
 		std::istream* createInputStream(Entry entry) {
+			std::lock_guard<std::mutex> guard(lock);
 
 			// search for entry
-			auto pos = buffers.find(entry);
-			if (pos == buffers.end()) {
+			Buffer* buffer = find(entry);
+			if (!buffer) {
 				assert_fail() << "Unable to create input stream to unknown entity!";
 				return nullptr;
 			}
 
-
-			// reuse current stream content
-			std::stringstream* old = pos->second.stream;
-			std::stringstream* res = (pos->second.mode == Mode::Binary) ?
-					new std::stringstream((old) ? old->str() : std::basic_string<char>(), std::ios_base::in | std::ios_base::binary ) :
-					new std::stringstream((old) ? old->str() : std::basic_string<char>(), std::ios_base::in );
-			delete old;
-			pos->second.stream = res;
-			return res;
+			// read the content of the buffer
+			return new ChunkedBufferInputStream(buffer->content);
 		}
 
 		std::ostream* createOutputStream(Entry entry) {
+			std::lock_guard<std::mutex> guard(lock);
 
 			// search for entry
-			auto pos = buffers.find(entry);
-			if (pos == buffers.end()) {
+			Buffer* buffer = find(entry);
+			if (!buffer) {
 				assert_fail() << "Unable to create output stream to unknown entity!";
 				return nullptr;
 			}
 
-			// reuse current stream content
-			std::stringstream* old = pos->second.stream;
-			std::stringstream* res = (pos->second.mode == Mode::Binary) ?
-					new std::stringstream((old) ? old->str() : std::basic_string<char>(), std::ios_base::out | std::ios_base::binary ) :
-					new std::stringstream((old) ? old->str() : std::basic_string<char>(), std::ios_base::out );
-			delete old;
-			pos->second.stream = res;
-			return res;
+			// replace the content of the buffer
+			return new ChunkedBufferOutputStream(buffer->content);
 		}
 
 		void* createMemoryMappedInput(const Entry& entry) {
+			std::lock_guard<std::mutex> guard(lock);
+
 			// the target buffer needs to be present
-			auto pos = memoryMappedBuffers.find(entry);
-			if (pos == memoryMappedBuffers.end()) return nullptr;
-			return pos->second.base;
+			Buffer* buffer = find(entry);
+			if (!buffer) return nullptr;
+
+			// the content of the buffer is accessed directly
+			return buffer->content.getContiguous();
 		}
 
 		void* createMemoryMappedOutput(const Entry& entry, std::size_t size) {
-			// check whether there is already such a buffer
-			auto pos = memoryMappedBuffers.find(entry);
-			if (pos != memoryMappedBuffers.end()) {
-				// use existing
-				assert_eq(size,pos->second.size) << "Cannot change size of buffer during re-opening!";
-				return pos->second.base;
-			}
+			return resizeMemoryMappedOutput(entry, size);
+		}
 
-			// create a new buffer
-			auto& buffer = memoryMappedBuffers[entry];
-			buffer.size = size;
-			buffer.base = std::malloc(size);
-			return buffer.base;
+		void* resizeMemoryMappedOutput(const Entry& entry, std::size_t size) {
+			std::lock_guard<std::mutex> guard(lock);
+
+			// the target buffer needs to be present
+			Buffer* buffer = find(entry);
+			if (!buffer) return nullptr;
+
+			// the content of the buffer is accessed directly
+			return buffer->content.resizeContiguous(size);
+		}
+
+		std::size_t getMemoryMappedSize(const Entry& entry) const {
+			std::lock_guard<std::mutex> guard(lock);
+			auto pos = buffers.find(entry);
+			return (pos == buffers.end()) ? 0 : pos->second.content.size();
+		}
+
+		static bool isMappedByOS() {
+			return false;
 		}
 
 		void close(const MemoryMappedIO&) {
 			// nothing to do
 		}
 
-		void close(std::istream&) {
-			// nothing to do
+		void close(std::istream& stream) {
+			delete &stream;
 		}
 
-		void close(std::ostream&) {
-			// nothing to do
+		void close(std::ostream& stream) {
+			delete &stream;
 		}
 
 		bool exists(Entry entry) const {
+			std::lock_guard<std::mutex> guard(lock);
 			return buffers.find(entry) != buffers.end();
 		}
 
 		void remove(Entry entry) {
+			std::lock_guard<std::mutex> guard(lock);
 			auto pos = buffers.find(entry);
 			if (pos == buffers.end()) return;
-			delete pos->second.stream;
+			index.erase(pos->second.name);
 			buffers.erase(pos);
 		}
+
+		void writeAt(const Entry& entry, std::size_t offset, const char* data, std::size_t size) {
+			std::lock_guard<std::mutex> guard(lock);
+			Buffer* buffer = find(entry);
+			assert_true(buffer) << "Unable to access unknown entity!";
+			if (buffer) buffer->content.write(offset, data, size);
+		}
+
+		std::size_t readAt(const Entry& entry, std::size_t offset, char* data, std::size_t size) {
+			std::lock_guard<std::mutex> guard(lock);
+			Buffer* buffer = find(entry);
+			assert_true(buffer) << "Unable to access unknown entity!";
+			return (buffer) ? buffer->content.read(offset, data, size) : 0;
+		}
+
+		void resize(const Entry& entry, std::size_t size) {
+			std::lock_guard<std::mutex> guard(lock);
+			Buffer* buffer = find(entry);
+			assert_true(buffer) << "Unable to access unknown entity!";
+			if (buffer) buffer->content.resize(size);
+		}
+
+	private:
+
+		Buffer* find(const Entry& entry) {
+			auto pos = buffers.find(entry);
+			return (pos == buffers.end()) ? nullptr : &pos->second;
+		}
+
 	};
 
 	class BufferIOManager : public IOManager<BufferStorageFactory> {
@@ -809,69 +1726,105 @@ namespace reference {
 
 		using file_descriptor = int;
 
+		/**
+		 * A file descriptor for positional IO, closed once the last operation using it
+		 * has finished.
+		 */
+		struct Descriptor {
+			file_descriptor fd;
+
+			// serializes emulated positional operations
+			std::mutex lock;
+
+			Descriptor(file_descriptor fd) : fd(fd) {}
+
+			Descriptor(const Descriptor&) = delete;
+
+			~Descriptor() {
+				::CLOSE_WRAPPER(fd);
+			}
+		};
+
 		struct File {
 			// general
 			std::string name;
 			Mode mode;
 
+			// protects the remaining state of this file
+			std::mutex lock;
+
 			// for memory-mapped files
 			file_descriptor fd;
 			std::size_t size;
 			void* base;
 
+			// for positional IO
+			std::shared_ptr<Descriptor> positional;
+
 			File(const std::string& name, Mode mode)
 				: name(name), mode(mode), fd(0), size(0), base(nullptr) {}
 
 		};
 
-		std::vector<File> files;
+		std::vector<std::unique_ptr<File>> files;
+
+		std::map<std::string, std::size_t> index;
+
+		/**
+		 * A lock protecting the register of files. Operations on individual files are
+		 * synchronized by the lock of the respective file.
+		 */
+		mutable std::mutex lock;
 
 		Entry createEntry(const std::string& name, Mode mode) {
+			std::lock_guard<std::mutex> guard(lock);
+
 			// check for present entry
-			for(std::size_t i=0; i < files.size(); ++i) {
-				if (files[i].name == name) return Entry{i};
-			}
+			auto pos = index.find(name);
+			if (pos != index.end()) return Entry{pos->second};
 
 			// create a new entry
 			Entry id{files.size()};
-			files.push_back(File(name,mode));
+			files.emplace_back(new File(name,mode));
+			index[name] = id.id;
 			return id;
 		}
 
 		std::istream* createInputStream(Entry entry) {
 
 			// check valid entry id
-			if (entry.id >= files.size()) {
+			File* file = find(entry);
+			if (!file) {
 				assert_fail() << "Unable to create input stream to unknown entity!";
 				return nullptr;
 			}
 
 			// create a matching file stream
-			const File& file = files[entry.id];
-			return (file.mode == Mode::Binary) ?
-				new std::fstream(file.name,std::ios_base::in | std::ios_base::binary) :
-				new std::fstream(file.name,std::ios_base::in);
+			return (file->mode == Mode::Binary) ?
+				new std::fstream(file->name,std::ios_base::in | std::ios_base::binary) :
+				new std::fstream(file->name,std::ios_base::in);
 		}
 
 		std::ostream* createOutputStream(Entry entry) {
 
 			// check valid entry id
-			if (entry.id >= files.size()) {
+			File* file = find(entry);
+			if (!file) {
 				assert_fail() << "Unable to create output stream to unknown entity!";
 				return nullptr;
 			}
 
 			// create a matching file stream
-			const File& file = files[entry.id];
-			return (file.mode == Mode::Binary) ?
-				new std::fstream(file.name,std::ios_base::out | std::ios_base::binary) :
-				new std::fstream(file.name,std::ios_base::out);
+			return (file->mode == Mode::Binary) ?
+				new std::fstream(file->name,std::ios_base::out | std::ios_base::binary) :
+				new std::fstream(file->name,std::ios_base::out);
 		}
 
 		void* createMemoryMappedInput(const Entry& entry) {
 
 			// get a reference to the covered file
 			File& file = getFile(entry);
+			std::lock_guard<std::mutex> guard(file.lock);
 
 			// check that file is not already mapped
 			assert_true(file.base==nullptr)
@@ -906,6 +1859,7 @@ namespace reference {
 
 			// get a reference to the covered file
 			File& file = getFile(entry);
+			std::lock_guard<std::mutex> guard(file.lock);
 
 			// check that file is not already mapped
 			assert_true(file.base==nullptr)
@@ -930,6 +1884,58 @@ namespace reference {
 			return file.base;
 		}
 
+		void* resizeMemoryMappedOutput(const Entry& entry, std::size_t size) {
+
+			// get a reference to the covered file
+			File& file = getFile(entry);
+			std::lock_guard<std::mutex> guard(file.lock);
+
+			// check that the file is mapped
+			assert_true(file.base) << "Error: file " << file.name << " is not mapped!";
+			if (size == file.size) return file.base;
+
+#ifndef _MSC_VER
+			// fix the new size of the file
+			auto succ = ftruncate(file.fd,(off_t)size);
+			assert_eq(0,succ) << "Unable to resize file " << file.name;
+			if (succ != 0) return file.base;
+
+	#ifdef __linux__
+			// extend the mapping, moving it if necessary
+			void* base = mremap(file.base, file.size, size, MREMAP_MAYMOVE);
+	#else
+			// re-create the mapping
+			munmap(file.base, file.size);
+			void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+	#endif
+			// check result of mapping
+			if (!checkMappedAddress(base)) base = nullptr;
+#else
+			// resize the buffer to be written when closing
+			void* base = realloc(file.base, size);
+			if (size > file.size) memset(static_cast<char*>(base) + file.size, 0, size - file.size);
+#endif
+
+			// update the mapping
+			file.base = base;
+			file.size = size;
+			return base;
+		}
+
+		std::size_t getMemoryMappedSize(const Entry& entry) {
+			File& file = getFile(entry);
+			std::lock_guard<std::mutex> guard(file.lock);
+			return file.size;
+		}
+
+		static bool isMappedByOS() {
+#ifndef _MSC_VER
+			return true;
+#else
+			return false;
+#endif
+		}
+
 		void close(std::istream& stream) {
 			delete &stream;
 		}
@@ -947,28 +1953,119 @@ namespace reference {
 		}
 
 		bool exists(Entry entry) const {
-			if (entry.id >= files.size()) return false;
+			const File* file = find(entry);
+			if (!file) return false;
 			struct stat buffer;
-			return stat(files[entry.id].name.c_str(), &buffer) == 0;
+			return stat(file->name.c_str(), &buffer) == 0;
 		}
 
 		void remove(Entry entry) {
-			if (entry.id >= files.size()) return;
-			std::remove(files[entry.id].name.c_str());
+			File* file = find(entry);
+			if (!file) return;
+			{
+				// drop the positional descriptor -- it is closed once operations still using it are done
+				std::lock_guard<std::mutex> guard(file->lock);
+				file->positional.reset();
+			}
+			std::remove(file->name.c_str());
+		}
+
+		void writeAt(const Entry& entry, std::size_t offset, const char* data, std::size_t size) {
+			auto descriptor = getPositionalFileDescriptor(entry);
+			if (!descriptor) return;
+			auto fd = descriptor->fd;
+#ifndef _MSC_VER
+			// write data, continuing after partial writes
+			while(size > 0) {
+				auto res = pwrite(fd, data, size, (off_t)offset);
+				if (res < 0 && errno == EINTR) continue;
+				assert_lt(0,res) << "Unable to write to file descriptor " << fd << ": " << strerror(errno);
+				if (res <= 0) return;
+				data += res;
+				offset += res;
+				size -= res;
+			}
+#else
+			// emulate positional writes by seek and write operations
+			std::lock_guard<std::mutex> guard(descriptor->lock);
+			LSEEK_WRAPPER(fd,(long)offset,SEEK_SET);
+			auto res = WRITE_WRAPPER(fd, data, (unsigned)size);
+			assert_eq((long)size,(long)res) << "Unable to write to file descriptor " << fd;
+#endif
+		}
+
+		std::size_t readAt(const Entry& entry, std::size_t offset, char* data, std::size_t size) {
+			auto descriptor = getPositionalFileDescriptor(entry);
+			if (!descriptor) return 0;
+			auto fd = descriptor->fd;
+			std::size_t total = 0;
+#ifndef _MSC_VER
+			// read data until the requested size or the end of the file is reached
+			while(size > 0) {
+				auto res = pread(fd, data, size, (off_t)offset);
+				if (res < 0 && errno == EINTR) continue;
+				assert_le(0,res) << "Unable to read from file descriptor " << fd << ": " << strerror(errno);
+				if (res <= 0) break;
+				data += res;
+				offset += res;
+				size -= res;
+				total += res;
+			}
+#else
+			// emulate positional reads by seek and read operations
+			std::lock_guard<std::mutex> guard(descriptor->lock);
+			LSEEK_WRAPPER(fd,(long)offset,SEEK_SET);
+			auto res = READ_WRAPPER(fd, data, (unsigned)size);
+			if (res > 0) total = res;
+#endif
+			return total;
+		}
+
+		void resize(const Entry& entry, std::size_t size) {
+			auto descriptor = getPositionalFileDescriptor(entry);
+			if (!descriptor) return;
+			auto fd = descriptor->fd;
+#ifndef _MSC_VER
+			auto succ = ftruncate(fd, (off_t)size);
+#else
+			auto succ = _chsize_s(fd, (__int64)size);
+#endif
+			assert_eq(0,succ) << "Unable to resize file descriptor " << fd;
 		}
 
 	private:
 
+		std::shared_ptr<Descriptor> getPositionalFileDescriptor(const Entry& entry) {
+
+			// get the register entry
+			File& file = getFile(entry);
+			std::lock_guard<std::mutex> guard(file.lock);
+			if (file.positional) return file.positional;
+
+			// open the file, creating it if necessary
+			auto fd = OPEN_WRAPPER(file.name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+			if (fd < 0) fd = OPEN_WRAPPER(file.name.c_str(), O_RDONLY);
+			assert_le(0,fd) << "Error opening file " << file.name;
+			if (fd < 0) return nullptr;
+
+			// keep the descriptor for future operations
+			file.positional = std::make_shared<Descriptor>(fd);
+			return file.positional;
+		}
+
+		File* find(const Entry& entry) const {
+			std::lock_guard<std::mutex> guard(lock);
+			return (entry.id < files.size()) ? files[entry.id].get() : nullptr;
+		}
+
 		File& getFile(const Entry& entry) {
 
 			// check valid entry id
-			if (entry.id >= files.size()) {
-				assert_fail() << "Unknown file entry: " << entry.id;
-				return files[0];
-			}
+			File* file = find(entry);
+			assert_true(file) << "Unknown file entry: " << entry.id;
 
 			// provide access
-			return files[entry.id];
+			return *file;
 		}
 
 		static file_descriptor createFile(const File& file, std::size_t size) {
@@ -1041,13 +2138,15 @@ namespace reference {
 			auto entry = mmio.getEntry();
 
 			// check valid entry id
-			if (entry.id >= files.size()) {
+			File* target = find(entry);
+			if (!target) {
 				assert_fail() << "Unable to close memory mapped input to unknown entity!";
 				return;
 			}
 
 			// get the register entry
-			File& file = files[entry.id];
+			File& file = *target;
+			std::lock_guard<std::mutex> guard(file.lock);
 			if (!file.base) return;
 
 			int succ = 0;
@@ -5,6 +5,7 @@
 #include <iterator>
 
 #include "allscale/utils/assert.h"
+#include "allscale/utils/serializer.h"
 
 namespace allscale {
 namespace api {
@@ -158,6 +159,19 @@ namespace reference {
 
 		// --- print support ---
 
+		// -- serialization --
+
+		void store(utils::ArchiveWriter& writer) const {
+			writer.write(path);
+			writer.write(length);
+		}
+
+		static TaskPath load(utils::ArchiveReader& reader) {
+			auto path = reader.read<path_t>();
+			auto length = reader.read<length_t>();
+			return { path, length };
+		}
+
 		friend std::ostream& operator<<(std::ostream& out, const TaskPath& path) {
 			for(const auto& cur : path) {
 				out << "." << cur;
@@ -243,6 +257,19 @@ namespace reference {
 		}
 
 
+		// -- serialization --
+
+		void store(utils::ArchiveWriter& writer) const {
+			writer.write(id);
+			writer.write(path);
+		}
+
+		static TaskID load(utils::ArchiveReader& reader) {
+			auto id = reader.read<std::uint64_t>();
+			auto path = reader.read<TaskPath>();
+			return { id, path };
+		}
+
 		friend std::ostream& operator<<(std::ostream& out, const TaskID& id) {
 			return out << "T-" << id.id << id.path;
 		}
@@ -254,4 +281,19 @@ namespace reference {
 } // end namespace impl
 } // end namespace core
 } // end namespace api
+
+namespace utils {
+
+	/**
+	 * Task paths are serialized without the padding of their memory representation.
+	 */
+	template<>
+	struct serialized_size<api::core::impl::reference::TaskPath>
+		: public detail::fixed_serialized_size<sizeof(std::uint64_t) + sizeof(std::uint8_t)> {};
+
+	template<>
+	struct serialized_size<api::core::impl::reference::TaskID>
+		: public detail::fixed_serialized_size<sizeof(std::uint64_t) + serialized_size<api::core::impl::reference::TaskPath>::value> {};
+
+} // end namespace utils
 } // end namespace allscale
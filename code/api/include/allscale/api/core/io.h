@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <string>
 
+#include "allscale/api/core/prec.h"
 #include "allscale/api/core/impl/reference/io.h"
 #include "allscale/utils/serializer.h"
 
@@ -23,6 +27,12 @@ namespace core {
 		Text, Binary
 	};
 
+	/**
+	 * Hints on the way the data of memory mapped entries is going to be accessed,
+	 * enabling the OS to adapt its read-ahead and caching policies.
+	 */
+	using impl::reference::AccessHint;
+
 	/**
 	 * An abstraction for a file or buffer to read/write from.
 	 */
@@ -153,6 +163,30 @@ namespace core {
 			return istream.read<T>();
 		}
 
+		/**
+		 * Reads up to the given number of bytes (atomic) and returns the number of bytes obtained.
+		 */
+		std::size_t read(char* dst, std::size_t count) {
+			return istream.read(dst,count);
+		}
+
+#if !defined(ALLSCALE_WITH_HPX)
+		/**
+		 * Creates an archive reader de-serializing data from this stream through a buffer
+		 * of the given size. The underlying stream has to out-live the reader. Data read
+		 * ahead by the reader is given back to the stream when the reader is destroyed,
+		 * such that subsequent reads continue right after the de-serialized data.
+		 */
+		utils::ArchiveReader createArchiveReader(std::size_t bufferSize = utils::ArchiveWriter::STREAM_BUFFER_SIZE) {
+			RefInStream& in = istream;
+			return utils::ArchiveReader([&in](char* dst, std::size_t count) {
+				return in.read(dst,count);
+			}, bufferSize, [&in](std::size_t count) {
+				in.unread(count);
+			});
+		}
+#endif
+
 		/**
 		 * An idiomatic overload of the read operation.
 		 */
@@ -231,6 +265,28 @@ namespace core {
 			return *this;
 		}
 
+		/**
+		 * Writes the given number of bytes (atomic).
+		 */
+		OutputStream& write(const char* src, std::size_t count) {
+			ostream.write(src,count);
+			return *this;
+		}
+
+#if !defined(ALLSCALE_WITH_HPX)
+		/**
+		 * Creates an archive writer serializing data into this stream through a buffer
+		 * of the given size, such that arbitrarily large objects may be written with
+		 * bounded memory. The underlying stream has to out-live the writer.
+		 */
+		utils::ArchiveWriter createArchiveWriter(std::size_t bufferSize = utils::ArchiveWriter::STREAM_BUFFER_SIZE) {
+			RefOutStream& out = ostream;
+			return utils::ArchiveWriter([&out](const char* src, std::size_t count) {
+				out.write(src,count);
+			}, bufferSize);
+		}
+#endif
+
 		/**
 		 * An idiomatic overload of the write operation.
 		 */
@@ -244,6 +300,28 @@ namespace core {
 			return *this;
 		}
 
+		/**
+		 * Determines whether this stream is writing its data asynchronously.
+		 */
+		bool isAsync() const {
+			return ostream.isAsync();
+		}
+
+		/**
+		 * Flushes all data written so far to the underlying storage. For asynchronous
+		 * streams, the returned treeture is completed once the data has been written.
+		 */
+		treeture<void> flush() {
+			struct empty {};
+			RefOutStream& out = ostream;
+			auto ticket = out.requestFlush();
+			return prec(
+				[](empty){ return true; },
+				[&out,ticket](empty){ out.waitFor(ticket); },
+				[&out,ticket](empty,const auto&){ out.waitFor(ticket); }
+			)(after(),empty());
+		}
+
 		/**
 		 * Allows to test whether this stream is in a valid state. It can, for instance,
 		 * be utilized to determine whether there has been an error during the last
@@ -271,6 +349,80 @@ namespace core {
 	// -- Memory Mapped IO --------------------------------------------------
 
 
+	namespace detail {
+
+		/**
+		 * Runs the given body for all indices within [0,n) in parallel, one task per index,
+		 * and waits for their completion.
+		 */
+		template<typename Body>
+		void parallelFor(std::size_t n, const Body& body) {
+			struct Range {
+				std::size_t begin;
+				std::size_t end;
+			};
+			prec(
+				[](const Range& r) {
+					return r.end - r.begin <= 1;
+				},
+				[&body](const Range& r) {
+					if (r.begin < r.end) body(r.begin);
+				},
+				[](const Range& r, const auto& nested) {
+					std::size_t mid = r.begin + (r.end - r.begin) / 2;
+					return parallel(
+						nested(Range{ r.begin, mid }),
+						nested(Range{ mid, r.end })
+					);
+				}
+			)(Range{ 0, n }).wait();
+		}
+
+		/**
+		 * Loads the pages of the given range of memory mapped data in parallel by touching
+		 * them from concurrent tasks, such that later accesses do not have to wait for the
+		 * storage.
+		 */
+		inline treeture<void> prefetch(const impl::reference::MemoryMappedIO& io, const char* base, std::size_t offset, std::size_t length) {
+
+			// restrict the range to the mapped data
+			if (offset >= io.getSize()) return done();
+			length = std::min(length, io.getSize() - offset);
+
+			// ask the OS to start loading the data
+			io.advise(AccessHint::WillNeed, offset, length);
+
+			// touch pages in parallel
+			struct Range {
+				const char* begin;
+				std::size_t size;
+			};
+
+			const std::size_t pageSize = impl::reference::MemoryMappedIO::getPageSize();
+			const std::size_t grainSize = 256 * pageSize;
+			return prec(
+				[grainSize](const Range& r) {
+					return r.size <= grainSize;
+				},
+				[pageSize](const Range& r) {
+					const volatile char* data = r.begin;
+					for(std::size_t i=0; i<r.size; i+=pageSize) {
+						data[i];
+					}
+				},
+				[pageSize](const Range& r, const auto& nested) {
+					// split at a page boundary
+					std::size_t mid = (r.size / pageSize / 2) * pageSize;
+					return parallel(
+						nested(Range{ r.begin, mid }),
+						nested(Range{ r.begin + mid, r.size - mid })
+					);
+				}
+			)(Range{ base + offset, length });
+		}
+
+	} // end namespace detail
+
 	/**
 	 * A utility for reading the content of a storage entity (e.g. a file) through
 	 * memory mapped IO.
@@ -313,6 +465,30 @@ namespace core {
 			return &access<T>();
 		}
 
+		/**
+		 * The size of the mapped data in bytes.
+		 */
+		std::size_t size() const {
+			return impl.getSize();
+		}
+
+		/**
+		 * Provides a hint on how the given byte range of the mapped data is going
+		 * to be accessed. Hints are ignored by storage not mapped by the OS.
+		 */
+		void advise(AccessHint hint, std::size_t offset = 0, std::size_t length = std::numeric_limits<std::size_t>::max()) const {
+			impl.advise(hint, offset, length);
+		}
+
+		/**
+		 * Loads the given byte range of the mapped data in parallel ahead of its use.
+		 *
+		 * @return a treeture completed once all covered pages have been loaded
+		 */
+		treeture<void> prefetch(std::size_t offset = 0, std::size_t length = std::numeric_limits<std::size_t>::max()) const {
+			return detail::prefetch(impl, accessArray<char>(), offset, length);
+		}
+
 		// -- make it serializable --
 
 		static MemoryMappedInput load(utils::ArchiveReader& a) {
@@ -366,6 +542,30 @@ namespace core {
 			return &access<T>();
 		}
 
+		/**
+		 * The size of the mapped data in bytes.
+		 */
+		std::size_t size() const {
+			return impl.getSize();
+		}
+
+		/**
+		 * Provides a hint on how the given byte range of the mapped data is going
+		 * to be accessed. Hints are ignored by storage not mapped by the OS.
+		 */
+		void advise(AccessHint hint, std::size_t offset = 0, std::size_t length = std::numeric_limits<std::size_t>::max()) const {
+			impl.advise(hint, offset, length);
+		}
+
+		/**
+		 * Loads the given byte range of the mapped data in parallel ahead of its use.
+		 *
+		 * @return a treeture completed once all covered pages have been loaded
+		 */
+		treeture<void> prefetch(std::size_t offset = 0, std::size_t length = std::numeric_limits<std::size_t>::max()) const {
+			return detail::prefetch(impl, accessArray<char>(), offset, length);
+		}
+
 		// -- make it serializable --
 
 		static MemoryMappedOutput load(utils::ArchiveReader& a) {
@@ -382,7 +582,17 @@ namespace core {
 	// -- IO Manager --------------------------------------------------------
 
 	/**
-	 * An IO manager, as the central dispatcher for IO operations.
+	 * The default size of chunks processed by individual tasks of chunked IO operations.
+	 */
+	constexpr std::size_t DEFAULT_IO_CHUNK_SIZE = 4 * 1024 * 1024;
+
+	/**
+	 * An IO manager, as the central dispatcher for IO operations. All operations may
+	 * be invoked concurrently, such that tasks may open, use, and close their own
+	 * entries. Opening an entry that is already open has no effect and the first close
+	 * operation closes it. Tasks sharing an entry without coordinating its closing may
+	 * use the share operations instead, keeping the entry open until each of them has
+	 * been matched by a close operation.
 	 */
 	template<typename StorageManager>
 	class IOManager {
@@ -405,10 +615,8 @@ namespace core {
 		}
 
 		/**
-		 * Register a new output stream with the given name within the system.
-		 * The call will create the underlying file and prepare output operations.
-		 *
-		 *  NOTE: this method is not thread safe!
+		 * Register a new input stream with the given name within the system.
+		 * The call will open the underlying file and prepare input operations.
 		 *
 		 * @param entry the name of the stream to be opened -- nothing happens if already opened
 		 */
@@ -416,49 +624,123 @@ namespace core {
 			return InputStream(impl.openInputStream(entry.entry));
 		}
 
+		/**
+		 * Opens an input stream like openInputStream, but keeps a stream that is already
+		 * open alive until this call has been matched by an additional close operation.
+		 *
+		 * @param entry the name of the stream to be opened or shared
+		 */
+		InputStream shareInputStream(Entry entry) {
+			return InputStream(impl.shareInputStream(entry.entry));
+		}
+
 		/**
 		 * Register a new output stream with the given name within the system.
 		 * The call will create the underlying file and prepare output operations.
 		 *
-		 *  NOTE: this method is not thread safe!
-		 *
 		 * @param entry the name of the stream to be opened -- nothing happens if already opened
 		 */
 		OutputStream openOutputStream(Entry entry) {
 			return OutputStream(impl.openOutputStream(entry.entry));
 		}
 
+		/**
+		 * Opens an output stream like openOutputStream, but keeps a stream that is already
+		 * open alive until this call has been matched by an additional close operation.
+		 *
+		 * @param entry the name of the stream to be opened or shared
+		 */
+		OutputStream shareOutputStream(Entry entry) {
+			return OutputStream(impl.shareOutputStream(entry.entry));
+		}
+
+		/**
+		 * Register a new asynchronous output stream with the given name within the system.
+		 * Data written to the stream is collected in per-thread buffers and written by a
+		 * background thread, such that writing tasks do not wait for each other or the
+		 * storage. Data written within a single atomic operation remains contiguous, while
+		 * the order of data written by different threads is not preserved.
+		 *
+		 * @param entry the name of the stream to be opened -- nothing happens if already opened
+		 */
+		OutputStream openAsyncOutputStream(Entry entry) {
+			return OutputStream(impl.openOutputStream(entry.entry,true));
+		}
+
+		/**
+		 * Opens an asynchronous output stream like openAsyncOutputStream, but keeps a stream
+		 * that is already open alive until this call has been matched by an additional close
+		 * operation.
+		 *
+		 * @param entry the name of the stream to be opened or shared
+		 */
+		OutputStream shareAsyncOutputStream(Entry entry) {
+			return OutputStream(impl.shareOutputStream(entry.entry,true));
+		}
+
 		/**
 		 * Register a new memory mapped input with the given name within the system.
 		 * The call will load the underlying storage and prepare input operations.
 		 *
-		 *  NOTE: this method is not thread safe!
-		 *
 		 * @param entry the storage entry to be opened -- nothing happens if already opened
 		 */
 		MemoryMappedInput openMemoryMappedInput(Entry entry) {
 			return MemoryMappedInput(impl.openMemoryMappedInput(entry.entry));
 		}
 
+		/**
+		 * Opens a memory mapped input like openMemoryMappedInput, but keeps a mapping that
+		 * is already open alive until this call has been matched by an additional close operation.
+		 *
+		 * @param entry the storage entry to be opened or shared
+		 */
+		MemoryMappedInput shareMemoryMappedInput(Entry entry) {
+			return MemoryMappedInput(impl.shareMemoryMappedInput(entry.entry));
+		}
+
 		/**
 		 * Register a new memory mapped output with the given name within the system.
 		 * The call will create the underlying storage and prepare output operations.
 		 *
-		 *  NOTE: this method is not thread safe!
-		 *
 		 * @param entry the storage entry to be opened -- nothing happens if already opened
 		 */
 		MemoryMappedOutput openMemoryMappedOutput(Entry entry, std::size_t size) {
 			return MemoryMappedOutput(impl.openMemoryMappedOutput(entry.entry,size));
 		}
 
+		/**
+		 * Opens a memory mapped output like openMemoryMappedOutput, but keeps a mapping that
+		 * is already open alive until this call has been matched by an additional close operation.
+		 *
+		 * @param entry the storage entry to be opened or shared
+		 */
+		MemoryMappedOutput shareMemoryMappedOutput(Entry entry, std::size_t size) {
+			return MemoryMappedOutput(impl.shareMemoryMappedOutput(entry.entry,size));
+		}
+
+		/**
+		 * Changes the size of an open memory mapped output, e.g. to extend an output
+		 * whose final size is not known in advance. The data within the common prefix
+		 * is preserved, additional space is zero-initialized. The data may be moved,
+		 * invalidating previously obtained handles and references.
+		 *
+		 *  NOTE: no other task may access the data of the output concurrently!
+		 *
+		 * @param out the memory mapped output to be resized
+		 * @param size the new size in bytes
+		 * @return an updated handle to the memory mapped output
+		 */
+		MemoryMappedOutput resizeMemoryMappedOutput(const MemoryMappedOutput& out, std::size_t size) {
+			return MemoryMappedOutput(impl.resizeMemoryMappedOutput(out.impl,size));
+		}
+
 		/**
 		 * Obtains an input stream to read data from a storage entry.
-		 * The storage entry is maintained by the manager and the provided output stream
-		 * is only valid within the current thread.
+		 * The storage entry is maintained by the manager and the provided input stream
+		 * remains valid until the stream is closed.
 		 *
 		 * @param entry the name of the storage entry to be targeted -- must be open
-		 * @return a stream to append data to
+		 * @return a stream to read data from
 		 */
 		InputStream getInputStream(Entry entry) {
 			return InputStream(impl.getInputStream(entry.entry));
@@ -467,7 +749,7 @@ namespace core {
 		/**
 		 * Obtains an output stream to write data to a storage entry.
 		 * The storage entry is maintained by the manager and the provided output stream
-		 * is only valid within the current thread.
+		 * remains valid until the stream is closed.
 		 *
 		 * @param entry the name of the storage entry to be targeted -- must be open
 		 * @return a stream to append data to
@@ -479,50 +761,51 @@ namespace core {
 		/**
 		 * Obtains a memory mapped input to read data from a storage entry.
 		 * The storage entry is maintained by the manager and the provided memory mapped
-		 * input is only valid within the current thread.
+		 * input remains valid until the input is closed.
 		 *
 		 * @param entry the name of the storage entry to be targeted -- must be open
 		 * @return a requested memory mapped input
 		 */
 		MemoryMappedInput getMemoryMappedInput(Entry entry) {
-			return MemoryMappedInput(impl.getMemoryMappedInput(entry));
+			return MemoryMappedInput(impl.getMemoryMappedInput(entry.entry));
 		}
 
 		/**
 		 * Obtains a memory mapped output to write data to a storage entry.
 		 * The storage entry is maintained by the manager and the provided memory mapped
-		 * output is only valid within the current thread.
+		 * output remains valid until the output is closed or resized.
 		 *
 		 * @param entry the name of the storage entry to be targeted -- must be open
 		 * @return a requested memory mapped output
 		 */
-		MemoryMappedOutput getMemoryMappedOutput(Entry entry, std::size_t size) {
-			return MemoryMappedOutput(impl.getMemoryMappedOutput(entry,size));
+		MemoryMappedOutput getMemoryMappedOutput(Entry entry) {
+			return MemoryMappedOutput(impl.getMemoryMappedOutput(entry.entry));
 		}
 
 		/**
-		 * Closes the given stream.
+		 * Closes the given stream, once all tasks having opened it have closed it.
 		 */
 		void close(const InputStream& in) {
 			impl.close(in.istream);
 		}
 
 		/**
-		 * Closes the given stream.
+		 * Closes the given stream, once all tasks having opened it have closed it.
+		 * Pending data of asynchronous streams is written before returning.
 		 */
 		void close(const OutputStream& out) {
 			impl.close(out.ostream);
 		}
 
 		/**
-		 * Closes the given memory mapped entry.
+		 * Closes the given memory mapped entry, once all tasks having opened it have closed it.
 		 */
 		void close(const MemoryMappedInput& in) {
 			impl.close(in.impl);
 		}
 
 		/**
-		 * Closes the given memory mapped entry.
+		 * Closes the given memory mapped entry, once all tasks having opened it have closed it.
 		 */
 		void close(const MemoryMappedOutput& out) {
 			impl.close(out.impl);
@@ -542,6 +825,88 @@ namespace core {
 			impl.remove(entry.entry);
 		}
 
+		/**
+		 * Writes a block of data at the given byte offset of an entry, without
+		 * the need of opening a stream. The entry is created if it does not exist
+		 * and extended if necessary. Writes to disjoint ranges of an entry may be
+		 * conducted concurrently by different tasks.
+		 *
+		 * @param entry the storage entry to be written to
+		 * @param offset the byte offset of the first byte to be written
+		 * @param data the start of the block to be written
+		 * @param size the number of bytes to be written
+		 */
+		void writeAt(Entry entry, std::size_t offset, const char* data, std::size_t size) {
+			impl.writeAt(entry.entry, offset, data, size);
+		}
+
+		/**
+		 * Reads a block of data from the given byte offset of an entry, without
+		 * the need of opening a stream. Reads may be conducted concurrently.
+		 *
+		 * @param entry the storage entry to be read from
+		 * @param offset the byte offset of the first byte to be read
+		 * @param data the buffer to be filled
+		 * @param size the number of bytes to be read
+		 * @return the number of bytes read, less than size if the end of the entry has been reached
+		 */
+		std::size_t readAt(Entry entry, std::size_t offset, char* data, std::size_t size) {
+			return impl.readAt(entry.entry, offset, data, size);
+		}
+
+		/**
+		 * Truncates or extends the given entry to the given number of bytes.
+		 */
+		void resize(Entry entry, std::size_t size) {
+			impl.resize(entry.entry, size);
+		}
+
+		/**
+		 * Replaces the content of the given entry by the given buffer, written in parallel
+		 * by one task per chunk.
+		 *
+		 * @param entry the storage entry to be written to
+		 * @param data the start of the buffer to be written
+		 * @param size the number of bytes to be written
+		 * @param chunkSize the number of bytes written by a single task
+		 */
+		void writeChunked(Entry entry, const char* data, std::size_t size, std::size_t chunkSize = DEFAULT_IO_CHUNK_SIZE) {
+			assert_lt(0u, chunkSize);
+
+			// fix the size of the entry, such that chunks do not need to extend it
+			resize(entry, size);
+
+			// write chunks independently
+			std::size_t numChunks = (size + chunkSize - 1) / chunkSize;
+			detail::parallelFor(numChunks, [&](std::size_t i) {
+				std::size_t begin = i * chunkSize;
+				writeAt(entry, begin, data + begin, std::min(chunkSize, size - begin));
+			});
+		}
+
+		/**
+		 * Reads the leading bytes of the given entry into the given buffer, read in parallel
+		 * by one task per chunk.
+		 *
+		 * @param entry the storage entry to be read from
+		 * @param data the buffer to be filled
+		 * @param size the number of bytes to be read
+		 * @param chunkSize the number of bytes read by a single task
+		 * @return the number of bytes read, less than size if the entry is shorter
+		 */
+		std::size_t readChunked(Entry entry, char* data, std::size_t size, std::size_t chunkSize = DEFAULT_IO_CHUNK_SIZE) {
+			assert_lt(0u, chunkSize);
+
+			// read chunks independently, counting the bytes obtained
+			std::atomic<std::size_t> total(0);
+			std::size_t numChunks = (size + chunkSize - 1) / chunkSize;
+			detail::parallelFor(numChunks, [&](std::size_t i) {
+				std::size_t begin = i * chunkSize;
+				total += readAt(entry, begin, data + begin, std::min(chunkSize, size - begin));
+			});
+			return total;
+		}
+
 	};
 
 	// Definition of the BufferIOManager
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "allscale/api/core/io.h"
+#include "allscale/api/user/algorithm/pfor.h"
+#include "allscale/utils/assert.h"
+#include "allscale/utils/compression.h"
+
+
+namespace allscale {
+namespace api {
+namespace user {
+
+// The default number of chunks compressed or decompressed in parallel by stream wrappers
+constexpr std::size_t DEFAULT_CHUNKS_PER_BLOCK = 16;
+
+// Compress the given data into a sequence of chunks, compressing chunks in parallel; the result can be decoded by utils::decompress
+inline std::vector<char> parallelCompress(const char* data, std::size_t size, const utils::CompressionOptions& options = utils::CompressionOptions()) {
+	assert_lt(0u, options.chunkSize);
+	std::size_t numChunks = (size + options.chunkSize - 1) / options.chunkSize;
+
+	// compress chunks independently
+	std::vector<std::vector<char>> chunks(numChunks);
+	algorithm::pfor(std::size_t(0), numChunks, [&](std::size_t i) {
+		std::size_t begin = i * options.chunkSize;
+		utils::compressChunk(data + begin, std::min(options.chunkSize, size - begin), options, chunks[i]);
+	});
+
+	// concatenate the results
+	std::size_t total = 0;
+	for(const auto& cur : chunks) total += cur.size();
+	std::vector<char> res(total);
+	std::vector<std::size_t> offsets(numChunks + 1, 0);
+	for(std::size_t i = 0; i < numChunks; ++i) offsets[i+1] = offsets[i] + chunks[i].size();
+	algorithm::pfor(std::size_t(0), numChunks, [&](std::size_t i) {
+		std::memcpy(res.data() + offsets[i], chunks[i].data(), chunks[i].size());
+	});
+	return res;
+}
+
+// Decompress the given sequence of chunks in parallel, appending the data to the given buffer; returns false if the data is malformed
+inline bool parallelDecompress(const char* data, std::size_t size, std::vector<char>& res) {
+
+	// locate all chunks and their target positions
+	std::vector<const char*> chunks;
+	std::vector<std::size_t> chunkSizes;
+	std::vector<std::size_t> offsets(1, res.size());
+	const char* end = data + size;
+	while(data != end) {
+		std::size_t chunkSize, rawSize;
+		if (!utils::getChunkSize(data, end - data, chunkSize, rawSize)) return false;
+		chunks.push_back(data);
+		chunkSizes.push_back(chunkSize);
+		offsets.push_back(offsets.back() + rawSize);
+		data += chunkSize;
+	}
+
+	// decode them independently
+	res.resize(offsets.back());
+	std::vector<char> valid(chunks.size(), 0);
+	algorithm::pfor(std::size_t(0), chunks.size(), [&](std::size_t i) {
+		valid[i] = utils::decompressChunk(chunks[i], chunkSizes[i], res.data() + offsets[i]);
+	});
+	for(auto cur : valid) if (!cur) return false;
+	return true;
+}
+
+#if !defined(ALLSCALE_WITH_HPX)
+
+// Create an archive writer compressing its data into the given stream, compressing blocks of the given number of chunks in parallel; the stream has to out-live the writer, which terminates the compressed data when being destroyed
+inline utils::ArchiveWriter createCompressingWriter(core::OutputStream& out, const utils::CompressionOptions& options = utils::CompressionOptions(), std::size_t chunksPerBlock = DEFAULT_CHUNKS_PER_BLOCK) {
+	assert_lt(0u, chunksPerBlock);
+	auto sink = std::make_shared<utils::detail::TerminatingSink>([&out](const char* data, std::size_t size) {
+		out.write(data, size);
+	});
+	return utils::ArchiveWriter([sink,options](const char* data, std::size_t size) {
+		auto chunks = parallelCompress(data, size, options);
+		sink->sink(chunks.data(), chunks.size());
+	}, options.chunkSize * chunksPerBlock);
+}
+
+// Create an archive reader consuming compressed data from the given stream, decompressing blocks of the given number of chunks in parallel; the stream has to out-live the reader, which leaves it positioned after the end of the compressed data once destroyed
+inline utils::ArchiveReader createDecompressingReader(core::InputStream& in, std::size_t chunksPerBlock = DEFAULT_CHUNKS_PER_BLOCK) {
+	assert_lt(0u, chunksPerBlock);
+
+	struct State {
+		core::InputStream& in;
+		std::vector<char> chunks;
+		std::vector<char> data;
+		std::size_t pos = 0;
+		bool ended = false;
+
+		State(core::InputStream& in) : in(in) {}
+
+		bool readFully(char* trg, std::size_t size) {
+			while(size > 0) {
+				auto res = in.read(trg, size);
+				if (res == 0) return false;
+				trg += res;
+				size -= res;
+			}
+			return true;
+		}
+
+		// append the next chunk to the current block, false at the end of the stream
+		bool nextChunk() {
+			if (ended) return false;
+			utils::detail::ChunkHeader header;
+			std::size_t start = chunks.size();
+			chunks.resize(start + sizeof(header));
+			if (!readFully(chunks.data() + start, sizeof(header))) {
+				chunks.resize(start);
+				return false;
+			}
+			std::memcpy(&header, chunks.data() + start, sizeof(header));
+
+			// stop at the end of the stream, without touching any data following it
+			if (header.rawSize == 0) {
+				chunks.resize(start);
+				ended = true;
+				return false;
+			}
+
+			// chunks are never stored larger than their data
+			bool valid = header.storedSize <= header.rawSize;
+			assert_true(valid) << "Malformed compressed data!";
+			if (!valid) {
+				chunks.resize(start);
+				return false;
+			}
+
+			chunks.resize(start + sizeof(header) + header.storedSize);
+			bool complete = readFully(chunks.data() + start + sizeof(header), header.storedSize);
+			assert_true(complete) << "Unexpected end of compressed data!";
+			if (!complete) chunks.resize(start);
+			return complete;
+		}
+
+		~State() {
+			// skip chunks not consumed, leaving the stream positioned after the compressed data
+			chunks.clear();
+			while(nextChunk()) chunks.clear();
+		}
+	};
+
+	auto state = std::make_shared<State>(in);
+	return utils::ArchiveReader([state,chunksPerBlock](char* dst, std::size_t count) -> std::size_t {
+
+		// fetch the next block of chunks from the stream
+		if (state->pos == state->data.size()) {
+			auto& chunks = state->chunks;
+			chunks.clear();
+			for(std::size_t i = 0; i < chunksPerBlock && state->nextChunk(); ++i) {}
+			state->data.clear();
+			state->pos = 0;
+			bool ok = parallelDecompress(chunks.data(), chunks.size(), state->data);
+			assert_true(ok) << "Malformed compressed data!";
+			if (!ok || state->data.empty()) return 0;
+		}
+
+		std::size_t res = std::min(count, state->data.size() - state->pos);
+		std::memcpy(dst, state->data.data() + state->pos, res);
+		state->pos += res;
+		return res;
+	}, utils::ArchiveWriter::STREAM_BUFFER_SIZE);
+}
+
+#endif
+
+} // end namespace user
+} // end namespace api
+} // end namespace allscale
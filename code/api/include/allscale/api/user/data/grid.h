@@ -2,6 +2,7 @@
 
 #include <cstring>
 #include <memory>
+#include <string>
 
 #include "allscale/api/core/data.h"
 
@@ -642,6 +643,9 @@ namespace data {
 		size_type totalSize;
 		region_type coveredRegion;
 
+		// the flattened index intervals of the covered region, kept for repeated access hints
+		utils::detail::Intervals coveredIntervals;
+
 		utils::LargeArray<T> data;
 
 	public:
@@ -654,12 +658,21 @@ namespace data {
 			assert_pred2(core::isSubRegion, region, region_type(totalSize));
 		}
 
-		GridFragment(const shared_data_type& sharedData, const region_type& region = region_type())
-				: totalSize(sharedData.size), coveredRegion(region), data(area(totalSize)) {
+		GridFragment(const shared_data_type& sharedData, const region_type& region = region_type(), utils::PagingPolicy paging = utils::PagingPolicy::Default)
+				: totalSize(sharedData.size), coveredRegion(region), data(area(totalSize), paging) {
 			// allocate covered data space
-			region.scanByLines([&](const point& a, const point& b) {
-				data.allocate(flatten(a),flatten(b));
-			});
+			coveredIntervals = toIntervals(region);
+			data.allocate(coveredIntervals);
+		}
+
+		/**
+		 * Creates a fragment whose data is stored in the given (sparse) file instead of main memory.
+		 */
+		GridFragment(const shared_data_type& sharedData, const region_type& region, const std::string& file)
+				: totalSize(sharedData.size), coveredRegion(region), data(area(totalSize), file) {
+			// allocate covered data space
+			coveredIntervals = toIntervals(region);
+			data.allocate(coveredIntervals);
 		}
 
 		T& operator[](const point& pos) {
@@ -690,18 +703,70 @@ namespace data {
 
 			// update the size
 			coveredRegion = newCoveredRegion;
+			coveredIntervals = toIntervals(coveredRegion);
 
 			// allocated new data
-			plus.scanByLines([&](const point& a, const point& b){
-				data.allocate(flatten(a),flatten(b));
-			});
+			data.allocate(toIntervals(plus));
 
 			// free excessive memory
-			minus.scanByLines([&](const point& a, const point& b){
-				data.free(flatten(a),flatten(b));
+			data.free(toIntervals(minus));
+		}
+
+		/**
+		 * Populates the memory backing the covered region in parallel, such that the first
+		 * accesses to the elements of this fragment do not have to pay for page faults.
+		 */
+		void prefault() {
+
+			// split the covered region into chunks of about a huge page
+			std::size_t chunkSize = std::max<std::size_t>(1, utils::LargeArray<T>::HUGE_PAGE_SIZE / sizeof(T));
+			std::vector<std::pair<std::size_t,std::size_t>> chunks;
+			coveredRegion.scanByLines([&](const point& a, const point& b) {
+				std::size_t begin = flatten(a);
+				std::size_t end = flatten(b);
+
+				// extend the previous chunk if possible
+				if (!chunks.empty() && chunks.back().second == begin && chunks.back().second - chunks.back().first < chunkSize) {
+					auto& last = chunks.back();
+					last.second = std::min(end, last.first + chunkSize);
+					begin = last.second;
+				}
+
+				// add remaining chunks
+				for(; begin < end; begin += chunkSize) {
+					chunks.push_back({ begin, std::min(end, begin + chunkSize) });
+				}
+			});
+
+			// populate the chunks in parallel
+			algorithm::pfor(std::size_t(0), chunks.size(), [&](std::size_t i) {
+				data.prefault(chunks[i].first, chunks[i].second);
+			});
+		}
+
+		/**
+		 * Determines whether the data of this fragment is stored in a file.
+		 */
+		bool isFileBacked() const {
+			return data.isFileBacked();
+		}
+
+		/**
+		 * Announces the pattern of upcoming accesses to the covered region.
+		 */
+		void advise(utils::AccessPattern pattern) {
+			coveredIntervals.forEachInterval([&](std::size_t begin, std::size_t end) {
+				data.advise(begin,end,pattern);
 			});
 		}
 
+		/**
+		 * Writes all modifications of a file-backed fragment to its file.
+		 */
+		void flush() {
+			data.flush();
+		}
+
 		void insert(const GridFragment& other, const region_type& area) {
 			assert_true(core::isSubRegion(area,other.coveredRegion)) << "New data " << area << " not covered by source of size " << other.coveredRegion << "\n";
 			assert_true(core::isSubRegion(area,coveredRegion))       << "New data " << area << " not covered by target of size " << coveredRegion << "\n";
@@ -724,9 +789,7 @@ namespace data {
 			writer.write(region);
 
 			// add the data
-			region.scan([&](const point& p){
-				writer.write((*this)[p]);
-			});
+			extractData(writer,region,utils::is_trivially_serializable<T>());
 		}
 
 		void insert(utils::ArchiveReader& reader) {
@@ -739,12 +802,46 @@ namespace data {
 				<< "Targeted fragment does not cover data to be inserted!";
 
 			// insert the data
+			insertData(reader,region,utils::is_trivially_serializable<T>());
+		}
+
+	private:
+
+		void extractData(utils::ArchiveWriter& writer, const region_type& region, std::true_type) const {
+			// write data line by line, in the same order as the point-wise scan
+			region.scanByLines([&](const point& a, const point& b){
+				auto start = flatten(a);
+				auto length = (flatten(b) - start) * sizeof(T);
+				writer.write(reinterpret_cast<const char*>(&data[start]),length);
+			});
+		}
+
+		void extractData(utils::ArchiveWriter& writer, const region_type& region, std::false_type) const {
+			region.scan([&](const point& p){
+				writer.write((*this)[p]);
+			});
+		}
+
+		void insertData(utils::ArchiveReader& reader, const region_type& region, std::true_type) {
+			// copy lines directly from the archive buffer
+			region.scanByLines([&](const point& a, const point& b){
+				auto start = flatten(a);
+				reader.read_span<T>(flatten(b) - start).copyTo(&data[start]);
+			});
+		}
+
+		void insertData(utils::ArchiveReader& reader, const region_type& region, std::false_type) {
 			region.scan([&](const point& p){
 				(*this)[p] = reader.read<T>();
 			});
 		}
 
-	private:
+		/**
+		 * Converts the given region into the list of flattened index intervals it is covering.
+		 */
+		utils::detail::Intervals toIntervals(const region_type& region) const {
+			return utils::detail::toIntervals(region,[&](const point& p) { return flatten(p); });
+		}
 
 		static std::size_t area(const GridPoint<Dims>& pos) {
 			std::size_t res = 1;
@@ -809,6 +906,19 @@ namespace data {
 		Grid(const coordinate_type& size)
 			: owned(std::make_unique<GridFragment<T,Dims>>(GridSharedData<Dims>{ size },region_type(0,size))), base(owned.get()) {}
 
+		/**
+		 * Creates a new Grid covering the given region, utilizing the given paging policy for its storage.
+		 */
+		Grid(const coordinate_type& size, utils::PagingPolicy paging)
+			: owned(std::make_unique<GridFragment<T,Dims>>(GridSharedData<Dims>{ size },region_type(0,size),paging)), base(owned.get()) {}
+
+		/**
+		 * Creates a new Grid covering the given region, storing its data in the given file. Grids
+		 * exceeding the main memory may this way be maintained on local storage.
+		 */
+		Grid(const coordinate_type& size, const std::string& file)
+			: owned(std::make_unique<GridFragment<T,Dims>>(GridSharedData<Dims>{ size },region_type(0,size),file)), base(owned.get()) {}
+
 		/**
 		 * Disable copy construction.
 		 */
@@ -850,12 +960,34 @@ namespace data {
 			return data_item_element_access(*this, region_type::single(index), (*base)[index]);
 		}
 
+		/**
+		 * Populates the memory of this grid in parallel, avoiding page faults on first access.
+		 */
+		void prefault() {
+			base->prefault();
+		}
+
+		/**
+		 * Writes all modifications of a file-backed grid to its file.
+		 */
+		void flush() {
+			base->flush();
+		}
+
+		/**
+		 * Announces the pattern of upcoming accesses to this grid.
+		 */
+		void advise(utils::AccessPattern pattern) {
+			base->advise(pattern);
+		}
+
 		/**
 		 * A sequential scan over all elements within this grid, providing
 		 * read-only access.
 		 */
 		template<typename Op>
 		void forEach(const Op& op) const {
+			adviseScan();
 			allscale::api::user::algorithm::detail::forEach(
 					coordinate_type(0),
 					size(),
@@ -871,6 +1003,7 @@ namespace data {
 		 */
 		template<typename Op>
 		void forEach(const Op& op) {
+			adviseScan();
 			allscale::api::user::algorithm::detail::forEach(
 					coordinate_type(0),
 					size(),
@@ -886,6 +1019,7 @@ namespace data {
 		 */
 		template<typename Op>
 		auto pforEach(const Op& op) const {
+			adviseScan();
 			return algorithm::pfor(coordinate_type(0), size(), [&](const auto& pos) { op((*this)[pos]); });
 		}
 
@@ -895,12 +1029,36 @@ namespace data {
 		 */
 		template<typename Op>
 		auto pforEach(const Op& op) {
+			adviseScan();
 			return algorithm::pfor(coordinate_type(0), size(), [&](const auto& pos) { op((*this)[pos]); });
 		}
 
+	private:
+
+		/**
+		 * Announces an upcoming scan over all elements to file-backed grids, such that their
+		 * content may be read ahead of time.
+		 */
+		void adviseScan() const {
+			if (base->isFileBacked()) base->advise(utils::AccessPattern::Sequential);
+		}
+
 	};
 
 } // end namespace data
 } // end namespace user
 } // end namespace api
+
+namespace utils {
+
+	/**
+	 * Grid boxes are serialized as their pair of corner points, matching their memory layout.
+	 */
+	template<std::size_t Dims>
+	struct is_trivially_serializable<api::user::data::GridBox<Dims>,typename std::enable_if<
+			is_trivially_serializable<api::user::data::GridPoint<Dims>>::value &&
+			sizeof(api::user::data::GridBox<Dims>) == 2 * sizeof(api::user::data::GridPoint<Dims>),
+		void>::type> : public std::true_type {};
+
+} // end namespace utils
 } // end namespace allscale
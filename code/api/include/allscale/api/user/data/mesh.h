@@ -1,11 +1,21 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <ostream>
+#include <string>
 #include <tuple>
+#include <typeindex>
 
 #include <bitset>
+#include <cstdint>
 #include <cstring>
 
 #include "allscale/utils/assert.h"
@@ -18,11 +28,15 @@
 #include "allscale/utils/table.h"
 #include "allscale/utils/array_utils.h"
 #include "allscale/utils/tuple_utils.h"
+#include "allscale/utils/vector.h"
 
 #include "allscale/utils/printer/vectors.h"
 
 #include "allscale/api/core/data.h"
+#include "allscale/api/core/io.h"
 #include "allscale/api/core/prec.h"
+#include "allscale/api/user/algorithm/async.h"
+#include "allscale/api/user/algorithm/pfor.h"
 
 namespace allscale {
 namespace api {
@@ -375,6 +389,42 @@ namespace data {
 
 	};
 
+	/**
+	 * The type used for addressing edges within meshes. Besides its end points, an edge
+	 * is identified by its position within the edges of its kind and level, which is
+	 * dense and may thus be utilized for indexing per-edge data (see Mesh::getNumEdges).
+	 */
+	template<typename EdgeKind,unsigned Level>
+	struct EdgeRef {
+
+		using edge_kind = EdgeKind;
+
+		enum { level = Level };
+
+		NodeRef<typename EdgeKind::src_node_kind,Level> src;
+
+		NodeRef<typename EdgeKind::trg_node_kind,Level> trg;
+
+		std::size_t id;
+
+		NodeRef<typename EdgeKind::src_node_kind,Level> getSource() const {
+			return src;
+		}
+
+		NodeRef<typename EdgeKind::trg_node_kind,Level> getSink() const {
+			return trg;
+		}
+
+		std::size_t getOrdinal() const {
+			return id;
+		}
+
+		friend std::ostream& operator<<(std::ostream& out, const EdgeRef& ref) {
+			return out << "e" << ref.id << "(" << ref.src << "," << ref.trg << ")";
+		}
+
+	};
+
 
 	namespace detail {
 
@@ -431,6 +481,327 @@ namespace data {
 			}
 		}
 
+		/**
+		 * The default number of edges up to which edges are processed sequentially by Mesh::pforAllEdges.
+		 */
+		constexpr std::size_t DEFAULT_EDGE_GRAIN_SIZE = 1 << 12;
+
+		/**
+		 * The number of links of a relation from which on its lookup tables are constructed in parallel.
+		 */
+		constexpr std::size_t PARALLEL_CLOSE_THRESHOLD = 1 << 16;
+
+		/**
+		 * The number of elements processed by a single task while constructing lookup tables in parallel.
+		 */
+		constexpr std::size_t PARALLEL_CLOSE_GRAIN = 1 << 14;
+
+		/**
+		 * Applies the given body to blocks of the index range [0,size) in parallel. Small ranges
+		 * are processed by the calling thread.
+		 */
+		template<typename Body>
+		void forEachBlock(std::size_t size, const Body& body) {
+			std::size_t numBlocks = (size + PARALLEL_CLOSE_GRAIN - 1) / PARALLEL_CLOSE_GRAIN;
+			if (numBlocks <= 1) {
+				body(std::size_t(0),size);
+				return;
+			}
+			algorithm::pfor(std::size_t(0), numBlocks, [&](std::size_t i) {
+				std::size_t begin = i * PARALLEL_CLOSE_GRAIN;
+				body(begin,std::min(size,begin + PARALLEL_CLOSE_GRAIN));
+			});
+		}
+
+		/**
+		 * A parallel version of sumPrefixes, summing up blocks of the given list independently.
+		 */
+		template<typename Element>
+		void parallelSumPrefixes(utils::Table<Element>& list) {
+			std::size_t numBlocks = (list.size() + PARALLEL_CLOSE_GRAIN - 1) / PARALLEL_CLOSE_GRAIN;
+			if (numBlocks <= 1) {
+				sumPrefixes(list);
+				return;
+			}
+
+			// compute the sum of each block
+			std::vector<Element> sums(numBlocks + 1, 0);
+			forEachBlock(list.size(), [&](std::size_t begin, std::size_t end) {
+				Element sum = 0;
+				for(auto i = begin; i < end; ++i) sum += list[i];
+				sums[begin / PARALLEL_CLOSE_GRAIN + 1] = sum;
+			});
+
+			// obtain the offsets of the blocks
+			for(std::size_t i = 0; i < numBlocks; ++i) {
+				sums[i+1] += sums[i];
+			}
+
+			// compute the prefixes within the blocks
+			forEachBlock(list.size(), [&](std::size_t begin, std::size_t end) {
+				Element counter = sums[begin / PARALLEL_CLOSE_GRAIN];
+				for(auto i = begin; i < end; ++i) {
+					auto tmp = list[i];
+					list[i] = counter;
+					counter += tmp;
+				}
+			});
+		}
+
+		/**
+		 * Sorts the rows of the given lookup table in compressed sparse row form in parallel.
+		 */
+		template<typename Offset, typename Element>
+		void sortRows(const utils::Table<Offset>& offsets, utils::Table<Element>& targets) {
+			if (offsets.size() < 2) return;
+			forEachBlock(offsets.size() - 1, [&](std::size_t begin, std::size_t end) {
+				for(auto i = begin; i < end; ++i) {
+					std::sort(targets.begin() + offsets[i], targets.begin() + offsets[i+1]);
+				}
+			});
+		}
+
+		/**
+		 * Determines whether the rows of the given lookup table in compressed sparse row form are sorted.
+		 */
+		template<typename Offset, typename Element>
+		bool hasSortedRows(const utils::Table<Offset>& offsets, const utils::Table<Element>& targets) {
+			for(std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+				for(auto j = offsets[i] + 1; j < offsets[i+1]; ++j) {
+					if (targets[j] < targets[j-1]) return false;
+				}
+			}
+			return true;
+		}
+
+
+		// -- sparse products --
+
+		/**
+		 * The kernel computing the product of a single row of a sparse matrix with a vector of
+		 * values of the given type. For arithmetic types, the row is processed by four independent
+		 * partial sums, such that the compiler may vectorize the loop and overlap the latency of
+		 * indirect loads.
+		 */
+		template<typename V>
+		struct SparseRowKernel {
+
+			/**
+			 * Computes the sum of value(i) * x[cols[i]] for i in [0,n).
+			 */
+			template<typename Value>
+			static V dot(std::size_t n, const Value& value, const NodeID* cols, const V* x) {
+				V s0 = V(), s1 = V(), s2 = V(), s3 = V();
+				std::size_t i = 0;
+				for(; i + 4 <= n; i += 4) {
+					s0 += value(i)   * x[cols[i].id];
+					s1 += value(i+1) * x[cols[i+1].id];
+					s2 += value(i+2) * x[cols[i+2].id];
+					s3 += value(i+3) * x[cols[i+3].id];
+				}
+				for(; i < n; ++i) {
+					s0 += value(i) * x[cols[i].id];
+				}
+				return (s0 + s1) + (s2 + s3);
+			}
+
+			/**
+			 * Adds value * x to the given sum, for rows whose columns are decoded one at a time.
+			 */
+			template<typename T>
+			static void add(V& sum, const T& value, const V& x) {
+				sum += value * x;
+			}
+
+		};
+
+		/**
+		 * The kernel for blocks of vectors, multiplied at once. The loop over the vectors is
+		 * innermost, such that it is vectorized and each matrix entry is loaded only once.
+		 */
+		template<typename V, std::size_t K>
+		struct SparseRowKernel<std::array<V,K>> {
+
+			template<typename Value>
+			static std::array<V,K> dot(std::size_t n, const Value& value, const NodeID* cols, const std::array<V,K>* x) {
+				std::array<V,K> res = std::array<V,K>();
+				for(std::size_t i = 0; i < n; ++i) {
+					auto a = value(i);
+					const auto& cur = x[cols[i].id];
+					for(std::size_t k = 0; k < K; ++k) {
+						res[k] += a * cur[k];
+					}
+				}
+				return res;
+			}
+
+			template<typename T>
+			static void add(std::array<V,K>& sum, const T& value, const std::array<V,K>& x) {
+				for(std::size_t k = 0; k < K; ++k) {
+					sum[k] += value * x[k];
+				}
+			}
+
+		};
+
+
+		// -- compressed rows --
+
+		/**
+		 * Maps signed differences to unsigned values, such that small differences of either sign are small.
+		 */
+		inline std::uint64_t zigZagEncode(std::int64_t value) {
+			return (std::uint64_t(value) << 1) ^ std::uint64_t(value >> 63);
+		}
+
+		inline std::int64_t zigZagDecode(std::uint64_t value) {
+			return std::int64_t(value >> 1) ^ -std::int64_t(value & 1);
+		}
+
+		/**
+		 * The number of bytes required for encoding the given value with 7 bits per byte.
+		 */
+		inline std::size_t getVarIntSize(std::uint64_t value) {
+			std::size_t res = 1;
+			while(value >= 0x80) {
+				value >>= 7;
+				res++;
+			}
+			return res;
+		}
+
+		inline std::uint8_t* writeVarInt(std::uint8_t* pos, std::uint64_t value) {
+			while(value >= 0x80) {
+				*pos++ = std::uint8_t(value | 0x80);
+				value >>= 7;
+			}
+			*pos++ = std::uint8_t(value);
+			return pos;
+		}
+
+		inline const std::uint8_t* readVarInt(const std::uint8_t* pos, std::uint64_t& value) {
+			// fast path for single-byte values
+			if (*pos < 0x80) {
+				value = *pos;
+				return pos + 1;
+			}
+			value = 0;
+			unsigned shift = 0;
+			while(*pos >= 0x80) {
+				value |= std::uint64_t(*pos++ & 0x7f) << shift;
+				shift += 7;
+			}
+			value |= std::uint64_t(*pos++) << shift;
+			return pos;
+		}
+
+		/**
+		 * A compressed lookup table of rows of node indices. The first index of each row is stored
+		 * as its difference to the row index, any further one as its difference to its predecessor,
+		 * both as variable-length integers. Row offsets are stored with 32 bits if they fit.
+		 */
+		class CompressedRows {
+
+			std::vector<std::uint8_t> data;
+
+			std::vector<std::uint32_t> narrowOffsets;
+
+			std::vector<std::uint64_t> wideOffsets;
+
+		public:
+
+			/**
+			 * Encodes the given number of rows in parallel, where row(i,visit) calls visit for
+			 * each index of row i, in order.
+			 */
+			template<typename Row>
+			static CompressedRows encode(std::size_t numRows, const Row& row) {
+
+				// compute the sizes of all rows
+				utils::Table<std::uint64_t> offsets(numRows + 1, 0);
+				forEachBlock(numRows, [&](std::size_t begin, std::size_t end) {
+					for(auto i = begin; i < end; ++i) {
+						std::size_t size = 0;
+						std::int64_t last = std::int64_t(i);
+						row(i, [&](node_index_t cur) {
+							size += getVarIntSize(zigZagEncode(std::int64_t(cur) - last));
+							last = std::int64_t(cur);
+						});
+						offsets[i] = size;
+					}
+				});
+				parallelSumPrefixes(offsets);
+
+				// encode the rows
+				CompressedRows res;
+				res.data.resize(offsets[numRows]);
+				forEachBlock(numRows, [&](std::size_t begin, std::size_t end) {
+					for(auto i = begin; i < end; ++i) {
+						auto pos = res.data.data() + offsets[i];
+						std::int64_t last = std::int64_t(i);
+						row(i, [&](node_index_t cur) {
+							pos = writeVarInt(pos, zigZagEncode(std::int64_t(cur) - last));
+							last = std::int64_t(cur);
+						});
+					}
+				});
+
+				// narrow the offsets if possible
+				if (offsets[numRows] <= std::numeric_limits<std::uint32_t>::max()) {
+					res.narrowOffsets.resize(numRows + 1);
+					forEachBlock(numRows + 1, [&](std::size_t begin, std::size_t end) {
+						for(auto i = begin; i < end; ++i) res.narrowOffsets[i] = std::uint32_t(offsets[i]);
+					});
+				} else {
+					res.wideOffsets.assign(offsets.begin(), offsets.end());
+				}
+				return res;
+			}
+
+			std::size_t getNumRows() const {
+				return (hasNarrowOffsets() ? narrowOffsets.size() : wideOffsets.size()) - 1;
+			}
+
+			bool hasNarrowOffsets() const {
+				return !narrowOffsets.empty();
+			}
+
+			/**
+			 * The number of bytes occupied by this table.
+			 */
+			std::size_t getMemorySize() const {
+				return data.size() + narrowOffsets.size() * sizeof(std::uint32_t) + wideOffsets.size() * sizeof(std::uint64_t);
+			}
+
+			/**
+			 * The position of the encoded data of the given row, where the number of rows addresses
+			 * the end of the data.
+			 */
+			std::size_t getOffset(std::size_t i) const {
+				assert_le(i, getNumRows());
+				return hasNarrowOffsets() ? narrowOffsets[i] : wideOffsets[i];
+			}
+
+			/**
+			 * Counts the values encoded within the given range of positions.
+			 */
+			std::size_t countValues(std::size_t begin, std::size_t end) const {
+				// each encoded value ends with a byte without continuation flag
+				return std::size_t(std::count_if(data.begin() + begin, data.begin() + end, [](std::uint8_t cur) { return cur < 0x80; }));
+			}
+
+			/**
+			 * Obtains the encoded data of the given row.
+			 */
+			std::pair<const std::uint8_t*,const std::uint8_t*> getRow(std::size_t i) const {
+				assert_lt(i, getNumRows());
+				auto base = data.data();
+				if (hasNarrowOffsets()) return { base + narrowOffsets[i], base + narrowOffsets[i+1] };
+				return { base + wideOffsets[i], base + wideOffsets[i+1] };
+			}
+
+		};
+
 
 		template<std::size_t Levels, typename ... NodeKinds>
 		class NodeSet {
@@ -569,6 +940,159 @@ namespace data {
 					};
 				}
 
+				/**
+				 * The total number of edges of this relation.
+				 */
+				std::size_t getNumEdges() const {
+					assert_true(isClosed()) << "Accessing non-closed edge set!";
+					return forward_targets.size();
+				}
+
+				/**
+				 * The index of the first edge starting at the given source, or the number of
+				 * edges if there is no edge starting at the given source or any later one.
+				 */
+				std::size_t getEdgeOffset(NodeID src) const {
+					assert_true(isClosed()) << "Accessing non-closed edge set!";
+					if (src.id >= forward_offsets.size()) return forward_targets.size();
+					return forward_offsets[src.id];
+				}
+
+				/**
+				 * Obtains the edge of the given index.
+				 */
+				template<typename EdgeKind, unsigned Level>
+				EdgeRef<EdgeKind,Level> getEdge(std::size_t index) const {
+					using SrcNodeRef = NodeRef<typename EdgeKind::src_node_kind,Level>;
+					using TrgNodeRef = NodeRef<typename EdgeKind::trg_node_kind,Level>;
+					assert_lt(index,getNumEdges());
+					// locate the last source with an offset not exceeding the index
+					auto src = std::upper_bound(forward_offsets.begin(),forward_offsets.end(),uint64_t(index)) - forward_offsets.begin() - 1;
+					return { SrcNodeRef(node_index_t(src)), TrgNodeRef(forward_targets[index]), index };
+				}
+
+				/**
+				 * Visits all edges starting at sources within the given range, in the order of their index.
+				 */
+				template<typename EdgeKind, unsigned Level, typename Body>
+				void forAllEdges(node_index_t begin, node_index_t end, const Body& body) const {
+					using SrcNodeRef = NodeRef<typename EdgeKind::src_node_kind,Level>;
+					using TrgNodeRef = NodeRef<typename EdgeKind::trg_node_kind,Level>;
+					assert_true(isClosed()) << "Accessing non-closed edge set!";
+					end = std::min<node_index_t>(end,forward_offsets.empty() ? 0 : forward_offsets.size() - 1);
+					for(node_index_t src = begin; src < end; ++src) {
+						for(auto i = forward_offsets[src]; i < forward_offsets[src+1]; ++i) {
+							body(EdgeRef<EdgeKind,Level>{ SrcNodeRef(src), TrgNodeRef(forward_targets[i]), std::size_t(i) });
+						}
+					}
+				}
+
+				/**
+				 * Visits the source and target of all edges, in the order they have been added to an
+				 * open relation or in the order of their index within a closed one.
+				 */
+				template<typename Body>
+				void forAllLinks(const Body& body) const {
+					if (!isClosed()) {
+						for(const auto& cur : edges) {
+							body(cur.first.id,cur.second.id);
+						}
+						return;
+					}
+					for(std::size_t src = 0; src + 1 < forward_offsets.size(); ++src) {
+						for(auto i = forward_offsets[src]; i < forward_offsets[src+1]; ++i) {
+							body(node_index_t(src),forward_targets[i].id);
+						}
+					}
+				}
+
+				/**
+				 * The position of the first source of the given target within the backward lookup table,
+				 * or the number of edges if there is no edge ending at the given target or any later one.
+				 */
+				std::size_t getReverseOffset(NodeID trg) const {
+					assert_true(isClosed()) << "Accessing non-closed edge set!";
+					if (trg.id >= backward_offsets.size()) return backward_targets.size();
+					return backward_offsets[trg.id];
+				}
+
+				/**
+				 * Obtains, for each position within the backward lookup table, the index of the edge
+				 * connecting the source listed at this position with the corresponding target.
+				 */
+				std::vector<std::size_t> getTransposedEdgeOrder() const {
+					assert_true(isClosed()) << "Accessing non-closed edge set!";
+					std::vector<std::size_t> res(getNumEdges());
+					if (res.empty()) return res;
+
+					// distribute the edges among their targets, in the order of their sources
+					auto pos = backward_offsets;
+					for(std::size_t src = 0; src + 1 < forward_offsets.size(); ++src) {
+						for(auto i = forward_offsets[src]; i < forward_offsets[src+1]; ++i) {
+							res[pos[forward_targets[i]]++] = i;
+						}
+					}
+
+					// align them with the order of the sources listed by unsorted rows
+					if (hasSortedRows(backward_offsets,backward_targets)) return res;
+					forEachBlock(backward_offsets.size() - 1, [&](std::size_t begin, std::size_t end) {
+						std::vector<std::size_t> order;
+						std::vector<std::size_t> edges;
+						for(auto trg = begin; trg < end; ++trg) {
+							auto first = backward_offsets[trg];
+							auto last = backward_offsets[trg+1];
+							order.resize(last - first);
+							std::iota(order.begin(),order.end(),first);
+							std::stable_sort(order.begin(),order.end(),[&](std::size_t a, std::size_t b) {
+								return backward_targets[a] < backward_targets[b];
+							});
+							edges.assign(res.begin() + first,res.begin() + last);
+							for(std::size_t k = 0; k < order.size(); ++k) {
+								res[order[k]] = edges[k];
+							}
+						}
+					});
+					return res;
+				}
+
+				/**
+				 * Computes y[src] = sum of values[e] * x[trg(e)] over all edges e starting at src, for
+				 * each source within the given range.
+				 */
+				template<typename T, typename V>
+				void multiply(node_index_t begin, node_index_t end, const T* values, const V* x, V* y) const {
+					assert_true(isClosed()) << "Accessing non-closed edge set!";
+					node_index_t numRows = forward_offsets.empty() ? 0 : forward_offsets.size() - 1;
+					for(node_index_t src = begin; src < end; ++src) {
+						if (src >= numRows) {
+							y[src] = V();
+							continue;
+						}
+						auto first = forward_offsets[src];
+						const T* row = values + first;
+						y[src] = SparseRowKernel<V>::dot(forward_offsets[src+1] - first,[row](std::size_t i) { return row[i]; },&forward_targets[first],x);
+					}
+				}
+
+				/**
+				 * Computes y[trg] = sum of values[e] * x[src(e)] over all edges e ending at trg, for each
+				 * target within the given range, where the given order is the transposed edge order.
+				 */
+				template<typename T, typename V>
+				void multiplyTransposed(node_index_t begin, node_index_t end, const T* values, const std::size_t* order, const V* x, V* y) const {
+					assert_true(isClosed()) << "Accessing non-closed edge set!";
+					node_index_t numRows = backward_offsets.empty() ? 0 : backward_offsets.size() - 1;
+					for(node_index_t trg = begin; trg < end; ++trg) {
+						if (trg >= numRows) {
+							y[trg] = V();
+							continue;
+						}
+						auto first = backward_offsets[trg];
+						const std::size_t* row = order + first;
+						y[trg] = SparseRowKernel<V>::dot(backward_offsets[trg+1] - first,[values,row](std::size_t i) { return values[row[i]]; },&backward_targets[first],x);
+					}
+				}
+
 				void addEdge(NodeID from, NodeID to) {
 					edges.push_back({from,to});
 				}
@@ -577,44 +1101,53 @@ namespace data {
 					return edges.empty();
 				}
 
-				void close() {
+				/**
+				 * Builds the lookup tables of this relation from the edges added so far. Large relations
+				 * are processed in parallel. Optionally, the targets of each row get sorted by their index,
+				 * otherwise they are listed in the order they have been added.
+				 */
+				void close(bool sortTargets = false) {
 
-					// get maximum source and target
-					std::size_t maxSourceID = 0;
-					std::size_t maxTargetID = 0;
-					for(const auto& cur : edges) {
-						maxSourceID = std::max<std::size_t>(maxSourceID,cur.first);
-						maxTargetID = std::max<std::size_t>(maxTargetID,cur.second);
+					if (edges.size() < PARALLEL_CLOSE_THRESHOLD) {
+						buildTables();
+					} else {
+						buildTablesInParallel();
 					}
 
-					// init forward / backward vectors
-					forward_offsets = utils::Table<uint64_t>(maxSourceID + 2, 0);
-					forward_targets = utils::Table<NodeID>(edges.size());
-
-					backward_offsets = utils::Table<uint64_t>(maxTargetID + 2,0);
-					backward_targets = utils::Table<NodeID>(edges.size());
+					// release edges
+					std::vector<std::pair<NodeID,NodeID>>().swap(edges);
 
-					// count number of sources / sinks
-					for(const auto& cur : edges) {
-						++forward_offsets[cur.first];
-						++backward_offsets[cur.second];
+					// sort targets if requested
+					if (sortTargets) {
+						sortRows(forward_offsets,forward_targets);
+						sortRows(backward_offsets,backward_targets);
 					}
+				}
 
-					// compute prefix sums
-					sumPrefixes(forward_offsets);
-					sumPrefixes(backward_offsets);
+				void permute(const std::vector<node_index_t>& sourceMap, const std::vector<node_index_t>& targetMap) {
 
-					// fill in targets
-					auto forward_pos = forward_offsets;
-					auto backward_pos = backward_offsets;
-					for(const auto& cur : edges) {
-						forward_targets[forward_pos[cur.first]++] = cur.second;
-						backward_targets[backward_pos[cur.second]++] = cur.first;
-					}
+					// an empty map is the identity
+					auto map = [](const std::vector<node_index_t>& map, node_index_t id) {
+						return NodeID(map.empty() ? id : map[id]);
+					};
 
-					// clear edges
-					edges.clear();
+					// edges of open relations are updated in place
+					if (!isClosed()) {
+						for(auto& cur : edges) {
+							cur = { map(sourceMap,cur.first), map(targetMap,cur.second) };
+						}
+						return;
+					}
 
+					// re-create the edge list with updated IDs and rebuild the lookup tables, keeping rows sorted
+					bool sorted = hasSortedRows(forward_offsets,forward_targets) && hasSortedRows(backward_offsets,backward_targets);
+					edges.reserve(forward_targets.size());
+					for(std::size_t src = 0; src + 1 < forward_offsets.size(); ++src) {
+						for(auto i = forward_offsets[src]; i < forward_offsets[src+1]; ++i) {
+							edges.push_back({ map(sourceMap,src), map(targetMap,forward_targets[i]) });
+						}
+					}
+					close(sorted);
 				}
 
 				void store(std::ostream& out) const {
@@ -661,22 +1194,161 @@ namespace data {
 					return res;
 				}
 
-			};
-
-			using LevelData = utils::StaticMap<utils::keys<EdgeKinds...>,Relation>;
-
-			using EdgeData = std::array<LevelData,Levels>;
+			private:
 
-			EdgeData data;
+				void buildTables() {
 
-		public:
+					// get maximum source and target
+					std::size_t maxSourceID = 0;
+					std::size_t maxTargetID = 0;
+					for(const auto& cur : edges) {
+						maxSourceID = std::max<std::size_t>(maxSourceID,cur.first);
+						maxTargetID = std::max<std::size_t>(maxTargetID,cur.second);
+					}
 
-			EdgeSet() = default;
-			EdgeSet(const EdgeSet&) = default;
-			EdgeSet(EdgeSet&& other) = default;
+					// init forward / backward vectors
+					forward_offsets = utils::Table<uint64_t>(maxSourceID + 2, 0);
+					forward_targets = utils::Table<NodeID>(edges.size());
 
-			EdgeSet& operator=(const EdgeSet&) = delete;
-			EdgeSet& operator=(EdgeSet&&) = default;
+					backward_offsets = utils::Table<uint64_t>(maxTargetID + 2,0);
+					backward_targets = utils::Table<NodeID>(edges.size());
+
+					// count number of sources / sinks
+					for(const auto& cur : edges) {
+						++forward_offsets[cur.first];
+						++backward_offsets[cur.second];
+					}
+
+					// compute prefix sums
+					sumPrefixes(forward_offsets);
+					sumPrefixes(backward_offsets);
+
+					// fill in targets
+					auto forward_pos = forward_offsets;
+					auto backward_pos = backward_offsets;
+					for(const auto& cur : edges) {
+						forward_targets[forward_pos[cur.first]++] = cur.second;
+						backward_targets[backward_pos[cur.second]++] = cur.first;
+					}
+				}
+
+				void buildTablesInParallel() {
+
+					// get maximum source and target, block by block
+					std::vector<std::pair<std::size_t,std::size_t>> maxima((edges.size() + PARALLEL_CLOSE_GRAIN - 1) / PARALLEL_CLOSE_GRAIN, { 0, 0 });
+					forEachBlock(edges.size(), [&](std::size_t begin, std::size_t end) {
+						auto& res = maxima[begin / PARALLEL_CLOSE_GRAIN];
+						for(auto i = begin; i < end; ++i) {
+							res.first = std::max<std::size_t>(res.first,edges[i].first);
+							res.second = std::max<std::size_t>(res.second,edges[i].second);
+						}
+					});
+					std::size_t maxSourceID = 0;
+					std::size_t maxTargetID = 0;
+					for(const auto& cur : maxima) {
+						maxSourceID = std::max(maxSourceID,cur.first);
+						maxTargetID = std::max(maxTargetID,cur.second);
+					}
+
+					// build forward and backward tables
+					buildTableInParallel(maxSourceID + 1, false, forward_offsets, forward_targets);
+					buildTableInParallel(maxTargetID + 1, true, backward_offsets, backward_targets);
+				}
+
+				/**
+				 * Builds a lookup table listing the targets of each row in the order edges have been added,
+				 * equal to the one obtained by buildTables. Edges are first distributed among blocks of rows
+				 * by a stable parallel counting sort, such that blocks can be processed independently afterwards.
+				 */
+				void buildTableInParallel(std::size_t numRows, bool backward, utils::Table<uint64_t>& offsets, utils::Table<NodeID>& targets) const {
+					const std::size_t numEdges = edges.size();
+					const std::size_t maxChunks = 256;
+					auto getRow = [&](const std::pair<NodeID,NodeID>& edge) -> std::size_t {
+						return backward ? edge.second : edge.first;
+					};
+
+					// edges are processed in chunks, rows in blocks
+					const std::size_t chunkSize = std::max(PARALLEL_CLOSE_GRAIN, (numEdges + maxChunks - 1) / maxChunks);
+					const std::size_t numChunks = (numEdges + chunkSize - 1) / chunkSize;
+					const std::size_t numBlocks = (numRows + PARALLEL_CLOSE_GRAIN - 1) / PARALLEL_CLOSE_GRAIN;
+
+					// count the edges of each chunk targeting each block
+					std::vector<std::size_t> counts(numChunks * numBlocks, 0);
+					algorithm::pfor(std::size_t(0), numChunks, [&](std::size_t c) {
+						auto local = &counts[c * numBlocks];
+						for(auto i = c * chunkSize; i < std::min(numEdges, (c + 1) * chunkSize); ++i) {
+							local[getRow(edges[i]) / PARALLEL_CLOSE_GRAIN]++;
+						}
+					});
+
+					// compute the positions of the edges of each chunk within the blocks
+					std::vector<std::size_t> blockBegins(numBlocks + 1);
+					std::size_t sum = 0;
+					for(std::size_t b = 0; b < numBlocks; ++b) {
+						blockBegins[b] = sum;
+						for(std::size_t c = 0; c < numChunks; ++c) {
+							auto tmp = counts[c * numBlocks + b];
+							counts[c * numBlocks + b] = sum;
+							sum += tmp;
+						}
+					}
+					blockBegins[numBlocks] = sum;
+
+					// distribute (row,target) pairs among blocks
+					std::vector<std::pair<NodeID,NodeID>> buffer(numEdges);
+					algorithm::pfor(std::size_t(0), numChunks, [&](std::size_t c) {
+						auto local = &counts[c * numBlocks];
+						for(auto i = c * chunkSize; i < std::min(numEdges, (c + 1) * chunkSize); ++i) {
+							const auto& edge = edges[i];
+							buffer[local[getRow(edge) / PARALLEL_CLOSE_GRAIN]++] = backward ? std::make_pair(edge.second,edge.first) : edge;
+						}
+					});
+
+					// sort the edges of each block by their row
+					offsets = utils::Table<uint64_t>(numRows + 1);
+					targets = utils::Table<NodeID>(numEdges);
+					algorithm::pfor(std::size_t(0), numBlocks, [&](std::size_t b) {
+						auto rowBegin = b * PARALLEL_CLOSE_GRAIN;
+						auto rowEnd = std::min(numRows, rowBegin + PARALLEL_CLOSE_GRAIN);
+
+						// count the targets of each row
+						for(auto r = rowBegin; r < rowEnd; ++r) offsets[r] = 0;
+						for(auto i = blockBegins[b]; i < blockBegins[b+1]; ++i) {
+							offsets[buffer[i].first]++;
+						}
+
+						// compute the offsets of the rows
+						uint64_t counter = blockBegins[b];
+						for(auto r = rowBegin; r < rowEnd; ++r) {
+							auto tmp = offsets[r];
+							offsets[r] = counter;
+							counter += tmp;
+						}
+
+						// fill in targets
+						std::vector<uint64_t> pos(offsets.begin() + rowBegin, offsets.begin() + rowEnd);
+						for(auto i = blockBegins[b]; i < blockBegins[b+1]; ++i) {
+							targets[pos[buffer[i].first - rowBegin]++] = buffer[i].second;
+						}
+					});
+					offsets[numRows] = numEdges;
+				}
+			};
+
+			using LevelData = utils::StaticMap<utils::keys<EdgeKinds...>,Relation>;
+
+			using EdgeData = std::array<LevelData,Levels>;
+
+			EdgeData data;
+
+		public:
+
+			EdgeSet() = default;
+			EdgeSet(const EdgeSet&) = default;
+			EdgeSet(EdgeSet&& other) = default;
+
+			EdgeSet& operator=(const EdgeSet&) = delete;
+			EdgeSet& operator=(EdgeSet&&) = default;
 
 
 			template<typename EdgeKind, unsigned Level>
@@ -684,14 +1356,23 @@ namespace data {
 				getEdgeRelation<EdgeKind,Level>().addEdge(src,trg);
 			}
 
-			void close() {
-				// for all levels
+			template<typename EdgeKind, unsigned Level>
+			void permute(const std::vector<node_index_t>& sourceMap, const std::vector<node_index_t>& targetMap) {
+				getEdgeRelation<EdgeKind,Level>().permute(sourceMap,targetMap);
+			}
+
+			void close(bool sortTargets = false) {
+				// collect the relations of all levels and edge kinds
+				std::vector<Relation*> relations;
 				for(auto& level : data) {
-					// for all edge kinds
 					for(auto& rel : level) {
-						rel.close();
+						relations.push_back(&rel);
 					}
 				}
+				// and close them concurrently
+				algorithm::pfor(std::size_t(0), relations.size(), [&](std::size_t i) {
+					relations[i]->close(sortTargets);
+				});
 			}
 
 			bool isClosed() const {
@@ -717,6 +1398,51 @@ namespace data {
 				return getEdgeRelation<EdgeKind,Level>().template getSources<EdgeKind>(src);
 			}
 
+			template<typename EdgeKind, unsigned Level>
+			std::size_t getNumEdges() const {
+				return getEdgeRelation<EdgeKind,Level>().getNumEdges();
+			}
+
+			template<typename EdgeKind, unsigned Level>
+			std::size_t getEdgeOffset(const NodeRef<typename EdgeKind::src_node_kind,Level>& src) const {
+				return getEdgeRelation<EdgeKind,Level>().getEdgeOffset(src);
+			}
+
+			template<typename EdgeKind, unsigned Level>
+			EdgeRef<EdgeKind,Level> getEdge(std::size_t index) const {
+				return getEdgeRelation<EdgeKind,Level>().template getEdge<EdgeKind,Level>(index);
+			}
+
+			template<typename EdgeKind, unsigned Level, typename Body>
+			void forAllEdges(node_index_t begin, node_index_t end, const Body& body) const {
+				getEdgeRelation<EdgeKind,Level>().template forAllEdges<EdgeKind,Level>(begin,end,body);
+			}
+
+			template<typename EdgeKind, unsigned Level, typename Body>
+			void forAllLinks(const Body& body) const {
+				getEdgeRelation<EdgeKind,Level>().forAllLinks(body);
+			}
+
+			template<typename EdgeKind, unsigned Level>
+			std::size_t getReverseOffset(const NodeRef<typename EdgeKind::trg_node_kind,Level>& trg) const {
+				return getEdgeRelation<EdgeKind,Level>().getReverseOffset(trg);
+			}
+
+			template<typename EdgeKind, unsigned Level>
+			std::vector<std::size_t> getTransposedEdgeOrder() const {
+				return getEdgeRelation<EdgeKind,Level>().getTransposedEdgeOrder();
+			}
+
+			template<typename EdgeKind, unsigned Level, typename T, typename V>
+			void multiply(node_index_t begin, node_index_t end, const T* values, const V* x, V* y) const {
+				getEdgeRelation<EdgeKind,Level>().multiply(begin,end,values,x,y);
+			}
+
+			template<typename EdgeKind, unsigned Level, typename T, typename V>
+			void multiplyTransposed(node_index_t begin, node_index_t end, const T* values, const std::size_t* order, const V* x, V* y) const {
+				getEdgeRelation<EdgeKind,Level>().multiplyTransposed(begin,end,values,order,x,y);
+			}
+
 			// -- IO support --
 
 			void store(std::ostream& out) const {
@@ -828,56 +1554,80 @@ namespace data {
 					return children.empty();
 				}
 
-				void close() {
-					// a constant for an unknown parent
-					static const NodeID unknownParent(std::numeric_limits<node_index_t>::max());
-
-					// get maximum index of parents
-					std::size_t maxParent = 0;
-					for(const auto& cur : parents) {
-						maxParent = std::max<std::size_t>(maxParent,cur);
-					}
-
-					// compute total number of parent-child links
-					std::size_t numParentChildLinks = 0;
-					for(const auto& cur : children) {
-						numParentChildLinks += cur.size();
-					}
+				/**
+				 * Builds the lookup tables of this relation from the links added so far, processing large
+				 * relations in parallel. Optionally, the children of each parent get sorted by their index.
+				 */
+				void close(bool sortChildren = false) {
 
-					// init forward / backward vectors
-					children_offsets = utils::Table<std::size_t>(maxParent + 2, 0);
-					children_targets = utils::Table<NodeID>(numParentChildLinks);
+					// the index of the last parent
+					std::size_t maxParent = children.empty() ? 0 : children.size() - 1;
 
 					// init child offsets
-					std::size_t idx = 0;
-					std::size_t offset = 0;
-					for(const auto& cur : children) {
-						children_offsets[idx] = offset;
-						offset += cur.size();
-						idx++;
-						if (idx > maxParent) break;
-					}
-					children_offsets[idx] = offset;
+					children_offsets = utils::Table<std::size_t>(maxParent + 2);
+					forEachBlock(children_offsets.size(), [&](std::size_t begin, std::size_t end) {
+						for(auto i = begin; i < end; ++i) {
+							children_offsets[i] = (i < children.size()) ? children[i].size() : 0;
+						}
+					});
+					parallelSumPrefixes(children_offsets);
 
 					// fill in targets
-					idx = 0;
-					for(const auto& cur : children) {
-						for(const auto& child : cur) {
-							children_targets[idx++] = child;
+					children_targets = utils::Table<NodeID>(children_offsets[maxParent + 1]);
+					forEachBlock(children.size(), [&](std::size_t begin, std::size_t end) {
+						for(auto i = begin; i < end; ++i) {
+							std::copy(children[i].begin(), children[i].end(), children_targets.begin() + children_offsets[i]);
 						}
-					}
+					});
 
 					// clear edges
 					children.clear();
 
 					// init parent target table
 					parent_targets = utils::Table<NodeID>(parents.size());
-					for(std::size_t i=0; i<parent_targets.size(); ++i) {
-						parent_targets[i] = (i < parents.size()) ? parents[i] : unknownParent;
-					}
+					forEachBlock(parents.size(), [&](std::size_t begin, std::size_t end) {
+						std::copy(parents.begin() + begin, parents.begin() + end, parent_targets.begin() + begin);
+					});
 
 					// clear parents list
 					parents.clear();
+
+					// sort children if requested
+					if (sortChildren) {
+						sortRows(children_offsets,children_targets);
+					}
+				}
+
+				void permute(const std::vector<node_index_t>& parentMap, const std::vector<node_index_t>& childMap) {
+
+					// an empty map is the identity
+					auto map = [](const std::vector<node_index_t>& map, node_index_t id) {
+						return NodeID(map.empty() ? id : map[id]);
+					};
+
+					// links of open relations are re-registered
+					if (!isClosed()) {
+						auto links = std::move(children);
+						children.clear();
+						parents.clear();
+						for(std::size_t parent = 0; parent < links.size(); ++parent) {
+							for(const auto& child : links[parent]) {
+								addChild(map(parentMap,parent), map(childMap,child));
+							}
+						}
+						return;
+					}
+
+					// re-create the parent-child links with updated IDs and rebuild the lookup tables, keeping children sorted
+					bool sorted = hasSortedRows(children_offsets,children_targets);
+					auto offsets = std::move(children_offsets);
+					auto targets = std::move(children_targets);
+					for(std::size_t parent = 0; parent + 1 < offsets.size(); ++parent) {
+						for(auto i = offsets[parent]; i < offsets[parent+1]; ++i) {
+							addChild(map(parentMap,parent), map(childMap,targets[i]));
+						}
+					}
+					close(sorted);
 				}
 
 
@@ -958,12 +1708,23 @@ namespace data {
 				getRelation<HierarchyKind,Level-1>().addChild(parent,child);
 			}
 
-			void close() {
+			template<typename HierarchyKind, unsigned Level>
+			void permute(const std::vector<node_index_t>& parentMap, const std::vector<node_index_t>& childMap) {
+				getRelation<HierarchyKind,Level-1>().permute(parentMap,childMap);
+			}
+
+			void close(bool sortChildren = false) {
+				// collect the relations of all levels and hierarchy kinds
+				std::vector<Relation*> relations;
 				for(auto& level : data) {
 					for(auto& rel : level) {
-						rel.close();
+						relations.push_back(&rel);
 					}
 				}
+				// and close them concurrently
+				algorithm::pfor(std::size_t(0), relations.size(), [&](std::size_t i) {
+					relations[i]->close(sortChildren);
+				});
 			}
 
 			bool isClosed() const {
@@ -1108,6 +1869,113 @@ namespace data {
 		};
 
 
+		// -- node permutations --
+
+		template<
+			typename Nodes,
+			unsigned Levels
+		>
+		class MeshPermutation;
+
+		/**
+		 * A permutation of the nodes of a mesh, mapping the index each node of each kind and level
+		 * had when being created to its final position within the mesh. It is produced by re-ordering
+		 * mesh builders and may be utilized to re-map data associated to nodes by the user.
+		 */
+		template<
+			typename ... Nodes,
+			unsigned Levels
+		>
+		class MeshPermutation<nodes<Nodes...>,Levels> {
+
+			// the new index of each node, an empty list representing the identity
+			using LevelData = utils::StaticMap<utils::keys<Nodes...>,std::vector<node_index_t>>;
+
+			std::array<LevelData,Levels> data;
+
+		public:
+
+			template<typename Kind, unsigned Level = 0>
+			bool isIdentity() const {
+				return getMapping<Kind,Level>().empty();
+			}
+
+			/**
+			 * Obtains the new index of each node of the given kind and level, or an empty
+			 * list if the nodes have not been re-ordered.
+			 */
+			template<typename Kind, unsigned Level = 0>
+			const std::vector<node_index_t>& getMapping() const {
+				return data[Level].template get<Kind>();
+			}
+
+			template<typename Kind, unsigned Level = 0>
+			void setMapping(std::vector<node_index_t> mapping) {
+				assert_true(isPermutation(mapping)) << "Invalid node permutation!";
+				data[Level].template get<Kind>() = std::move(mapping);
+			}
+
+			/**
+			 * Obtains the new reference of the given node.
+			 */
+			template<typename Kind, unsigned Level>
+			NodeRef<Kind,Level> operator()(const NodeRef<Kind,Level>& node) const {
+				const auto& mapping = getMapping<Kind,Level>();
+				if (mapping.empty()) return node;
+				assert_lt(node.id,mapping.size());
+				return NodeRef<Kind,Level>(mapping[node.id]);
+			}
+
+			/**
+			 * Moves values indexed by the original node indices to the new positions of their nodes.
+			 */
+			template<typename Kind, unsigned Level = 0, typename T>
+			std::vector<T> apply(const std::vector<T>& values) const {
+				const auto& mapping = getMapping<Kind,Level>();
+				if (mapping.empty()) return values;
+				assert_eq(mapping.size(),values.size());
+				std::vector<T> res(values.size());
+				for(std::size_t i = 0; i < values.size(); ++i) {
+					res[mapping[i]] = values[i];
+				}
+				return res;
+			}
+
+			/**
+			 * Extends this permutation by the given one, being applied subsequently.
+			 */
+			void append(const MeshPermutation& next) {
+				LevelEnumerator<Levels-1>()([&](const auto& level) {
+					using lvl = get_level<decltype(level)>;
+					KindEnumerator<Nodes...>()([&](const auto& kind) {
+						using Kind = plain_type<decltype(kind)>;
+						const auto& b = next.template getMapping<Kind,lvl::value>();
+						if (b.empty()) return;
+						auto& a = data[lvl::value].template get<Kind>();
+						if (a.empty()) {
+							a = b;
+							return;
+						}
+						assert_eq(a.size(),b.size());
+						for(auto& cur : a) cur = node_index_t(b[cur]);
+					});
+				});
+			}
+
+		private:
+
+			static bool isPermutation(const std::vector<node_index_t>& mapping) {
+				std::vector<bool> covered(mapping.size(),false);
+				for(const auto& cur : mapping) {
+					if (cur >= mapping.size() || covered[cur]) return false;
+					covered[cur] = true;
+				}
+				return true;
+			}
+
+		};
+
+
 		// -- mesh topology store --
 
 		template<
@@ -1179,15 +2047,46 @@ namespace data {
 				return nodeSets.template getNumNodes<Kind,Level>();
 			}
 
-			void close() {
-				edgeSets.close();
-				hierarchySets.close();
+			/**
+			 * Builds the lookup tables of all relations, closing edges and hierarchies concurrently.
+			 * Optionally, the targets of edges and the children of hierarchies get sorted by their index.
+			 */
+			void close(bool sortLinks = false) {
+				auto edgesClosed = algorithm::async([&]() {
+					edgeSets.close(sortLinks);
+				});
+				hierarchySets.close(sortLinks);
+				edgesClosed.wait();
 			}
 
 			bool isClosed() const {
 				return edgeSets.isClosed() && hierarchySets.isClosed();
 			}
 
+			/**
+			 * Re-orders the nodes of this topology according to the given permutation.
+			 */
+			void permute(const MeshPermutation<nodes<Nodes...>,Levels>& permutation) {
+
+				forAllEdgeKinds([&](const auto& edgeKind, const auto& level) {
+					using EdgeKind = plain_type<decltype(edgeKind)>;
+					using lvl = get_level<decltype(level)>;
+					edgeSets.template permute<EdgeKind,lvl::value>(
+						permutation.template getMapping<typename EdgeKind::src_node_kind,lvl::value>(),
+						permutation.template getMapping<typename EdgeKind::trg_node_kind,lvl::value>()
+					);
+				});
+
+				forAllHierarchyKinds([&](const auto& hierarchyKind, const auto& level) {
+					using HierarchyKind = plain_type<decltype(hierarchyKind)>;
+					using lvl = get_level<decltype(level)>;
+					hierarchySets.template permute<HierarchyKind,lvl::value>(
+						permutation.template getMapping<typename HierarchyKind::parent_node_kind,lvl::value>(),
+						permutation.template getMapping<typename HierarchyKind::child_node_kind,lvl::value-1>()
+					);
+				});
+			}
+
 			// -- IO support --
 
 			void store(std::ostream& out) const {
@@ -1560,6 +2459,23 @@ namespace data {
 				return res;
 			}
 
+			/**
+			 * An operator to store an instance of this reference into the given archive.
+			 */
+			void store(utils::ArchiveWriter& writer) const {
+				writer.write(super::path);
+				writer.write(super::mask);
+			}
+
+			/**
+			 * An operator to load an instance of this reference from the given archive.
+			 */
+			static SubMeshRef load(utils::ArchiveReader& reader) {
+				auto path = reader.read<value_t>();
+				auto mask = reader.read<value_t>();
+				return SubMeshRef(path,mask);
+			}
+
 			SubTreeRef getEnclosingSubTree() const {
 				return SubTreeRef(
 					super::path,
@@ -1757,17 +2673,25 @@ namespace data {
 			/**
 			 * An operator to load an instance of this region from the given archive.
 			 */
-			static MeshRegion load(utils::ArchiveReader&) {
-				assert_not_implemented();
-				return MeshRegion();
+			static MeshRegion load(utils::ArchiveReader& reader) {
+				MeshRegion res;
+				auto size = reader.read<std::size_t>();
+				res.refs.reserve(size);
+				for(std::size_t i=0; i<size; i++) {
+					res.refs.push_back(reader.read<SubMeshRef>());
+				}
+				// references have been stored in normalized form
+				return res;
 			}
 
 			/**
 			 * An operator to store an instance of this region into the given archive.
 			 */
-			void store(utils::ArchiveWriter&) const {
-				assert_not_implemented();
-				// nothing so far
+			void store(utils::ArchiveWriter& writer) const {
+				writer.write(refs.size());
+				for(const auto& cur : refs) {
+					writer.write(cur);
+				}
 			}
 
 			template<typename Body>
@@ -2363,45 +3287,1115 @@ namespace data {
 		};
 
 
-		template<
-			typename NodeKind,
-			typename ElementType,
-			unsigned Level,
-			typename PartitionTree
-		>
-		class MeshDataFragment {
-		public:
+		// -- node orderings --
 
-			using facade_type = MeshData<NodeKind,ElementType,Level,PartitionTree>;
-			using region_type = MeshRegion;
-			using shared_data_type = PartitionTree;
+		/**
+		 * The undirected graph formed by the nodes of all kinds and the edges of all kinds on a single
+		 * level of a mesh. Nodes are enumerated kind by kind, in the order of their indices.
+		 */
+		struct MeshGraph {
 
-		private:
+			// the index of the first node of each kind
+			std::vector<std::size_t> kindOffsets;
 
-			using partition_tree_type = PartitionTree;
+			// the neighbours of all nodes in compressed sparse row form
+			std::vector<std::size_t> offsets;
+			std::vector<std::size_t> neighbours;
 
-			const partition_tree_type& partitionTree;
+			std::size_t getNumNodes() const {
+				return kindOffsets.back();
+			}
 
-			region_type coveredRegion;
+			std::size_t getKind(std::size_t node) const {
+				return std::upper_bound(kindOffsets.begin(),kindOffsets.end(),node) - kindOffsets.begin() - 1;
+			}
 
-			std::vector<ElementType> data;
+			std::size_t getDegree(std::size_t node) const {
+				return offsets[node+1] - offsets[node];
+			}
+		};
 
-			friend facade_type;
+		/**
+		 * Extracts the graph of the given level of a mesh topology, which may be open or closed.
+		 */
+		template<unsigned Level, typename ... Nodes, typename ... Edges, typename ... Hierarchies, unsigned Levels>
+		MeshGraph buildMeshGraph(const MeshTopologyData<nodes<Nodes...>,edges<Edges...>,hierarchies<Hierarchies...>,Levels>& data) {
+			using node_list = utils::type_list<Nodes...>;
+			MeshGraph res;
+
+			// enumerate the nodes of all kinds
+			res.kindOffsets.push_back(0);
+			KindEnumerator<Nodes...>()([&](const auto& nodeKind) {
+				using NodeKind = plain_type<decltype(nodeKind)>;
+				res.kindOffsets.push_back(res.kindOffsets.back() + data.template getNumNodes<NodeKind,Level>());
+			});
+
+			// a utility to visit all edges of this level
+			auto forAllEdges = [&](const auto& body) {
+				KindEnumerator<Edges...>()([&](const auto& edgeKind) {
+					using EdgeKind = plain_type<decltype(edgeKind)>;
+					using SrcKind = typename EdgeKind::src_node_kind;
+					using TrgKind = typename EdgeKind::trg_node_kind;
+					auto srcOffset = res.kindOffsets[utils::type_index<SrcKind,node_list>::value];
+					auto trgOffset = res.kindOffsets[utils::type_index<TrgKind,node_list>::value];
+					data.edgeSets.template forAllLinks<EdgeKind,Level>([&](node_index_t src, node_index_t trg) {
+						body(srcOffset + src, trgOffset + trg);
+					});
+				});
+			};
 
-		public:
+			// edges are considered undirected
+			res.offsets.assign(res.getNumNodes() + 1, 0);
+			forAllEdges([&](std::size_t a, std::size_t b) {
+				res.offsets[a+1]++;
+				res.offsets[b+1]++;
+			});
+			for(std::size_t i = 0; i < res.getNumNodes(); ++i) {
+				res.offsets[i+1] += res.offsets[i];
+			}
+			res.neighbours.resize(res.offsets.back());
+			auto pos = res.offsets;
+			forAllEdges([&](std::size_t a, std::size_t b) {
+				res.neighbours[pos[a]++] = b;
+				res.neighbours[pos[b]++] = a;
+			});
+			return res;
+		}
 
-			MeshDataFragment() = delete;
+		/**
+		 * Orders the nodes of the given graph according to the reverse Cuthill-McKee algorithm, such
+		 * that the indices of neighbouring nodes are close to each other. Each connected component is
+		 * traversed breadth first, starting from a pseudo-peripheral node and visiting the neighbours of
+		 * each node in the order of increasing degree. The result lists the nodes in their new order.
+		 */
+		inline std::vector<std::size_t> getReverseCuthillMcKeeOrder(const MeshGraph& graph) {
+			const auto numNodes = graph.getNumNodes();
+			auto byDegree = [&](std::size_t a, std::size_t b) {
+				return graph.getDegree(a) < graph.getDegree(b);
+			};
 
-			MeshDataFragment(const partition_tree_type& ptree, const region_type& region)
-				: partitionTree(ptree), coveredRegion(region) {
+			// components are started from nodes of low degree
+			std::vector<std::size_t> roots(numNodes);
+			for(std::size_t i = 0; i < numNodes; ++i) roots[i] = i;
+			std::stable_sort(roots.begin(),roots.end(),byDegree);
+
+			// the state of each node: 0 = unvisited, 1 = reached while probing, 2 = ordered
+			std::vector<std::uint8_t> state(numNodes,0);
+			std::vector<std::size_t> order;
+			std::vector<std::size_t> probe;
+			std::vector<std::size_t> next;
+			order.reserve(numNodes);
+			for(const auto& root : roots) {
+				if (state[root] == 2) continue;
+
+				// a pseudo-peripheral node is the last one reached from the root
+				probe.clear();
+				probe.push_back(root);
+				state[root] = 1;
+				for(std::size_t i = 0; i < probe.size(); ++i) {
+					auto cur = probe[i];
+					for(auto j = graph.offsets[cur]; j < graph.offsets[cur+1]; ++j) {
+						auto n = graph.neighbours[j];
+						if (state[n] != 0) continue;
+						state[n] = 1;
+						probe.push_back(n);
+					}
+				}
 
-				// get upper boundary of covered node ranges
-				std::size_t max = 0;
-				region.scan([&](const SubTreeRef& cur){
-					max = std::max<std::size_t>(max,ptree.template getNodeRange<NodeKind,Level>(cur).getEnd().id);
-				});
+				// traverse the component from there, visiting neighbours of low degree first
+				auto start = probe.back();
+				state[start] = 2;
+				order.push_back(start);
+				for(std::size_t i = order.size() - 1; i < order.size(); ++i) {
+					auto cur = order[i];
+					next.clear();
+					for(auto j = graph.offsets[cur]; j < graph.offsets[cur+1]; ++j) {
+						auto n = graph.neighbours[j];
+						if (state[n] == 2) continue;
+						state[n] = 2;
+						next.push_back(n);
+					}
+					std::stable_sort(next.begin(),next.end(),byDegree);
+					order.insert(order.end(),next.begin(),next.end());
+				}
+			}
 
-				// resize data storage
+			// reversing the order reduces the profile of the resulting adjacency matrix
+			std::reverse(order.begin(),order.end());
+			return order;
+		}
+
+		/**
+		 * Computes a permutation re-numbering the nodes of all kinds on all levels of the given
+		 * mesh topology in reverse Cuthill-McKee order. The topology does not need to be closed,
+		 * as the graph of each level is obtained from the edges directly. Nodes of different kinds
+		 * keep their relative position within the joint order of their level.
+		 */
+		template<typename ... Nodes, typename ... Edges, typename ... Hierarchies, unsigned Levels>
+		MeshPermutation<nodes<Nodes...>,Levels> getReverseCuthillMcKeePermutation(const MeshTopologyData<nodes<Nodes...>,edges<Edges...>,hierarchies<Hierarchies...>,Levels>& data) {
+			using node_list = utils::type_list<Nodes...>;
+
+			MeshPermutation<nodes<Nodes...>,Levels> res;
+			LevelEnumerator<Levels-1>()([&](const auto& level) {
+				using lvl = get_level<decltype(level)>;
+				auto graph = buildMeshGraph<lvl::value>(data);
+				auto order = getReverseCuthillMcKeeOrder(graph);
+
+				// number the nodes of each kind in the obtained order
+				const auto numKinds = graph.kindOffsets.size() - 1;
+				std::vector<std::vector<node_index_t>> mappings(numKinds);
+				std::vector<node_index_t> next(numKinds,0);
+				for(std::size_t k = 0; k < numKinds; ++k) {
+					mappings[k].resize(graph.kindOffsets[k+1] - graph.kindOffsets[k]);
+				}
+				for(const auto& cur : order) {
+					auto kind = graph.getKind(cur);
+					mappings[kind][cur - graph.kindOffsets[kind]] = next[kind]++;
+				}
+
+				KindEnumerator<Nodes...>()([&](const auto& nodeKind) {
+					using NodeKind = plain_type<decltype(nodeKind)>;
+					res.template setMapping<NodeKind,lvl::value>(std::move(mappings[utils::type_index<NodeKind,node_list>::value]));
+				});
+			});
+			return res;
+		}
+
+		/**
+		 * Computes the index of the given point along a Hilbert curve through a grid of 2^Bits
+		 * cells in each dimension, following the transposition algorithm of J. Skilling.
+		 */
+		template<std::size_t Dims>
+		std::uint64_t getHilbertIndex(std::array<std::uint32_t,Dims> x, unsigned bits) {
+			assert_le(Dims * bits, 64u);
+			if (bits == 0) return 0;
+
+			// undo the excess work of the gray code
+			const std::uint32_t M = std::uint32_t(1) << (bits - 1);
+			for(std::uint32_t Q = M; Q > 1; Q >>= 1) {
+				std::uint32_t P = Q - 1;
+				for(std::size_t i = 0; i < Dims; ++i) {
+					if (x[i] & Q) {
+						x[0] ^= P;
+					} else {
+						std::uint32_t t = (x[0] ^ x[i]) & P;
+						x[0] ^= t;
+						x[i] ^= t;
+					}
+				}
+			}
+
+			// gray encode
+			for(std::size_t i = 1; i < Dims; ++i) x[i] ^= x[i-1];
+			std::uint32_t t = 0;
+			for(std::uint32_t Q = M; Q > 1; Q >>= 1) {
+				if (x[Dims-1] & Q) t ^= Q - 1;
+			}
+			for(std::size_t i = 0; i < Dims; ++i) x[i] ^= t;
+
+			// interleave the bits of the transposed index
+			std::uint64_t res = 0;
+			for(int b = int(bits) - 1; b >= 0; --b) {
+				for(std::size_t i = 0; i < Dims; ++i) {
+					res = (res << 1) | ((x[i] >> b) & 0x1);
+				}
+			}
+			return res;
+		}
+
+		/**
+		 * Computes a mapping re-numbering points in the order of their position along a Hilbert curve
+		 * through their bounding box.
+		 */
+		template<typename T, std::size_t Dims>
+		std::vector<node_index_t> getHilbertMapping(const std::vector<utils::Vector<T,Dims>>& points) {
+			static_assert(Dims > 0, "Points need to have at least one dimension!");
+			if (points.empty()) return {};
+
+			// determine the bounding box
+			std::array<double,Dims> min;
+			std::array<double,Dims> max;
+			for(std::size_t i = 0; i < Dims; ++i) {
+				min[i] = max[i] = double(points[0][i]);
+			}
+			for(const auto& p : points) {
+				for(std::size_t i = 0; i < Dims; ++i) {
+					min[i] = std::min(min[i],double(p[i]));
+					max[i] = std::max(max[i],double(p[i]));
+				}
+			}
+
+			// place the points on a grid and compute their indices along the curve
+			const unsigned bits = std::min<unsigned>(32, 64 / Dims);
+			const double scale = double((std::uint64_t(1) << bits) - 1);
+			std::vector<std::pair<std::uint64_t,std::size_t>> keys(points.size());
+			for(std::size_t j = 0; j < points.size(); ++j) {
+				std::array<std::uint32_t,Dims> cell;
+				for(std::size_t i = 0; i < Dims; ++i) {
+					auto extent = max[i] - min[i];
+					cell[i] = (extent > 0) ? std::uint32_t((double(points[j][i]) - min[i]) / extent * scale) : 0;
+				}
+				keys[j] = { getHilbertIndex(cell,bits), j };
+			}
+
+			// sort points along the curve
+			std::sort(keys.begin(),keys.end());
+			std::vector<node_index_t> res(points.size());
+			for(std::size_t i = 0; i < keys.size(); ++i) {
+				res[keys[i].second] = node_index_t(i);
+			}
+			return res;
+		}
+
+
+		// -- graph colorings --
+
+		/**
+		 * A coloring of the nodes or edges of a mesh, such that items of the same color are
+		 * not in conflict with each other (see Mesh::getNodeColoring and Mesh::getEdgeColoring).
+		 * Besides the color of each item, the items of each color are listed in ascending order.
+		 */
+		class MeshColoring {
+
+			std::vector<std::uint32_t> colors;
+
+			std::vector<std::size_t> offsets;
+
+			std::vector<std::size_t> items;
+
+		public:
+
+			MeshColoring(std::vector<std::uint32_t>&& colors) : colors(std::move(colors)) {
+
+				// count the items of each color
+				std::uint32_t numColors = 0;
+				for(auto cur : this->colors) numColors = std::max(numColors,cur+1);
+				offsets.resize(numColors+1,0);
+				for(auto cur : this->colors) offsets[cur+1]++;
+				for(std::size_t i=0; i<numColors; i++) offsets[i+1] += offsets[i];
+
+				// list the items of each color
+				items.resize(this->colors.size());
+				auto pos = offsets;
+				for(std::size_t i=0; i<this->colors.size(); i++) {
+					items[pos[this->colors[i]]++] = i;
+				}
+			}
+
+			/**
+			 * The number of colored items.
+			 */
+			std::size_t size() const {
+				return colors.size();
+			}
+
+			std::size_t getNumColors() const {
+				return offsets.size() - 1;
+			}
+
+			std::uint32_t getColor(std::size_t item) const {
+				assert_lt(item,colors.size());
+				return colors[item];
+			}
+
+			/**
+			 * The items of the given color, in ascending order.
+			 */
+			utils::range<const std::size_t*> getItems(std::size_t color) const {
+				assert_lt(color,getNumColors());
+				return { items.data() + offsets[color], items.data() + offsets[color+1] };
+			}
+
+		};
+
+		/**
+		 * Colors the given number of items in parallel, such that no item has the color of any of
+		 * the items it is in conflict with. Conflicts are enumerated by conflicts(item,visitor),
+		 * calling the visitor for the index of each conflicting item, and have to be symmetric.
+		 *
+		 * Items are speculatively assigned the smallest color not used by their conflicts in
+		 * parallel; whenever this leads to equally colored conflicting items, the larger one is
+		 * colored again in the next round.
+		 */
+		template<typename Conflicts>
+		MeshColoring getGreedyColoring(std::size_t numItems, const Conflicts& conflicts) {
+
+			const std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+			std::vector<std::atomic<std::uint32_t>> colors(numItems);
+			algorithm::pfor(std::size_t(0),numItems,[&](std::size_t i) {
+				colors[i].store(none,std::memory_order_relaxed);
+			});
+
+			auto getColor = [&](std::size_t i) {
+				return colors[i].load(std::memory_order_relaxed);
+			};
+
+			std::vector<std::size_t> worklist(numItems);
+			std::iota(worklist.begin(),worklist.end(),0);
+			std::vector<char> recolor;
+			while(!worklist.empty()) {
+
+				// assign tentative colors
+				algorithm::pfor(std::size_t(0),worklist.size(),[&](std::size_t i) {
+					auto item = worklist[i];
+
+					// pick the first color not used by conflicting items, searching windows of 64 colors
+					for(std::uint32_t base = 0;; base += 64) {
+						std::uint64_t used = 0;
+						conflicts(item,[&](std::size_t other) {
+							auto color = getColor(other);
+							if (other == item || color == none) return;
+							if (base <= color && color - base < 64) used |= std::uint64_t(1) << (color - base);
+						});
+						if (used == ~std::uint64_t(0)) continue;
+						std::uint32_t color = base;
+						while(used & 0x1) {
+							used >>= 1;
+							color++;
+						}
+						colors[item].store(color,std::memory_order_relaxed);
+						break;
+					}
+				});
+
+				// detect items in conflict with a smaller item of the same color
+				recolor.assign(worklist.size(),0);
+				algorithm::pfor(std::size_t(0),worklist.size(),[&](std::size_t i) {
+					auto item = worklist[i];
+					auto color = getColor(item);
+					conflicts(item,[&](std::size_t other) {
+						if (other < item && getColor(other) == color) recolor[i] = 1;
+					});
+				});
+
+				// and process those in the next round
+				std::size_t next = 0;
+				for(std::size_t i=0; i<worklist.size(); i++) {
+					if (recolor[i]) worklist[next++] = worklist[i];
+				}
+				worklist.resize(next);
+			}
+
+			std::vector<std::uint32_t> res(numItems);
+			algorithm::pfor(std::size_t(0),numItems,[&](std::size_t i) {
+				res[i] = getColor(i);
+			});
+			return MeshColoring(std::move(res));
+		}
+
+		/**
+		 * A thread-safe cache of values derived from the structure of a mesh, like colorings.
+		 */
+		template<typename Key, typename Value>
+		class MeshCache {
+
+			std::mutex lock;
+
+			std::map<Key,std::unique_ptr<Value>> values;
+
+		public:
+
+			/**
+			 * Obtains the value of the given key, computing it by the given factory if not present yet.
+			 */
+			template<typename Factory>
+			const Value& get(const Key& key, const Factory& factory) {
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					auto pos = values.find(key);
+					if (pos != values.end()) return *pos->second;
+				}
+
+				// compute the value without holding the lock, keeping the first one registered
+				auto value = std::make_unique<Value>(factory());
+				std::lock_guard<std::mutex> guard(lock);
+				auto& res = values[key];
+				if (!res) res = std::move(value);
+				return *res;
+			}
+
+		};
+
+		/**
+		 * The colorings of a mesh, indexed by the edge kind, level, distance and whether edges are colored.
+		 */
+		using MeshColoringCache = MeshCache<std::tuple<std::type_index,unsigned,unsigned,bool>,MeshColoring>;
+
+		/**
+		 * The transposed edge orders of the relations of a mesh, indexed by the edge kind and level.
+		 */
+		using MeshEdgeOrderCache = MeshCache<std::tuple<std::type_index,unsigned>,std::vector<std::size_t>>;
+
+
+		/**
+		 * A partitioner placing nodes connected through edges into common partitions, such that
+		 * edge cuts and the closures of partitions remain small. The nodes and edges of each level
+		 * form a graph, which is recursively bisected by ordering nodes according to their distance
+		 * to a peripheral node and splitting the nodes of each kind at their median. Nodes on coarser
+		 * levels are placed into the partition of their first child, if they have any.
+		 *
+		 * Since partitions cover ranges of node indices, nodes get re-ordered such that the nodes of
+		 * each partition are stored continuously. The applied permutation is appended to the one provided
+		 * by the caller.
+		 */
+		class GraphMeshPartitioner {
+
+			// the index of a leaf of the partition tree, enumerated from left to right
+			using leaf_t = std::uint32_t;
+
+
+			// the working set of the bisection
+			struct BisectionState {
+				std::vector<std::uint32_t> member;
+				std::vector<std::uint32_t> seen;
+				std::uint32_t memberStamp = 0;
+				std::uint32_t seenStamp = 0;
+				std::vector<std::size_t> order;
+				std::vector<leaf_t> leafs;
+			};
+
+		public:
+
+			template<
+				unsigned PartitionDepth,
+				typename ... Nodes,
+				typename ... Edges,
+				typename ... Hierarchies,
+				unsigned Levels
+			>
+			PartitionTree<nodes<Nodes...>,edges<Edges...>,hierarchies<Hierarchies...>,Levels,PartitionDepth> partition(
+					MeshTopologyData<nodes<Nodes...>,edges<Edges...>,hierarchies<Hierarchies...>,Levels>& data,
+					MeshPermutation<nodes<Nodes...>,Levels>& permutation
+				) const {
+
+				using node_list = utils::type_list<Nodes...>;
+				const leaf_t numLeafs = leaf_t(1) << PartitionDepth;
+				const std::size_t numKinds = sizeof...(Nodes);
+
+				assert_true(data.isClosed()) << "Only closed meshes can be partitioned!";
+
+				// -- assign nodes to leafs --
+
+				std::array<MeshGraph,Levels> graphs;
+				std::array<std::vector<leaf_t>,Levels> leafs;
+				std::array<std::vector<std::size_t>,Levels> firstChild;
+				LevelEnumerator<Levels-1>()([&](const auto& level) {
+					using lvl = get_level<decltype(level)>;
+					graphs[lvl::value] = buildMeshGraph<lvl::value>(data);
+					leafs[lvl::value] = bisect(graphs[lvl::value], PartitionDepth);
+					firstChild[lvl::value].resize(graphs[lvl::value].getNumNodes(), std::numeric_limits<std::size_t>::max());
+				});
+
+				// record the first child of each node
+				data.forAllHierarchyKinds([&](const auto& hierarchyKind, const auto& level) {
+					using HierarchyKind = plain_type<decltype(hierarchyKind)>;
+					using lvl = get_level<decltype(level)>;
+					using ParentKind = typename HierarchyKind::parent_node_kind;
+					using ChildKind = typename HierarchyKind::child_node_kind;
+					auto parentOffset = graphs[lvl::value].kindOffsets[utils::type_index<ParentKind,node_list>::value];
+					auto childOffset = graphs[lvl::value-1].kindOffsets[utils::type_index<ChildKind,node_list>::value];
+					auto& first = firstChild[lvl::value];
+					for(std::size_t i = 0; i < data.template getNumNodes<ParentKind,lvl::value>(); ++i) {
+						auto children = data.hierarchySets.template getChildren<HierarchyKind,lvl::value>(NodeRef<ParentKind,lvl::value>(i));
+						if (children.empty() || first[parentOffset + i] != std::numeric_limits<std::size_t>::max()) continue;
+						first[parentOffset + i] = childOffset + children.front().id;
+					}
+				});
+
+				// let parents follow their children, from the finest to the coarsest level
+				for(unsigned l = 1; l < Levels; ++l) {
+					for(std::size_t i = 0; i < firstChild[l].size(); ++i) {
+						if (firstChild[l][i] == std::numeric_limits<std::size_t>::max()) continue;
+						leafs[l][i] = leafs[l-1][firstChild[l][i]];
+					}
+				}
+
+				// -- re-order nodes such that the nodes of each leaf are stored continuously --
+
+				// the first new index of each leaf and the leaf of each new index, per level and kind
+				std::array<std::vector<std::vector<node_index_t>>,Levels> leafBegins;
+				std::array<std::vector<std::vector<leaf_t>>,Levels> leafOf;
+				std::array<std::vector<std::vector<node_index_t>>,Levels> mappings;
+				for(unsigned l = 0; l < Levels; ++l) {
+					const auto& graph = graphs[l];
+					leafBegins[l].resize(numKinds);
+					leafOf[l].resize(numKinds);
+					mappings[l].resize(numKinds);
+					for(std::size_t k = 0; k < numKinds; ++k) {
+						auto begin = graph.kindOffsets[k];
+						auto end = graph.kindOffsets[k+1];
+
+						// count the nodes of each leaf
+						auto& starts = leafBegins[l][k];
+						starts.assign(numLeafs + 1, 0);
+						for(auto i = begin; i < end; ++i) {
+							starts[leafs[l][i] + 1]++;
+						}
+						for(leaf_t i = 0; i < numLeafs; ++i) {
+							starts[i+1] += starts[i];
+						}
+
+						// assign new indices, preserving the order of nodes within leafs
+						auto pos = starts;
+						auto& mapping = mappings[l][k];
+						auto& leafOfNode = leafOf[l][k];
+						mapping.resize(end - begin);
+						leafOfNode.resize(end - begin);
+						for(auto i = begin; i < end; ++i) {
+							auto leaf = leafs[l][i];
+							auto trg = pos[leaf]++;
+							mapping[i - begin] = trg;
+							leafOfNode[trg] = leaf;
+						}
+					}
+				}
+
+				// apply the permutation
+				MeshPermutation<nodes<Nodes...>,Levels> reordering;
+				data.forAllNodeKinds([&](const auto& nodeKind, const auto& level) {
+					using NodeKind = plain_type<decltype(nodeKind)>;
+					using lvl = get_level<decltype(level)>;
+					reordering.template setMapping<NodeKind,lvl::value>(std::move(mappings[lvl::value][utils::type_index<NodeKind,node_list>::value]));
+				});
+				data.permute(reordering);
+				permutation.append(reordering);
+
+				// -- build the partition tree --
+
+				PartitionTree<nodes<Nodes...>,edges<Edges...>,hierarchies<Hierarchies...>,Levels,PartitionDepth> res;
+
+				// set up node ranges
+				data.forAllNodeKinds([&](const auto& nodeKind, const auto& level) {
+					using NodeKind = plain_type<decltype(nodeKind)>;
+					using lvl = get_level<decltype(level)>;
+					const auto& starts = leafBegins[lvl::value][utils::type_index<NodeKind,node_list>::value];
+					res.visitPreOrder([&](const SubTreeRef& ref) {
+						auto covered = getLeafs(ref,PartitionDepth);
+						res.template setNodeRange<NodeKind,lvl::value>(ref, NodeRange<NodeKind,lvl::value>(
+							NodeRef<NodeKind,lvl::value>(starts[covered.first]),
+							NodeRef<NodeKind,lvl::value>(starts[covered.second])
+						));
+					});
+				});
+
+				// set up closures of edges
+				data.forAllEdgeKinds([&](const auto& edgeKind, const auto& level) {
+					using EdgeKind = plain_type<decltype(edgeKind)>;
+					using lvl = get_level<decltype(level)>;
+					using SrcKind = typename EdgeKind::src_node_kind;
+					using TrgKind = typename EdgeKind::trg_node_kind;
+					const auto& srcLeafs = leafOf[lvl::value][utils::type_index<SrcKind,node_list>::value];
+					const auto& trgLeafs = leafOf[lvl::value][utils::type_index<TrgKind,node_list>::value];
+
+					auto forAllEdges = [&](const auto& body) {
+						for(std::size_t i = 0; i < srcLeafs.size(); ++i) {
+							for(const auto& trg : data.edgeSets.template getSinks<EdgeKind,lvl::value>(NodeRef<SrcKind,lvl::value>(i))) {
+								body(i,trg.id);
+							}
+						}
+					};
+
+					auto forward = computeClosures<PartitionDepth>(srcLeafs, trgLeafs, forAllEdges);
+					auto backward = computeClosures<PartitionDepth>(trgLeafs, srcLeafs, [&](const auto& body) {
+						forAllEdges([&](std::size_t src, std::size_t trg) { body(trg,src); });
+					});
+
+					res.visitPreOrder([&](const SubTreeRef& ref) {
+						res.template setForwardClosure<EdgeKind,lvl::value>(ref,forward[ref.getIndex()]);
+						res.template setBackwardClosure<EdgeKind,lvl::value>(ref,backward[ref.getIndex()]);
+					});
+				});
+
+				// set up closures of hierarchies
+				data.forAllHierarchyKinds([&](const auto& hierarchyKind, const auto& level) {
+					using HierarchyKind = plain_type<decltype(hierarchyKind)>;
+					using lvl = get_level<decltype(level)>;
+					using ParentKind = typename HierarchyKind::parent_node_kind;
+					using ChildKind = typename HierarchyKind::child_node_kind;
+					const auto& parentLeafs = leafOf[lvl::value][utils::type_index<ParentKind,node_list>::value];
+					const auto& childLeafs = leafOf[lvl::value-1][utils::type_index<ChildKind,node_list>::value];
+
+					auto forAllLinks = [&](const auto& body) {
+						for(std::size_t i = 0; i < parentLeafs.size(); ++i) {
+							for(const auto& child : data.hierarchySets.template getChildren<HierarchyKind,lvl::value>(NodeRef<ParentKind,lvl::value>(i))) {
+								body(i,child.id);
+							}
+						}
+					};
+
+					auto children = computeClosures<PartitionDepth>(parentLeafs, childLeafs, forAllLinks);
+					auto parents = computeClosures<PartitionDepth>(childLeafs, parentLeafs, [&](const auto& body) {
+						forAllLinks([&](std::size_t parent, std::size_t child) { body(child,parent); });
+					});
+
+					res.visitPreOrder([&](const SubTreeRef& ref) {
+						res.template setParentClosure<HierarchyKind,lvl::value-1>(ref,parents[ref.getIndex()]);
+						res.template setChildClosure<HierarchyKind,lvl::value>(ref,children[ref.getIndex()]);
+					});
+				});
+
+				// close the data representation
+				res.close();
+
+				// done
+				return res;
+			}
+
+		private:
+
+			// obtains the range of leafs covered by the given node of a partition tree of the given depth
+			static std::pair<leaf_t,leaf_t> getLeafs(const SubTreeRef& ref, unsigned depth) {
+				leaf_t begin = 0;
+				auto path = ref.getPath();
+				for(unsigned i = 0; i < ref.getDepth(); ++i) {
+					if ((path >> i) & 0x1) begin += leaf_t(1) << (depth - i - 1);
+				}
+				return { begin, begin + (leaf_t(1) << (depth - ref.getDepth())) };
+			}
+
+			// assigns each node of the given graph to a leaf of a partition tree of the given depth
+			static std::vector<leaf_t> bisect(const MeshGraph& graph, unsigned depth) {
+				BisectionState state;
+				state.member.resize(graph.getNumNodes(),0);
+				state.seen.resize(graph.getNumNodes(),0);
+				state.leafs.resize(graph.getNumNodes(),0);
+				std::vector<std::size_t> all(graph.getNumNodes());
+				for(std::size_t i = 0; i < all.size(); ++i) all[i] = i;
+				bisect(graph,all,0,depth,0,state);
+				return std::move(state.leafs);
+			}
+
+			static void bisect(const MeshGraph& graph, std::vector<std::size_t>& nodes, unsigned depth, unsigned maxDepth, leaf_t first, BisectionState& state) {
+				if (nodes.empty()) return;
+
+				// at the bottom all nodes are assigned to the current leaf
+				if (depth == maxDepth) {
+					for(const auto& cur : nodes) state.leafs[cur] = first;
+					return;
+				}
+
+				// mark the nodes of the current sub-graph
+				auto member = ++state.memberStamp;
+				for(const auto& cur : nodes) state.member[cur] = member;
+
+				// start from a peripheral node, being the last one reached from an arbitrary node
+				auto& order = state.order;
+				auto firstComponent = visitBreadthFirst(graph,nodes,nodes.front(),state);
+				auto start = order[firstComponent - 1];
+				visitBreadthFirst(graph,nodes,start,state);
+
+				// split the nodes of each kind at the median of the obtained order
+				std::vector<std::size_t> total(graph.kindOffsets.size() - 1, 0);
+				std::vector<std::size_t> taken(total.size(), 0);
+				for(const auto& cur : order) total[graph.getKind(cur)]++;
+				std::vector<std::size_t> left;
+				std::vector<std::size_t> right;
+				for(const auto& cur : order) {
+					auto kind = graph.getKind(cur);
+					if (taken[kind] < total[kind] / 2) {
+						left.push_back(cur);
+						taken[kind]++;
+					} else {
+						right.push_back(cur);
+					}
+				}
+
+				// free the current list before descending
+				std::vector<std::size_t>().swap(nodes);
+				bisect(graph,left,depth+1,maxDepth,first,state);
+				bisect(graph,right,depth+1,maxDepth,first + (leaf_t(1) << (maxDepth - depth - 1)),state);
+			}
+
+			// orders the nodes of the current sub-graph breadth first, starting with the given node; returns the size of its component
+			static std::size_t visitBreadthFirst(const MeshGraph& graph, const std::vector<std::size_t>& nodes, std::size_t start, BisectionState& state) {
+				auto& order = state.order;
+				auto member = state.memberStamp;
+				auto seen = ++state.seenStamp;
+				order.clear();
+
+				auto visit = [&](std::size_t root) {
+					if (state.seen[root] == seen) return;
+					state.seen[root] = seen;
+					order.push_back(root);
+					for(std::size_t i = order.size() - 1; i < order.size(); ++i) {
+						auto cur = order[i];
+						for(auto j = graph.offsets[cur]; j < graph.offsets[cur+1]; ++j) {
+							auto next = graph.neighbours[j];
+							if (state.member[next] != member || state.seen[next] == seen) continue;
+							state.seen[next] = seen;
+							order.push_back(next);
+						}
+					}
+				};
+
+				// visit the component of the start node first, followed by all others
+				visit(start);
+				auto res = order.size();
+				for(const auto& cur : nodes) visit(cur);
+				return res;
+			}
+
+			/**
+			 * Computes the closures of all nodes of the partition tree for the given relation,
+			 * provided by a generator of (source,target) pairs.
+			 */
+			template<unsigned PartitionDepth, typename Links>
+			static std::vector<MeshRegion> computeClosures(const std::vector<leaf_t>& srcLeafs, const std::vector<leaf_t>& trgLeafs, const Links& links) {
+
+				// collect the target leafs reached from each leaf
+				std::vector<std::vector<leaf_t>> sets(std::size_t(1) << (PartitionDepth + 1));
+				links([&](std::size_t src, std::size_t trg) {
+					// the index of a leaf within the tree is its position plus the number of inner nodes
+					auto& set = sets[(std::size_t(1) << PartitionDepth) + srcLeafs[src]];
+					auto leaf = trgLeafs[trg];
+					if (set.empty() || set.back() != leaf) set.push_back(leaf);
+				});
+
+				// aggregate them bottom up, converting them to regions
+				std::vector<MeshRegion> res(sets.size());
+				SubTreeRef::root().enumerate<PartitionDepth,false>([&](const SubTreeRef& ref) {
+					auto& set = sets[ref.getIndex()];
+					if (ref.getDepth() == PartitionDepth) {
+						std::sort(set.begin(),set.end());
+						set.erase(std::unique(set.begin(),set.end()),set.end());
+					} else {
+						auto& a = sets[ref.getLeftChild().getIndex()];
+						auto& b = sets[ref.getRightChild().getIndex()];
+						std::set_union(a.begin(),a.end(),b.begin(),b.end(),std::back_inserter(set));
+						std::vector<leaf_t>().swap(a);
+						std::vector<leaf_t>().swap(b);
+					}
+					std::vector<SubMeshRef> refs;
+					cover(set,SubTreeRef::root(),0,leaf_t(1) << PartitionDepth,refs);
+					res[ref.getIndex()] = MeshRegion(refs);
+				});
+				return res;
+			}
+
+			// collects the largest sub-trees covering exactly the given sorted set of leafs
+			static void cover(const std::vector<leaf_t>& set, const SubTreeRef& ref, leaf_t begin, leaf_t end, std::vector<SubMeshRef>& res) {
+				auto lo = std::lower_bound(set.begin(),set.end(),begin);
+				auto hi = std::lower_bound(lo,set.end(),end);
+				std::size_t count = hi - lo;
+				if (count == 0) return;
+				if (count == end - begin) {
+					res.push_back(ref);
+					return;
+				}
+				leaf_t mid = begin + (end - begin) / 2;
+				cover(set,ref.getLeftChild(),begin,mid,res);
+				cover(set,ref.getRightChild(),mid,end,res);
+			}
+
+		};
+
+
+		// -- mesh files --
+
+		/**
+		 * The header of files storing meshes, mesh data or mesh properties (see Mesh::storeTo). It
+		 * describes the structure of the stored content such that files written by a different
+		 * mesh type or platform are rejected before any of their content is interpreted.
+		 */
+		struct MeshFileHeader {
+
+			enum Content : std::uint32_t {
+				Topology = 1,
+				NodeData = 2,
+				Properties = 3
+			};
+
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t byteOrder;
+			std::uint32_t content;
+			std::uint32_t levels;
+			std::uint32_t partitionDepth;
+			std::uint16_t numNodeKinds;
+			std::uint16_t numEdgeKinds;
+			std::uint16_t numHierarchyKinds;
+			std::uint8_t indexSize;
+			std::uint8_t nodeIdSize;
+			std::uint32_t headerSize;
+			std::uint64_t signature;		// a hash of the kinds, levels and element sizes of stored node data
+			std::uint64_t payloadSize;		// the number of bytes following the header
+			std::uint64_t reserved;
+
+		};
+
+		static_assert(sizeof(MeshFileHeader) == 64, "Unexpected padding in mesh file header!");
+
+		constexpr char MESH_FILE_MAGIC[8] = { 'A', 'S', 'M', 'E', 'S', 'H', 0, 0 };
+
+		constexpr std::uint32_t MESH_FILE_VERSION = 1;
+
+		constexpr std::uint32_t MESH_FILE_BYTE_ORDER = 0x01020304;
+
+		/**
+		 * The signature and payload size of a file of node data arrays, accumulated array by array.
+		 */
+		struct MeshFileLayout {
+
+			std::uint64_t signature = 0xcbf29ce484222325ull;
+
+			std::uint64_t payloadSize = 0;
+
+			void addArray(std::size_t kind, unsigned level, std::size_t elementSize, std::size_t numElements) {
+				sign(kind);
+				sign(level);
+				sign(elementSize);
+				payloadSize += sizeof(std::size_t) + elementSize * numElements;
+			}
+
+		private:
+
+			void sign(std::uint64_t value) {
+				for(unsigned i=0; i<sizeof(value); i++) {
+					signature = (signature ^ ((value >> (8*i)) & 0xff)) * 0x100000001b3ull;
+				}
+			}
+
+		};
+
+		template<typename PartitionTree>
+		struct mesh_file_traits;
+
+		template<
+			typename ... Nodes,
+			typename ... Edges,
+			typename ... Hierarchies,
+			unsigned Levels,
+			unsigned PartitionDepth
+		>
+		struct mesh_file_traits<PartitionTree<nodes<Nodes...>,edges<Edges...>,hierarchies<Hierarchies...>,Levels,PartitionDepth>> {
+
+			using partition_tree_type = PartitionTree<nodes<Nodes...>,edges<Edges...>,hierarchies<Hierarchies...>,Levels,PartitionDepth>;
+
+			static MeshFileHeader getHeader(MeshFileHeader::Content content, std::uint64_t signature = 0) {
+				MeshFileHeader res;
+				std::memset(&res,0,sizeof(res));
+				std::memcpy(res.magic,MESH_FILE_MAGIC,sizeof(res.magic));
+				res.version = MESH_FILE_VERSION;
+				res.byteOrder = MESH_FILE_BYTE_ORDER;
+				res.content = content;
+				res.levels = Levels;
+				res.partitionDepth = PartitionDepth;
+				res.numNodeKinds = sizeof...(Nodes);
+				res.numEdgeKinds = sizeof...(Edges);
+				res.numHierarchyKinds = sizeof...(Hierarchies);
+				res.indexSize = sizeof(std::size_t);
+				res.nodeIdSize = sizeof(NodeID);
+				res.headerSize = sizeof(MeshFileHeader);
+				res.signature = signature;
+				return res;
+			}
+
+			template<typename NodeKind, typename T, unsigned Level>
+			static void addNodeData(const partition_tree_type& ptree, MeshFileLayout& layout) {
+				std::size_t numNodes = ptree.template getNodeRange<NodeKind,Level>(SubTreeRef::root()).getEnd().id;
+				layout.addArray(utils::type_index<NodeKind,utils::type_list<Nodes...>>::value,Level,sizeof(T),numNodes);
+			}
+
+		};
+
+		/**
+		 * A stream buffer writing to a storage entry through positional writes, starting at a given offset.
+		 */
+		class MeshFileStreamBuffer : public std::streambuf {
+
+			core::FileIOManager& manager;
+
+			core::Entry entry;
+
+			std::size_t offset;
+
+			std::vector<char> buffer;
+
+		public:
+
+			MeshFileStreamBuffer(core::FileIOManager& manager, core::Entry entry, std::size_t offset, std::size_t bufferSize = (1 << 20))
+				: manager(manager), entry(entry), offset(offset), buffer(bufferSize) {
+				setp(buffer.data(),buffer.data() + buffer.size());
+			}
+
+			std::size_t getOffset() const {
+				return offset + (pptr() - pbase());
+			}
+
+		protected:
+
+			int_type overflow(int_type c) override {
+				flush();
+				if (!traits_type::eq_int_type(c,traits_type::eof())) {
+					*pptr() = traits_type::to_char_type(c);
+					pbump(1);
+				}
+				return traits_type::not_eof(c);
+			}
+
+			std::streamsize xsputn(const char* data, std::streamsize count) override {
+				// large blocks are written directly
+				if (std::size_t(count) < buffer.size()) return std::streambuf::xsputn(data,count);
+				flush();
+				manager.writeAt(entry,offset,data,count);
+				offset += count;
+				return count;
+			}
+
+			int sync() override {
+				flush();
+				return 0;
+			}
+
+		private:
+
+			void flush() {
+				std::size_t size = pptr() - pbase();
+				if (size > 0) manager.writeAt(entry,offset,pbase(),size);
+				offset += size;
+				setp(buffer.data(),buffer.data() + buffer.size());
+			}
+
+		};
+
+		/**
+		 * Writes a mesh file consisting of the given header and the payload produced by the given
+		 * store operation, replacing any previous content of the file.
+		 */
+		template<typename Store>
+		void writeMeshFile(const std::string& path, MeshFileHeader header, const Store& store) {
+			auto& manager = core::FileIOManager::getInstance();
+			auto entry = manager.createEntry(path,core::Mode::Binary);
+
+			// write the payload behind the header
+			MeshFileStreamBuffer buffer(manager,entry,sizeof(header));
+			std::ostream out(&buffer);
+			store(out);
+			out.flush();
+
+			// fix the size of the file and complete the header
+			header.payloadSize = buffer.getOffset() - sizeof(header);
+			manager.resize(entry,buffer.getOffset());
+			manager.writeAt(entry,0,reinterpret_cast<const char*>(&header),sizeof(header));
+		}
+
+		/**
+		 * A read-only memory mapping of a mesh file, to be kept alive as long as data interpreted
+		 * from its payload is in use.
+		 */
+		class MappedMeshFile {
+
+			core::MemoryMappedInput input;
+
+			MappedMeshFile(const core::MemoryMappedInput& input) : input(input) {}
+
+		public:
+
+			MappedMeshFile(const MappedMeshFile&) = delete;
+			MappedMeshFile(MappedMeshFile&&) = delete;
+
+			MappedMeshFile& operator=(const MappedMeshFile&) = delete;
+			MappedMeshFile& operator=(MappedMeshFile&&) = delete;
+
+			~MappedMeshFile() {
+				core::FileIOManager::getInstance().close(input);
+			}
+
+			/**
+			 * Maps the given file into memory if its header matches the given one, apart from
+			 * the size of the payload, which has to be covered by the file.
+			 *
+			 * @return the mapped file, or nullptr if the file is missing or does not match
+			 */
+			static std::shared_ptr<MappedMeshFile> open(const std::string& path, const MeshFileHeader& expected) {
+				auto& manager = core::FileIOManager::getInstance();
+				auto entry = manager.createEntry(path,core::Mode::Binary);
+				if (!manager.exists(entry)) return nullptr;
+
+				// check the header before mapping the file
+				MeshFileHeader header;
+				if (manager.readAt(entry,0,reinterpret_cast<char*>(&header),sizeof(header)) != sizeof(header)) return nullptr;
+				if (!matches(header,expected)) return nullptr;
+
+				// map the file and check that it covers the payload
+				std::shared_ptr<MappedMeshFile> res(new MappedMeshFile(manager.shareMemoryMappedInput(entry)));
+				if (res->input.size() < sizeof(header) || header.payloadSize > res->input.size() - sizeof(header)) return nullptr;
+				return res;
+			}
+
+			const MeshFileHeader& getHeader() const {
+				return input.access<MeshFileHeader>();
+			}
+
+			utils::RawBuffer getPayload() const {
+				return utils::RawBuffer(const_cast<char*>(input.accessArray<char>() + sizeof(MeshFileHeader)));
+			}
+
+			void advise(core::AccessHint hint) const {
+				input.advise(hint,sizeof(MeshFileHeader),getHeader().payloadSize);
+			}
+
+		private:
+
+			static bool matches(const MeshFileHeader& a, const MeshFileHeader& b) {
+				return std::memcmp(a.magic,b.magic,sizeof(a.magic)) == 0
+					&& a.version == b.version
+					&& a.byteOrder == b.byteOrder
+					&& a.content == b.content
+					&& a.levels == b.levels
+					&& a.partitionDepth == b.partitionDepth
+					&& a.numNodeKinds == b.numNodeKinds
+					&& a.numEdgeKinds == b.numEdgeKinds
+					&& a.numHierarchyKinds == b.numHierarchyKinds
+					&& a.indexSize == b.indexSize
+					&& a.nodeIdSize == b.nodeIdSize
+					&& a.headerSize == b.headerSize
+					&& a.signature == b.signature;
+			}
+
+		};
+
+
+		template<
+			typename NodeKind,
+			typename ElementType,
+			unsigned Level,
+			typename PartitionTree
+		>
+		class MeshDataFragment {
+		public:
+
+			using facade_type = MeshData<NodeKind,ElementType,Level,PartitionTree>;
+			using region_type = MeshRegion;
+			using shared_data_type = PartitionTree;
+
+		private:
+
+			using partition_tree_type = PartitionTree;
+
+			const partition_tree_type& partitionTree;
+
+			region_type coveredRegion;
+
+			std::vector<ElementType> data;
+
+			friend facade_type;
+
+		public:
+
+			MeshDataFragment() = delete;
+
+			MeshDataFragment(const partition_tree_type& ptree, const region_type& region)
+				: partitionTree(ptree), coveredRegion(region) {
+
+				// get upper boundary of covered node ranges
+				std::size_t max = 0;
+				region.scan([&](const SubTreeRef& cur){
+					max = std::max<std::size_t>(max,ptree.template getNodeRange<NodeKind,Level>(cur).getEnd().id);
+				});
+
+				// resize data storage
 				data.resize(max);
 
 			}
@@ -2448,25 +4442,79 @@ namespace data {
 				assert_true(core::isSubRegion(area,other.coveredRegion)) << "New data " << area << " not covered by source of size " << coveredRegion << "\n";
 				assert_true(core::isSubRegion(area,coveredRegion))       << "New data " << area << " not covered by target of size " << coveredRegion << "\n";
 
-				assert_not_implemented();
-				std::cout << core::isSubRegion(area,other.coveredRegion);
+				// copy data range by range
+				area.scan([&](const SubTreeRef& ref){
+					auto range = partitionTree.template getNodeRange<NodeKind,Level>(ref);
+					std::copy(
+						other.data.begin() + range.getBegin().id,
+						other.data.begin() + range.getEnd().id,
+						data.begin() + range.getBegin().id
+					);
+				});
+			}
+
+			void extract(utils::ArchiveWriter& writer, const region_type& region) const {
+
+				// make sure the region is covered
+				assert_pred2(core::isSubRegion, region, getCoveredRegion())
+					<< "This fragment does not contain all of the requested data!";
 
-//				// copy data line by line using memcpy
-//				area.scanByLines([&](const point& a, const point& b){
-//					auto start = flatten(a);
-//					auto length = (flatten(b) - start) * sizeof(T);
-//					std::memcpy(&data[start],&other.data[start],length);
-//				});
+				// write the requested region to the archive
+				writer.write(region);
+
+				// add the data, one node range at a time
+				region.scan([&](const SubTreeRef& ref){
+					auto range = partitionTree.template getNodeRange<NodeKind,Level>(ref);
+					extractRange(writer,range.getBegin().id,range.getEnd().id,bulk_transfer());
+				});
 			}
 
-			void extract(utils::ArchiveWriter&, const region_type&) const {
-				assert_not_implemented();
+			void insert(utils::ArchiveReader& reader) {
+
+				// extract the covered region contained in the archive
+				auto region = reader.read<region_type>();
+
+				// check that it is fitting
+				assert_pred2(core::isSubRegion, region, getCoveredRegion())
+					<< "Targeted fragment does not cover data to be inserted!";
+
+				// insert the data, one node range at a time
+				region.scan([&](const SubTreeRef& ref){
+					auto range = partitionTree.template getNodeRange<NodeKind,Level>(ref);
+					insertRange(reader,range.getBegin().id,range.getEnd().id,bulk_transfer());
+				});
 			}
 
-			void insert(utils::ArchiveReader&) {
-				assert_not_implemented();
+		private:
+
+			// whether node ranges may be transferred as blocks of memory (std::vector<bool> is packed)
+			using bulk_transfer = std::integral_constant<bool,
+				utils::is_trivially_serializable<ElementType>::value && !std::is_same<ElementType,bool>::value
+			>;
+
+			void extractRange(utils::ArchiveWriter& writer, std::size_t begin, std::size_t end, std::true_type) const {
+				if (begin < end) writer.write(reinterpret_cast<const char*>(&data[begin]),(end - begin) * sizeof(ElementType));
+			}
+
+			void extractRange(utils::ArchiveWriter& writer, std::size_t begin, std::size_t end, std::false_type) const {
+				for(std::size_t i=begin; i<end; i++) {
+					writer.write(data[i]);
+				}
+			}
+
+			void insertRange(utils::ArchiveReader& reader, std::size_t begin, std::size_t end, std::true_type) {
+				// copy directly from the archive buffer
+				if (begin < end) reader.read_span<ElementType>(end - begin).copyTo(&data[begin]);
 			}
 
+			void insertRange(utils::ArchiveReader& reader, std::size_t begin, std::size_t end, std::false_type) {
+				for(std::size_t i=begin; i<end; i++) {
+					data[i] = reader.read<ElementType>();
+				}
+			}
+
+		public:
+
 
 			// -- load / store for files --
 
@@ -2586,22 +4634,332 @@ namespace data {
 			return (*data).size();
 		}
 
-
-		void store(std::ostream& out) const {
-			// ensure that the data is owned
-			assert_true(owned) << "Only supported when data is owned (not managed by some Data Item Manager)";
-			owned->store(out);
+
+		void store(std::ostream& out) const {
+			// ensure that the data is owned
+			assert_true(owned) << "Only supported when data is owned (not managed by some Data Item Manager)";
+			owned->store(out);
+		}
+
+		static MeshData load(const PartitionTree& ptree, std::istream& in) {
+			return std::make_unique<fragment_type>(fragment_type::load(ptree,in));
+		}
+
+		static MeshData interpret(const PartitionTree& ptree, utils::RawBuffer& raw) {
+			return std::make_unique<fragment_type>(fragment_type::interpret(ptree,raw));
+		}
+
+		// -- memory mapped files --
+
+		/**
+		 * Writes this data to the given file, which can be loaded back by mapFrom.
+		 */
+		void storeTo(const std::string& path) const {
+			// ensure that the data is owned
+			assert_true(owned) << "Only supported when data is owned (not managed by some Data Item Manager)";
+			detail::MeshFileLayout layout;
+			addFileLayout(layout);
+			detail::writeMeshFile(path,file_traits::getHeader(detail::MeshFileHeader::NodeData,layout.signature),[&](std::ostream& out) {
+				owned->store(out);
+			});
+		}
+
+		/**
+		 * Loads data stored by storeTo through a memory mapping of the given file. Since data is
+		 * mutable, it is copied out of the mapping.
+		 *
+		 * @return the loaded data, or nullptr if the file is missing or has not been written for the given partition tree
+		 */
+		static std::unique_ptr<MeshData> mapFrom(const PartitionTree& ptree, const std::string& path) {
+			detail::MeshFileLayout layout;
+			addFileLayout(ptree,layout);
+			auto file = detail::MappedMeshFile::open(path,file_traits::getHeader(detail::MeshFileHeader::NodeData,layout.signature));
+			if (!file || file->getHeader().payloadSize != layout.payloadSize) return nullptr;
+			file->advise(core::AccessHint::Sequential);
+			auto raw = file->getPayload();
+			return std::unique_ptr<MeshData>(new MeshData(std::make_unique<fragment_type>(fragment_type::interpret(ptree,raw))));
+		}
+
+		/**
+		 * Adds the array of this data to the given mesh file layout.
+		 */
+		void addFileLayout(detail::MeshFileLayout& layout) const {
+			addFileLayout(data->partitionTree,layout);
+		}
+
+		/**
+		 * Adds the array of data of this type covering the given partition tree to the given mesh file layout.
+		 */
+		static void addFileLayout(const PartitionTree& ptree, detail::MeshFileLayout& layout) {
+			file_traits::template addNodeData<NodeKind,ElementType,Level>(ptree,layout);
+		}
+
+	private:
+
+		using file_traits = detail::mesh_file_traits<PartitionTree>;
+
+	};
+
+
+	/**
+	 * A summary of the quality of the partitioning of a mesh w.r.t. a single edge kind, obtained
+	 * by inspecting the leafs of its partition tree.
+	 */
+	struct PartitionStatistics {
+
+		// the total number of edges
+		std::size_t numEdges = 0;
+
+		// the number of edges connecting nodes of different leafs
+		std::size_t edgeCut = 0;
+
+		// the number of nodes covered by the forward closures of all leafs, in total and at most
+		std::size_t forwardClosureSize = 0;
+		std::size_t maxForwardClosureSize = 0;
+
+		// the number of nodes covered by the backward closures of all leafs, in total and at most
+		std::size_t backwardClosureSize = 0;
+		std::size_t maxBackwardClosureSize = 0;
+
+		friend std::ostream& operator<<(std::ostream& out, const PartitionStatistics& stats) {
+			return out << "edges: " << stats.numEdges
+					<< ", cut: " << stats.edgeCut
+					<< ", forward closure: " << stats.forwardClosureSize << " (max " << stats.maxForwardClosureSize << ")"
+					<< ", backward closure: " << stats.backwardClosureSize << " (max " << stats.maxBackwardClosureSize << ")";
+		}
+	};
+
+	/**
+	 * A list of nodes decoded on the fly from a row of a compressed edge relation.
+	 */
+	template<typename Kind, unsigned Level>
+	class CompressedNodeList {
+
+		const std::uint8_t* _begin;
+
+		const std::uint8_t* _end;
+
+		// the index of the row, the first node is encoded relative to
+		node_index_t row;
+
+	public:
+
+		CompressedNodeList(const std::pair<const std::uint8_t*,const std::uint8_t*>& data, node_index_t row)
+			: _begin(data.first), _end(data.second), row(row) {}
+
+		class const_iterator {
+
+			const std::uint8_t* cur;
+
+			const std::uint8_t* next;
+
+			const std::uint8_t* end;
+
+			node_index_t value;
+
+			void decode() {
+				if (cur == end) return;
+				std::uint64_t delta;
+				next = detail::readVarInt(cur,delta);
+				value = node_index_t(std::int64_t(value) + detail::zigZagDecode(delta));
+			}
+
+		public:
+
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = NodeRef<Kind,Level>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const value_type*;
+			using reference = value_type;
+
+			const_iterator(const std::uint8_t* cur, const std::uint8_t* end, node_index_t base)
+				: cur(cur), next(cur), end(end), value(base) {
+				decode();
+			}
+
+			bool operator==(const const_iterator& other) const {
+				return cur == other.cur;
+			}
+
+			bool operator!=(const const_iterator& other) const {
+				return !(*this == other);
+			}
+
+			NodeRef<Kind,Level> operator*() const {
+				return NodeRef<Kind,Level>(value);
+			}
+
+			const_iterator& operator++() {
+				cur = next;
+				decode();
+				return *this;
+			}
+
+			const_iterator operator++(int) {
+				const_iterator res = *this;
+				++(*this);
+				return res;
+			}
+
+		};
+
+		const_iterator begin() const {
+			return const_iterator(_begin,_end,row);
+		}
+
+		const_iterator end() const {
+			return const_iterator(_end,_end,row);
+		}
+
+		bool empty() const {
+			return _begin == _end;
+		}
+
+		std::size_t size() const {
+			// each encoded value ends with a byte without continuation flag
+			return std::size_t(std::count_if(_begin,_end,[](std::uint8_t cur) { return cur < 0x80; }));
+		}
+
+	};
+
+	/**
+	 * A read-only copy of an edge relation of a mesh in compressed form. The sinks and sources
+	 * of each node are stored as differences of subsequent node indices, encoded as variable-length
+	 * integers, with 32-bit row offsets where possible (see detail::CompressedRows). Meshes with
+	 * nodes numbered for locality (see MeshBuilder::renumber) are thus stored with a few bytes per
+	 * edge, reducing the memory traffic of traversals bound by memory bandwidth.
+	 *
+	 * Since the rows are decoded while being iterated, sinks and sources are provided as
+	 * CompressedNodeLists instead of NodeLists. Instances are created by Mesh::compressEdges and
+	 * may be traversed by Mesh::pforAllEdges and multiplied by Mesh::multiply in place of the
+	 * lookup tables of the mesh. To this end, the index of the first edge of every 64th source
+	 * is retained, locating the edges of any source by decoding at most 63 rows.
+	 */
+	template<typename EdgeKind, unsigned Level>
+	class CompressedEdgeRelation {
+
+		using src_node_kind = typename EdgeKind::src_node_kind;
+
+		using trg_node_kind = typename EdgeKind::trg_node_kind;
+
+		static constexpr std::size_t EDGE_OFFSET_STRIDE = 64;
+
+		detail::CompressedRows forward;
+
+		detail::CompressedRows backward;
+
+		std::size_t numEdges;
+
+		// the index of the first edge of every EDGE_OFFSET_STRIDE-th source
+		std::vector<std::uint64_t> edgeOffsets;
+
+	public:
+
+		template<typename Mesh>
+		explicit CompressedEdgeRelation(const Mesh& mesh)
+			: forward(detail::CompressedRows::encode(mesh.template getNumNodes<src_node_kind,Level>(),[&](std::size_t i, const auto& visit) {
+				for(const auto& cur : mesh.template getSinks<EdgeKind>(NodeRef<src_node_kind,Level>(i))) visit(cur.id);
+			  })),
+			  backward(detail::CompressedRows::encode(mesh.template getNumNodes<trg_node_kind,Level>(),[&](std::size_t i, const auto& visit) {
+				for(const auto& cur : mesh.template getSources<EdgeKind>(NodeRef<trg_node_kind,Level>(i))) visit(cur.id);
+			  })),
+			  numEdges(mesh.template getNumEdges<EdgeKind,Level>()) {
+			std::uint64_t offset = 0;
+			for(std::size_t i = 0; i < forward.getNumRows(); ++i) {
+				if (i % EDGE_OFFSET_STRIDE == 0) edgeOffsets.push_back(offset);
+				offset += mesh.template getSinks<EdgeKind>(NodeRef<src_node_kind,Level>(node_index_t(i))).size();
+			}
+		}
+
+		CompressedNodeList<trg_node_kind,Level> getSinks(const NodeRef<src_node_kind,Level>& src) const {
+			return { forward.getRow(src.id), src.id };
+		}
+
+		CompressedNodeList<src_node_kind,Level> getSources(const NodeRef<trg_node_kind,Level>& trg) const {
+			return { backward.getRow(trg.id), trg.id };
+		}
+
+		std::size_t getNumEdges() const {
+			return numEdges;
+		}
+
+		/**
+		 * The number of sources, i.e. the rows of this relation.
+		 */
+		std::size_t getNumSources() const {
+			return forward.getNumRows();
+		}
+
+		/**
+		 * The index of the first edge starting at the given source, or the number of edges if the
+		 * given source is the number of sources.
+		 */
+		std::size_t getEdgeOffset(node_index_t src) const {
+			assert_le(src,getNumSources());
+			if (src == getNumSources()) return numEdges;
+			std::size_t sample = src / EDGE_OFFSET_STRIDE;
+			return edgeOffsets[sample] + forward.countValues(forward.getOffset(sample * EDGE_OFFSET_STRIDE),forward.getOffset(src));
+		}
+
+		/**
+		 * The position of the encoded sinks of the given source, where the number of sources
+		 * addresses the end of the encoded data. The number of encoded bytes approximates the
+		 * number of edges, which is used for balancing parallel traversals.
+		 */
+		std::size_t getRowOffset(node_index_t src) const {
+			return forward.getOffset(src);
+		}
+
+		/**
+		 * Visits all edges starting at sources within the given range, in the order of their index.
+		 */
+		template<typename Body>
+		void forAllEdges(node_index_t begin, node_index_t end, const Body& body) const {
+			std::size_t index = getEdgeOffset(begin);
+			for(node_index_t src = begin; src < end; ++src) {
+				NodeRef<src_node_kind,Level> source(src);
+				for(const auto& trg : getSinks(source)) {
+					body(EdgeRef<EdgeKind,Level>{ source, trg, index++ });
+				}
+			}
+		}
+
+		/**
+		 * Computes y[src] = sum of values[e] * x[trg(e)] over all edges e starting at src, for
+		 * each source within the given range.
+		 */
+		template<typename T, typename V>
+		void multiply(node_index_t begin, node_index_t end, const T* values, const V* x, V* y) const {
+			std::size_t index = getEdgeOffset(begin);
+			for(node_index_t src = begin; src < end; ++src) {
+				V sum = V();
+				for(const auto& trg : getSinks(NodeRef<src_node_kind,Level>(src))) {
+					detail::SparseRowKernel<V>::add(sum,values[index++],x[trg.id]);
+				}
+				y[src] = sum;
+			}
+		}
+
+		/**
+		 * The number of bytes occupied by the lookup tables of this relation.
+		 */
+		std::size_t getMemorySize() const {
+			return forward.getMemorySize() + backward.getMemorySize() + edgeOffsets.size() * sizeof(std::uint64_t);
 		}
 
-		static MeshData load(const PartitionTree& ptree, std::istream& in) {
-			return std::make_unique<fragment_type>(fragment_type::load(ptree,in));
+		/**
+		 * Determines whether the row offsets of this relation are stored with 32 bits.
+		 */
+		bool hasNarrowOffsets() const {
+			return forward.hasNarrowOffsets() && backward.hasNarrowOffsets();
 		}
 
-		static MeshData interpret(const PartitionTree& ptree, utils::RawBuffer& raw) {
-			return std::make_unique<fragment_type>(fragment_type::interpret(ptree,raw));
-		}
 	};
 
+	/**
+	 * A coloring of the nodes or edges of a mesh (see detail::MeshColoring).
+	 */
+	using MeshColoring = detail::MeshColoring;
 
 	/**
 	 * The default implementation of a mesh is capturing all ill-formed parameterizations
@@ -2659,12 +5017,24 @@ namespace data {
 
 	private:
 
+		using file_traits = detail::mesh_file_traits<partition_tree_type>;
+
+		// the file mapped into memory holding the data of this mesh, if any -- destroyed last
+		std::shared_ptr<const detail::MappedMeshFile> storage;
+
 		partition_tree_type partitionTree;
 
 		topology_type data;
 
+		// the colorings of nodes and edges computed so far
+		std::unique_ptr<detail::MeshColoringCache> colorings;
+
+		// the transposed edge orders of relations computed so far
+		std::unique_ptr<detail::MeshEdgeOrderCache> edgeOrders;
+
 		Mesh(topology_type&& data, partition_tree_type&& partitionTree)
-			: partitionTree(std::move(partitionTree)), data(std::move(data)) {
+			: partitionTree(std::move(partitionTree)), data(std::move(data)),
+			  colorings(std::make_unique<detail::MeshColoringCache>()), edgeOrders(std::make_unique<detail::MeshEdgeOrderCache>()) {
 			assert_true(data.isClosed());
 		}
 
@@ -2696,6 +5066,59 @@ namespace data {
 			return data.template getNumNodes<Kind,Level>();
 		}
 
+		/**
+		 * The number of edges of the given kind on the given level, which is the range of
+		 * the indices of those edges (see EdgeRef).
+		 */
+		template<typename EdgeKind,unsigned Level = 0>
+		std::size_t getNumEdges() const {
+			return data.edgeSets.template getNumEdges<EdgeKind,Level>();
+		}
+
+		/**
+		 * Determines the edge cut and the sizes of the closures of the partitions of this mesh
+		 * w.r.t. the given edge kind.
+		 */
+		template<typename EdgeKind, unsigned Level = 0>
+		PartitionStatistics getPartitionStatistics() const {
+			using SrcKind = typename EdgeKind::src_node_kind;
+			using TrgKind = typename EdgeKind::trg_node_kind;
+
+			// a utility to count the nodes of a kind within a region
+			auto count = [&](const auto& kind, const detail::MeshRegion& region) {
+				using Kind = detail::plain_type<decltype(kind)>;
+				std::size_t res = 0;
+				region.scan([&](const detail::SubTreeRef& ref) {
+					res += partitionTree.template getNodeRange<Kind,Level>(ref).size();
+				});
+				return res;
+			};
+
+			PartitionStatistics res;
+			detail::SubTreeRef::root().enumerate<PartitionDepth,true>([&](const detail::SubTreeRef& leaf) {
+				if (leaf.getDepth() != PartitionDepth) return;
+
+				// count edges leaving the leaf
+				auto local = partitionTree.template getNodeRange<TrgKind,Level>(leaf);
+				for(const auto& src : partitionTree.template getNodeRange<SrcKind,Level>(leaf)) {
+					for(const auto& trg : getSinks<EdgeKind>(src)) {
+						res.numEdges++;
+						if (trg.id < local.getBegin().id || trg.id >= local.getEnd().id) res.edgeCut++;
+					}
+				}
+
+				// sum up closures
+				auto forward = count(TrgKind(), partitionTree.template getForwardClosure<EdgeKind,Level>(leaf));
+				res.forwardClosureSize += forward;
+				res.maxForwardClosureSize = std::max(res.maxForwardClosureSize, forward);
+
+				auto backward = count(SrcKind(), partitionTree.template getBackwardClosure<EdgeKind,Level>(leaf));
+				res.backwardClosureSize += backward;
+				res.maxBackwardClosureSize = std::max(res.maxBackwardClosureSize, backward);
+			});
+			return res;
+		}
+
 		// -- mesh interactions --
 
 		template<
@@ -2882,6 +5305,353 @@ namespace data {
 			)(detail::SubTreeRef::root());
 		}
 
+		/**
+		 * A sequential operation calling the given body for each edge of the given kind
+		 * on the given level, in the order of their index.
+		 *
+		 * @tparam EdgeKind the kind of edge to be visited
+		 * @tparam Level the level of the mesh to be addressed
+		 * @tparam Body the type of operation to be applied on each edge
+		 *
+		 * @param body the operation to be applied on each EdgeRef of the selected kind and level
+		 */
+		template<typename EdgeKind, unsigned Level = 0, typename Body>
+		void forAllEdges(const Body& body) const {
+			data.edgeSets.template forAllEdges<EdgeKind,Level>(0,getNumNodes<typename EdgeKind::src_node_kind,Level>(),body);
+		}
+
+		/**
+		 * A parallel operation calling the given body for each edge of the given kind
+		 * on the given level exactly once.
+		 *
+		 * Edges are grouped by their source nodes, and thus follow the partitioning of the
+		 * source nodes within the partition tree. Sub-trees covering no more than the given
+		 * number of edges are processed sequentially, while leafs covering more edges are
+		 * further split along their source nodes.
+		 *
+		 * @tparam EdgeKind the kind of edge to be visited
+		 * @tparam Level the level of the mesh to be addressed
+		 * @tparam Body the type of operation to be applied on each edge
+		 *
+		 * @param body the operation to be applied on each EdgeRef of the selected kind and level
+		 * @param grainSize the number of edges up to which edges are processed sequentially
+		 * @return a scan reference for synchronizing upon the asynchronously processed operation
+		 */
+		template<typename EdgeKind, unsigned Level = 0, typename Body>
+		detail::scan_reference pforAllEdges(const Body& body, std::size_t grainSize = detail::DEFAULT_EDGE_GRAIN_SIZE) const {
+
+			using SrcKind = typename EdgeKind::src_node_kind;
+			const auto& edges = data.edgeSets;
+			return pforAllRows<SrcKind,Level>(
+				[&edges](node_index_t src) {
+					return edges.template getEdgeOffset<EdgeKind,Level>(NodeRef<SrcKind,Level>(src));
+				},
+				[&edges,&body](node_index_t begin, node_index_t end) {
+					edges.template forAllEdges<EdgeKind,Level>(begin,end,body);
+				},
+				grainSize
+			);
+		}
+
+		/**
+		 * A parallel operation calling the given body for each edge of the given compressed
+		 * relation of this mesh exactly once, like pforAllEdges on the lookup tables of the mesh.
+		 * Edges are decoded while being visited, reducing the memory traffic of the traversal.
+		 *
+		 * @param edges the compressed relation to be traversed, created by compressEdges
+		 * @param body the operation to be applied on each EdgeRef of the relation
+		 * @param grainSize the number of encoded bytes up to which edges are processed sequentially
+		 * @return a scan reference for synchronizing upon the asynchronously processed operation
+		 */
+		template<typename EdgeKind, unsigned Level, typename Body>
+		detail::scan_reference pforAllEdges(const CompressedEdgeRelation<EdgeKind,Level>& edges, const Body& body, std::size_t grainSize = detail::DEFAULT_EDGE_GRAIN_SIZE) const {
+			using SrcKind = typename EdgeKind::src_node_kind;
+			assert_eq((getNumNodes<SrcKind,Level>()),edges.getNumSources()) << "Relation not compressed from this mesh!";
+			return pforAllRows<SrcKind,Level>(
+				[&edges](node_index_t src) {
+					return edges.getRowOffset(src);
+				},
+				[&edges,&body](node_index_t begin, node_index_t end) {
+					edges.forAllEdges(begin,end,body);
+				},
+				grainSize
+			);
+		}
+
+		/**
+		 * Creates a compressed copy of the relation of the given edge kind on the given level,
+		 * for traversals bound by memory bandwidth (see CompressedEdgeRelation).
+		 */
+		template<typename EdgeKind, unsigned Level = 0>
+		CompressedEdgeRelation<EdgeKind,Level> compressEdges() const {
+			return CompressedEdgeRelation<EdgeKind,Level>(*this);
+		}
+
+		// -- sparse products --
+
+		/**
+		 * Computes the product y = A * x of the sparse matrix A, whose rows are the source nodes and
+		 * whose columns are the sink nodes of the edges of the given kind on the given level, with
+		 * the given vector x of values of the sink nodes. The entries of A are given by a value per
+		 * edge, indexed by the ordinal of the edges (see EdgeRef); edges connecting the same nodes
+		 * are summed up. Using std::array as element type, multiple vectors are multiplied at once.
+		 *
+		 * Rows are processed in parallel following the partition tree, like pforAllEdges, directly
+		 * on the lookup tables of the relation.
+		 *
+		 * @param values the values of the edges, one for each edge
+		 * @param input the vector x to be multiplied, one value for each sink node
+		 * @param output the vector y to store the result in, one value for each source node
+		 * @param grainSize the number of edges up to which rows are processed sequentially
+		 */
+		template<typename EdgeKind, unsigned Level = 0, typename T, typename V>
+		void multiply(
+				const std::vector<T>& values,
+				const mesh_data_type<typename EdgeKind::trg_node_kind,V,Level>& input,
+				mesh_data_type<typename EdgeKind::src_node_kind,V,Level>& output,
+				std::size_t grainSize = detail::DEFAULT_EDGE_GRAIN_SIZE) const {
+			using SrcKind = typename EdgeKind::src_node_kind;
+			using TrgKind = typename EdgeKind::trg_node_kind;
+			assert_eq((getNumEdges<EdgeKind,Level>()),values.size());
+			assert_le((getNumNodes<TrgKind,Level>()),input.size());
+			assert_le((getNumNodes<SrcKind,Level>()),output.size());
+			if (getNumNodes<SrcKind,Level>() == 0) return;
+
+			const auto& edges = data.edgeSets;
+			const T* a = values.data();
+			const V* in = (input.size() > 0) ? &input[NodeRef<TrgKind,Level>(0)] : nullptr;
+			V* out = &output[NodeRef<SrcKind,Level>(0)];
+			pforAllRows<SrcKind,Level>(
+				[&edges](node_index_t src) {
+					return edges.template getEdgeOffset<EdgeKind,Level>(NodeRef<SrcKind,Level>(src));
+				},
+				[&edges,a,in,out](node_index_t begin, node_index_t end) {
+					edges.template multiply<EdgeKind,Level>(begin,end,a,in,out);
+				},
+				grainSize
+			);
+		}
+
+		/**
+		 * Computes the product y = A * x like multiply, where the matrix A is given by a compressed
+		 * relation of this mesh, decoded while being multiplied, and the given values per edge.
+		 *
+		 * @param edges the compressed relation defining the structure of A, created by compressEdges
+		 * @param values the values of the edges, one for each edge
+		 * @param input the vector x to be multiplied, one value for each sink node
+		 * @param output the vector y to store the result in, one value for each source node
+		 * @param grainSize the number of encoded bytes up to which rows are processed sequentially
+		 */
+		template<typename EdgeKind, unsigned Level, typename T, typename V>
+		void multiply(
+				const CompressedEdgeRelation<EdgeKind,Level>& edges,
+				const std::vector<T>& values,
+				const mesh_data_type<typename EdgeKind::trg_node_kind,V,Level>& input,
+				mesh_data_type<typename EdgeKind::src_node_kind,V,Level>& output,
+				std::size_t grainSize = detail::DEFAULT_EDGE_GRAIN_SIZE) const {
+			using SrcKind = typename EdgeKind::src_node_kind;
+			using TrgKind = typename EdgeKind::trg_node_kind;
+			assert_eq((getNumNodes<SrcKind,Level>()),edges.getNumSources()) << "Relation not compressed from this mesh!";
+			assert_eq(edges.getNumEdges(),values.size());
+			assert_le((getNumNodes<TrgKind,Level>()),input.size());
+			assert_le((getNumNodes<SrcKind,Level>()),output.size());
+			if (getNumNodes<SrcKind,Level>() == 0) return;
+
+			const T* a = values.data();
+			const V* in = (input.size() > 0) ? &input[NodeRef<TrgKind,Level>(0)] : nullptr;
+			V* out = &output[NodeRef<SrcKind,Level>(0)];
+			pforAllRows<SrcKind,Level>(
+				[&edges](node_index_t src) {
+					return edges.getRowOffset(src);
+				},
+				[&edges,a,in,out](node_index_t begin, node_index_t end) {
+					edges.multiply(begin,end,a,in,out);
+				},
+				grainSize
+			);
+		}
+
+		/**
+		 * Computes the product y = A^T * x of the transposed sparse matrix A defined by the edges
+		 * of the given kind on the given level and the given values (see multiply), with the given
+		 * vector x of values of the source nodes. Rows of the transposed matrix are obtained from
+		 * the backward lookup table of the relation, such that results are not scattered among
+		 * threads. The order of the values along this table is computed on first use and cached.
+		 *
+		 * @param values the values of the edges, one for each edge
+		 * @param input the vector x to be multiplied, one value for each source node
+		 * @param output the vector y to store the result in, one value for each sink node
+		 * @param grainSize the number of edges up to which rows are processed sequentially
+		 */
+		template<typename EdgeKind, unsigned Level = 0, typename T, typename V>
+		void multiplyTransposed(
+				const std::vector<T>& values,
+				const mesh_data_type<typename EdgeKind::src_node_kind,V,Level>& input,
+				mesh_data_type<typename EdgeKind::trg_node_kind,V,Level>& output,
+				std::size_t grainSize = detail::DEFAULT_EDGE_GRAIN_SIZE) const {
+			using SrcKind = typename EdgeKind::src_node_kind;
+			using TrgKind = typename EdgeKind::trg_node_kind;
+			assert_eq((getNumEdges<EdgeKind,Level>()),values.size());
+			assert_le((getNumNodes<SrcKind,Level>()),input.size());
+			assert_le((getNumNodes<TrgKind,Level>()),output.size());
+			if (getNumNodes<TrgKind,Level>() == 0) return;
+
+			const auto& edges = data.edgeSets;
+			const auto& order = edgeOrders->get(std::make_tuple(std::type_index(typeid(EdgeKind)),Level),[&]{
+				return edges.template getTransposedEdgeOrder<EdgeKind,Level>();
+			});
+			const T* a = values.data();
+			const std::size_t* pos = order.data();
+			const V* in = (input.size() > 0) ? &input[NodeRef<SrcKind,Level>(0)] : nullptr;
+			V* out = &output[NodeRef<TrgKind,Level>(0)];
+			pforAllRows<TrgKind,Level>(
+				[&edges](node_index_t trg) {
+					return edges.template getReverseOffset<EdgeKind,Level>(NodeRef<TrgKind,Level>(trg));
+				},
+				[&edges,a,pos,in,out](node_index_t begin, node_index_t end) {
+					edges.template multiplyTransposed<EdgeKind,Level>(begin,end,a,pos,in,out);
+				},
+				grainSize
+			);
+		}
+
+		// -- colorings --
+
+		/**
+		 * Obtains a coloring of the source nodes of the given edge kind on the given level, such
+		 * that nodes within the given distance along edges of this kind are colored differently.
+		 * For distance 1, adjacent nodes get different colors, which only applies to relations
+		 * among nodes of the same kind. For distance 2, nodes sharing a neighbor get different
+		 * colors as well, such that operations updating the neighbors of nodes of the same color
+		 * do not interfere. The coloring is computed in parallel on first use and cached.
+		 */
+		template<typename EdgeKind, unsigned Level = 0>
+		const MeshColoring& getNodeColoring(unsigned distance) const {
+			using SrcKind = typename EdgeKind::src_node_kind;
+			using TrgKind = typename EdgeKind::trg_node_kind;
+			assert_true(distance == 1 || distance == 2) << "Unsupported coloring distance: " << distance;
+
+			return colorings->get(std::make_tuple(std::type_index(typeid(EdgeKind)),Level,distance,false),[&]{
+				const bool undirected = std::is_same<SrcKind,TrgKind>::value;
+
+				// visits the nodes adjacent to a node of a relation among nodes of the same kind
+				auto neighbors = [&](std::size_t node, const auto& visit) {
+					for(const auto& cur : getSinks<EdgeKind>(NodeRef<SrcKind,Level>(node))) visit(cur.id);
+					for(const auto& cur : getSources<EdgeKind>(NodeRef<TrgKind,Level>(node))) visit(cur.id);
+				};
+
+				return detail::getGreedyColoring(getNumNodes<SrcKind,Level>(),[&](std::size_t node, const auto& visit) {
+					if (undirected) {
+						neighbors(node,[&](std::size_t other) {
+							visit(other);
+							if (distance > 1) neighbors(other,visit);
+						});
+					} else if (distance > 1) {
+						// sources sharing a sink
+						for(const auto& trg : getSinks<EdgeKind>(NodeRef<SrcKind,Level>(node))) {
+							for(const auto& src : getSources<EdgeKind>(trg)) visit(src.id);
+						}
+					}
+				});
+			});
+		}
+
+		/**
+		 * Obtains a coloring of the edges of the given kind on the given level, indexed like
+		 * EdgeRefs. For distance 1, edges sharing an end point get different colors, such that
+		 * operations updating the end points of edges of the same color do not interfere. For
+		 * distance 2, edges with adjacent end points get different colors as well. The coloring
+		 * is computed in parallel on first use and cached.
+		 */
+		template<typename EdgeKind, unsigned Level = 0>
+		const MeshColoring& getEdgeColoring(unsigned distance = 1) const {
+			using SrcKind = typename EdgeKind::src_node_kind;
+			using TrgKind = typename EdgeKind::trg_node_kind;
+			assert_true(distance == 1 || distance == 2) << "Unsupported coloring distance: " << distance;
+
+			return colorings->get(std::make_tuple(std::type_index(typeid(EdgeKind)),Level,distance,true),[&]{
+				const bool undirected = std::is_same<SrcKind,TrgKind>::value;
+				const auto& edges = data.edgeSets;
+
+				// the indices of the edges ending at each sink, along the backward lookup table
+				const auto& order = edgeOrders->get(std::make_tuple(std::type_index(typeid(EdgeKind)),Level),[&]{
+					return edges.template getTransposedEdgeOrder<EdgeKind,Level>();
+				});
+
+				// visits the edges a node is the source or sink of
+				auto incident = [&](std::size_t node, bool isSource, const auto& visit) {
+					if (isSource || undirected) {
+						auto begin = edges.template getEdgeOffset<EdgeKind,Level>(NodeRef<SrcKind,Level>(node));
+						auto end = edges.template getEdgeOffset<EdgeKind,Level>(NodeRef<SrcKind,Level>(node+1));
+						for(auto i = begin; i < end; i++) visit(i);
+					}
+					if (!isSource || undirected) {
+						auto begin = edges.template getReverseOffset<EdgeKind,Level>(NodeRef<TrgKind,Level>(node));
+						auto end = edges.template getReverseOffset<EdgeKind,Level>(NodeRef<TrgKind,Level>(node+1));
+						for(auto i = begin; i < end; i++) visit(order[i]);
+					}
+				};
+
+				// visits the nodes adjacent to a node, and whether those are sources
+				auto adjacent = [&](std::size_t node, bool isSource, const auto& visit) {
+					if (isSource || undirected) {
+						for(const auto& cur : getSinks<EdgeKind>(NodeRef<SrcKind,Level>(node))) visit(cur.id,false);
+					}
+					if (!isSource || undirected) {
+						for(const auto& cur : getSources<EdgeKind>(NodeRef<TrgKind,Level>(node))) visit(cur.id,true);
+					}
+				};
+
+				return detail::getGreedyColoring(getNumEdges<EdgeKind,Level>(),[&](std::size_t index, const auto& visit) {
+					auto edge = edges.template getEdge<EdgeKind,Level>(index);
+					auto endPoint = [&](std::size_t node, bool isSource) {
+						incident(node,isSource,visit);
+						if (distance < 2) return;
+						adjacent(node,isSource,[&](std::size_t other, bool otherIsSource) {
+							incident(other,otherIsSource,visit);
+						});
+					};
+					endPoint(edge.src.id,true);
+					endPoint(edge.trg.id,false);
+				});
+			});
+		}
+
+		/**
+		 * A parallel operation calling the given body for each source node of the given edge kind
+		 * on the given level. Nodes are processed color by color according to the node coloring of
+		 * the given distance, with all nodes of the same color being processed in parallel. Thus,
+		 * for distance 2, the body may update the node and its neighbors without synchronization.
+		 */
+		template<typename EdgeKind, unsigned Level = 0, typename Body>
+		void pforAllColored(unsigned distance, const Body& body) const {
+			using SrcKind = typename EdgeKind::src_node_kind;
+			const auto& coloring = getNodeColoring<EdgeKind,Level>(distance);
+			for(std::size_t color = 0; color < coloring.getNumColors(); color++) {
+				auto nodes = coloring.getItems(color);
+				algorithm::pfor(std::size_t(0),nodes.size(),[&](std::size_t i) {
+					body(NodeRef<SrcKind,Level>(nodes.begin()[i]));
+				});
+			}
+		}
+
+		/**
+		 * A parallel operation calling the given body for each edge of the given kind on the given
+		 * level. Edges are processed color by color according to the edge coloring of the given
+		 * distance, with all edges of the same color being processed in parallel. Thus, the body
+		 * may update the end points of its edge without synchronization.
+		 */
+		template<typename EdgeKind, unsigned Level = 0, typename Body>
+		void pforAllEdgesColored(unsigned distance, const Body& body) const {
+			const auto& coloring = getEdgeColoring<EdgeKind,Level>(distance);
+			for(std::size_t color = 0; color < coloring.getNumColors(); color++) {
+				auto edges = coloring.getItems(color);
+				algorithm::pfor(std::size_t(0),edges.size(),[&](std::size_t i) {
+					body(data.edgeSets.template getEdge<EdgeKind,Level>(edges.begin()[i]));
+				});
+			}
+		}
+
 		template<typename Kind,	unsigned Level = 0,
 				typename MapOp,
 				typename ReduceOp,
@@ -2977,6 +5747,11 @@ namespace data {
 			return MeshData<NodeKind,T,Level,partition_tree_type>::interpret(partitionTree,raw);
 		}
 
+		template<typename NodeKind, typename T, unsigned Level = 0>
+		std::unique_ptr<MeshData<NodeKind,T,Level,partition_tree_type>> mapNodeData(const std::string& path) const {
+			return MeshData<NodeKind,T,Level,partition_tree_type>::mapFrom(partitionTree,path);
+		}
+
 
 		// -- mesh property handling --
 
@@ -2995,6 +5770,11 @@ namespace data {
 			return MeshProperties<Levels,partition_tree_type,Properties...>::interpret(*this,raw);
 		}
 
+		template<typename ... Properties>
+		std::unique_ptr<MeshProperties<Levels,partition_tree_type,Properties...>> mapProperties(const std::string& path) const {
+			return MeshProperties<Levels,partition_tree_type,Properties...>::mapFrom(*this,path);
+		}
+
 		// -- load / store for files --
 
 		void store(std::ostream& out) const {
@@ -3039,6 +5819,116 @@ namespace data {
 
 		}
 
+		// -- memory mapped files --
+
+		/**
+		 * Writes this mesh to the given file, preceded by a header describing the mesh type,
+		 * such that it can be mapped back into memory by mapFrom.
+		 */
+		void storeTo(const std::string& path) const {
+			detail::writeMeshFile(path,file_traits::getHeader(detail::MeshFileHeader::Topology),[&](std::ostream& out) {
+				store(out);
+			});
+		}
+
+		/**
+		 * Maps a mesh stored by storeTo into memory. The partition tree and the topology are
+		 * interpreted in place instead of being copied, such that the mesh is available right
+		 * away and the file may be shared read-only among processes, loading pages on demand.
+		 * The file remains mapped for the lifetime of the resulting mesh.
+		 *
+		 * @return the mapped mesh, or nullptr if the file is missing or has not been written by a mesh of this type
+		 */
+		static std::unique_ptr<Mesh> mapFrom(const std::string& path) {
+			auto file = detail::MappedMeshFile::open(path,file_traits::getHeader(detail::MeshFileHeader::Topology));
+			if (!file) return nullptr;
+			auto raw = file->getPayload();
+			auto res = std::make_unique<Mesh>(interpret(raw));
+			res->storage = std::move(file);
+			return res;
+		}
+
+	private:
+
+		/**
+		 * Processes the rows of a lookup table of a relation in parallel, where rows correspond to
+		 * the nodes of the given kind on the given level. Ranges of rows are obtained by splitting
+		 * the partition tree, and leafs covering more than the given number of entries are further
+		 * split such that both halves cover a similar number of entries.
+		 *
+		 * @param offset the position of the first entry of a given row within the lookup table
+		 * @param process the operation to be applied on a range [begin,end) of rows
+		 * @param grainSize the number of entries up to which rows are processed sequentially
+		 */
+		template<typename Kind, unsigned Level, typename Offset, typename Process>
+		detail::scan_reference pforAllRows(const Offset& offset, const Process& process, std::size_t grainSize) const {
+
+			// a range of rows, within a sub-tree of the partition tree
+			struct range {
+				detail::SubTreeRef ref;
+				node_index_t begin;
+				node_index_t end;
+			};
+
+			auto numEntries = [=](const range& a) {
+				return offset(a.end) - offset(a.begin);
+			};
+
+			const auto& ptree = partitionTree;
+			auto sub = [&ptree](const detail::SubTreeRef& ref) {
+				auto nodes = ptree.template getNodeRange<Kind,Level>(ref);
+				return range{ ref, nodes.getBegin().id, nodes.getEnd().id };
+			};
+
+			return core::prec(
+				// -- base case test --
+				[=](const range& a){
+					// small ranges and single nodes are processed sequentially
+					if (numEntries(a) <= grainSize) return true;
+					return a.ref.getDepth() == PartitionDepth && a.end - a.begin <= 1;
+				},
+				// -- base case --
+				[=](const range& a){
+					process(a.begin,a.end);
+				},
+				// -- step case --
+				core::pick(
+					// -- split --
+					[=](const range& a, const auto& rec){
+
+						// split inner nodes of the partition tree along the tree
+						if (a.ref.getDepth() < PartitionDepth) {
+							return core::parallel(
+								rec(sub(a.ref.getLeftChild())),
+								rec(sub(a.ref.getRightChild()))
+							);
+						}
+
+						// split leafs such that both halves cover a similar number of entries
+						auto half = offset(a.begin) + numEntries(a) / 2;
+						node_index_t lo = a.begin + 1;
+						node_index_t hi = a.end - 1;
+						while(lo < hi) {
+							node_index_t mid = lo + (hi - lo) / 2;
+							if (offset(mid) < half) {
+								lo = mid + 1;
+							} else {
+								hi = mid;
+							}
+						}
+						return core::parallel(
+							rec(range{ a.ref, a.begin, lo }),
+							rec(range{ a.ref, lo, a.end })
+						);
+					},
+					// -- serialized step case (optimization) --
+					[=](const range& a, const auto&){
+						process(a.begin,a.end);
+					}
+				)
+			)(sub(detail::SubTreeRef::root()));
+		}
+
 	};
 
 
@@ -3066,6 +5956,12 @@ namespace data {
 
 	};
 
+	/**
+	 * A partitioner re-ordering the nodes of meshes such that partitions are
+	 * formed by closely connected nodes (see detail::GraphMeshPartitioner).
+	 */
+	using GraphMeshPartitioner = detail::GraphMeshPartitioner;
+
 	/**
 	 * A utility to construct meshes.
 	 */
@@ -3086,10 +5982,15 @@ namespace data {
 
 		using topology_type = detail::MeshTopologyData<nodes<NodeKinds...>,edges<EdgeKinds...>,hierarchies<Hierarchies...>,Levels>;
 
+		using permutation_type = detail::MeshPermutation<nodes<NodeKinds...>,Levels>;
+
 	private:
 
 		topology_type data;
 
+		// whether the targets of edges and the children of hierarchies are to be sorted by their index
+		bool sortedLinks = false;
+
 	public:
 
 		// -- mesh modeling --
@@ -3127,6 +6028,44 @@ namespace data {
 			return data.hierarchySets.template addChild<HierarchyKind,LevelA>(parent,child);
 		}
 
+		/**
+		 * Requests the targets of edges and the children of hierarchies to be listed in the order of
+		 * their indices in built meshes, instead of the order they have been linked in. Combined with a
+		 * re-numbering of nodes, this improves the locality of neighbourhood traversals.
+		 */
+		void sortLinks(bool sorted = true) {
+			sortedLinks = sorted;
+		}
+
+		// -- node re-numbering --
+
+		/**
+		 * Re-numbers the nodes of all kinds and levels in reverse Cuthill-McKee order, such that
+		 * nodes linked by edges obtain close indices. All edges and hierarchies are updated accordingly
+		 * and the applied permutation is appended to the given one, to re-map data associated to nodes.
+		 * References to nodes obtained before re-numbering have to be re-mapped too.
+		 */
+		void renumber(permutation_type& permutation) {
+			auto reordering = detail::getReverseCuthillMcKeePermutation(data);
+			data.permute(reordering);
+			permutation.append(reordering);
+		}
+
+		/**
+		 * Re-numbers the nodes of the given kind and level along a space-filling Hilbert curve through
+		 * the given positions, one for each node. All edges and hierarchies are updated accordingly and
+		 * the applied permutation is appended to the given one.
+		 */
+		template<typename Kind, unsigned Level = 0, typename T, std::size_t Dims>
+		void renumber(const std::vector<utils::Vector<T,Dims>>& positions, permutation_type& permutation) {
+			static_assert(Level < Levels, "Trying to re-number nodes on invalid level.");
+			assert_eq(positions.size(),(data.template getNumNodes<Kind,Level>())) << "Positions required for all nodes!";
+			permutation_type reordering;
+			reordering.template setMapping<Kind,Level>(detail::getHilbertMapping(positions));
+			data.permute(reordering);
+			permutation.append(reordering);
+		}
+
 		// -- build mesh --
 
 		template<typename Partitioner, unsigned PartitionDepth = 0>
@@ -3134,7 +6073,7 @@ namespace data {
 
 			// close the topological data
 			topology_type meshData = data;
-			meshData.close();
+			meshData.close(sortedLinks);
 
 			// partition the mesh
 			auto partitionTree = partitioner.template partition<PartitionDepth>(meshData);
@@ -3147,16 +6086,53 @@ namespace data {
 			return build<detail::NaiveMeshPartitioner,PartitionDepth>(detail::NaiveMeshPartitioner());
 		}
 
+		/**
+		 * Builds a mesh utilizing a partitioner re-ordering the nodes of the mesh, like the
+		 * GraphMeshPartitioner. The applied permutation is appended to the given permutation
+		 * such that data associated to nodes can be re-mapped accordingly.
+		 */
+		template<typename Partitioner, unsigned PartitionDepth = 0>
+		mesh_type<PartitionDepth> build(const Partitioner& partitioner, permutation_type& permutation) const & {
+
+			// close the topological data
+			topology_type meshData = data;
+			meshData.close(sortedLinks);
+
+			// partition and re-order the mesh
+			auto partitionTree = partitioner.template partition<PartitionDepth>(meshData,permutation);
+
+			return mesh_type<PartitionDepth>(std::move(meshData), std::move(partitionTree));
+		}
 
+		/**
+		 * Builds a mesh consuming this builder. Like when building from a retained builder,
+		 * the topological data is closed before being partitioned; this step used to be
+		 * skipped, handing open relations to the partitioner and the resulting mesh.
+		 */
 		template<typename Partitioner, unsigned PartitionDepth = 0>
 		mesh_type<PartitionDepth> build(const Partitioner& partitioner) && {
 
+			// close the topological data
+			data.close(sortedLinks);
+
 			// partition the mesh
 			auto partitionTree = partitioner.template partition<PartitionDepth>(data);
 
 			return mesh_type<PartitionDepth>(std::move(data), std::move(partitionTree));
 		}
 
+		template<typename Partitioner, unsigned PartitionDepth = 0>
+		mesh_type<PartitionDepth> build(const Partitioner& partitioner, permutation_type& permutation) && {
+
+			// close the topological data
+			data.close(sortedLinks);
+
+			// partition and re-order the mesh
+			auto partitionTree = partitioner.template partition<PartitionDepth>(data,permutation);
+
+			return mesh_type<PartitionDepth>(std::move(data), std::move(partitionTree));
+		}
+
 		template<unsigned PartitionDepth = 0>
 		mesh_type<PartitionDepth> build() const && {
 			return std::move(*this).template build<detail::NaiveMeshPartitioner,PartitionDepth>(detail::NaiveMeshPartitioner());
@@ -3230,6 +6206,18 @@ namespace data {
 				}));
 			}
 
+			void addFileLayout(MeshFileLayout& layout) const {
+				utils::forEach(data,[&](const auto& entry){
+					entry.addFileLayout(layout);
+				});
+			}
+
+			template<typename Mesh>
+			static void addFileLayout(const Mesh& mesh, MeshFileLayout& layout) {
+				// in the order of the stored properties
+				(void)std::initializer_list<int>{ (mesh_data_type<Properties>::addFileLayout(mesh.getPartitionTree(),layout), 0)... };
+			}
+
 			template<typename Mesh>
 			static MeshPropertiesData interpret(const Mesh& mesh, utils::RawBuffer& raw) {
 				// a temporary tuple type to be filled with temporary results
@@ -3316,6 +6304,17 @@ namespace data {
 				return MeshPropertiesLevels(std::move(data),std::move(nested));
 			}
 
+			void addFileLayout(MeshFileLayout& layout) const {
+				data.addFileLayout(layout);
+				nested.addFileLayout(layout);
+			}
+
+			template<typename Mesh>
+			static void addFileLayout(const Mesh& mesh, MeshFileLayout& layout) {
+				level_data<Level>::addFileLayout(mesh,layout);
+				nested_level_type::addFileLayout(mesh,layout);
+			}
+
 			template<typename Mesh>
 			static MeshPropertiesLevels interpret(const Mesh& mesh, utils::RawBuffer& raw) {
 				// interpret property data
@@ -3367,6 +6366,15 @@ namespace data {
 				return level_data::load(mesh,in);
 			}
 
+			void addFileLayout(MeshFileLayout& layout) const {
+				data.addFileLayout(layout);
+			}
+
+			template<typename Mesh>
+			static void addFileLayout(const Mesh& mesh, MeshFileLayout& layout) {
+				level_data::addFileLayout(mesh,layout);
+			}
+
 			template<typename Mesh>
 			static MeshPropertiesLevels interpret(const Mesh& mesh, utils::RawBuffer& raw) {
 				// interpret property data
@@ -3434,6 +6442,41 @@ namespace data {
 			// forward call to data store
 			return MeshProperties(DataStore::interpret(mesh,raw));
 		}
+
+		// -- memory mapped files --
+
+		/**
+		 * Writes these properties to the given file, which can be loaded back by mapFrom.
+		 */
+		void storeTo(const std::string& path) const {
+			detail::MeshFileLayout layout;
+			data.addFileLayout(layout);
+			detail::writeMeshFile(path,file_traits::getHeader(detail::MeshFileHeader::Properties,layout.signature),[&](std::ostream& out) {
+				store(out);
+			});
+		}
+
+		/**
+		 * Loads properties stored by storeTo through a memory mapping of the given file. Like
+		 * any mesh data, the property values are copied out of the mapping.
+		 *
+		 * @return the loaded properties, or nullptr if the file is missing or has not been written for the given mesh
+		 */
+		template<typename Mesh>
+		static std::unique_ptr<MeshProperties> mapFrom(const Mesh& mesh, const std::string& path) {
+			detail::MeshFileLayout layout;
+			DataStore::addFileLayout(mesh,layout);
+			auto file = detail::MappedMeshFile::open(path,file_traits::getHeader(detail::MeshFileHeader::Properties,layout.signature));
+			if (!file || file->getHeader().payloadSize != layout.payloadSize) return nullptr;
+			file->advise(core::AccessHint::Sequential);
+			auto raw = file->getPayload();
+			return std::unique_ptr<MeshProperties>(new MeshProperties(DataStore::interpret(mesh,raw)));
+		}
+
+	private:
+
+		using file_traits = detail::mesh_file_traits<PartitionTree>;
+
 	};
 
 } // end namespace data
@@ -64,9 +64,7 @@ namespace data {
 
 		StaticGridFragment(const core::no_shared_data&, const region_type& size = region_type()) : size(size), data(area(totalSize())) {
 			// allocate covered data space
-			size.scanByLines([&](const point& a, const point& b) {
-				data.allocate(flatten(a),flatten(b));
-			});
+			data.allocate(toIntervals(size));
 		}
 
 		bool operator==(const StaticGridFragment& other) const {
@@ -103,14 +101,10 @@ namespace data {
 			size = newSize;
 
 			// allocated new data
-			plus.scanByLines([&](const point& a, const point& b){
-				data.allocate(flatten(a),flatten(b));
-			});
+			data.allocate(toIntervals(plus));
 
 			// free excessive memory
-			minus.scanByLines([&](const point& a, const point& b){
-				data.free(flatten(a),flatten(b));
-			});
+			data.free(toIntervals(minus));
 		}
 
 		void insert(const StaticGridFragment& other, const region_type& area) {
@@ -157,6 +151,13 @@ namespace data {
 
 	private:
 
+		/**
+		 * Converts the given region into the list of flattened index intervals it is covering.
+		 */
+		utils::detail::Intervals toIntervals(const region_type& region) const {
+			return utils::detail::toIntervals(region,[&](const point& p) { return flatten(p); });
+		}
+
 		static std::size_t area(const StaticGridPoint<Dims>& pos) {
 			std::size_t res = 1;
 			for(std::size_t i=0; i<Dims; ++i) {
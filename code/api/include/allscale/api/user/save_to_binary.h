@@ -1,5 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "allscale/api/core/io.h"
 #include "allscale/api/user/algorithm/pfor.h"
 
@@ -10,13 +19,15 @@ namespace user {
 
 // Save vector of vectors to binary in parallel
 template<typename T>
-void saveVecVecToFile(std::vector<std::vector<T>> vecVec, std::string filename, size_t innerSize) {
+void saveVecVecToFile(const std::vector<std::vector<T>>& vecVec, const std::string& filename, size_t innerSize) {
 	core::FileIOManager& manager = core::FileIOManager::getInstance();
 	size_t outerSize = vecVec.size();
 
 	// generate output data
 	core::Entry binary = manager.createEntry(filename, core::Mode::Binary);
-	auto fout = manager.openOutputStream(binary);
+
+	// records are tagged by their index, thus they may be written in any order
+	auto fout = manager.openAsyncOutputStream(binary);
 
 //	fout.write(innerSize);
 
@@ -41,7 +52,7 @@ void saveVecVecToFile(std::vector<std::vector<T>> vecVec, std::string filename,
 }
 
 template<typename T>
-void saveVecVecToFileMM(std::vector<std::vector<T>> vecVec, std::string filename, unsigned outerSize, unsigned innerSize) {
+void saveVecVecToFileMM(const std::vector<std::vector<T>>& vecVec, const std::string& filename, size_t outerSize, size_t innerSize) {
 	core::FileIOManager& manager = core::FileIOManager::getInstance();
 
 	// generate output data
@@ -62,9 +73,277 @@ void saveVecVecToFileMM(std::vector<std::vector<T>> vecVec, std::string filename
 	manager.close(fout);
 }
 
+// -- columnar binary format --
+
+// The version of the columnar binary format written by writeColumns
+constexpr std::uint32_t COLUMNAR_FORMAT_VERSION = 1;
+
+// The alignment of columns within the columnar binary format, such that mapped columns are suitably aligned for vectorized access
+constexpr std::size_t COLUMN_ALIGNMENT = 64;
+
+// The granularity of column checksums, allowing them to be computed in parallel
+constexpr std::size_t CHECKSUM_BLOCK_SIZE = 1024 * 1024;
+
+namespace detail {
+
+	// The header of the columnar binary format, followed by a table of numColumns column descriptors
+	struct ColumnarHeader {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t byteOrder;
+		std::uint32_t flags;
+		std::uint32_t elementSize;
+		std::uint64_t numColumns;
+	};
+
+	static_assert(sizeof(ColumnarHeader) == 32, "Unexpected padding in columnar header!");
+
+	// The descriptor of a single column, locating its data within the entry
+	struct ColumnDescriptor {
+		std::uint64_t offset;
+		std::uint64_t size;
+		std::uint64_t checksum;
+	};
+
+	static_assert(sizeof(ColumnDescriptor) == 24, "Unexpected padding in column descriptor!");
+
+	constexpr char COLUMNAR_MAGIC[8] = { 'A', 'S', 'C', 'O', 'L', 'B', 'I', 'N' };
+
+	constexpr std::uint32_t COLUMNAR_BYTE_ORDER = 0x01020304;
+
+	constexpr std::uint32_t COLUMNAR_FLAG_CHECKSUMS = 0x1;
+
+	// A hash over the given bytes, processing 8 bytes per step
+	inline std::uint64_t hashBytes(const char* data, std::size_t size, std::uint64_t hash = 0xcbf29ce484222325ull) {
+		const std::uint64_t prime = 0x100000001b3ull;
+		std::size_t i = 0;
+		for(; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+			std::uint64_t word;
+			std::memcpy(&word, data + i, sizeof(word));
+			hash = (hash ^ word) * prime;
+			hash ^= hash >> 29;
+		}
+		for(; i < size; ++i) {
+			hash = (hash ^ (unsigned char)data[i]) * prime;
+		}
+		return hash;
+	}
+
+	// The checksum of a column, combining the hashes of its blocks computed in parallel
+	inline std::uint64_t checksum(const char* data, std::size_t size) {
+		std::size_t numBlocks = (size + CHECKSUM_BLOCK_SIZE - 1) / CHECKSUM_BLOCK_SIZE;
+		std::vector<std::uint64_t> hashes(numBlocks);
+		algorithm::pfor(std::size_t(0), numBlocks, [&](std::size_t i) {
+			std::size_t begin = i * CHECKSUM_BLOCK_SIZE;
+			hashes[i] = hashBytes(data + begin, std::min(CHECKSUM_BLOCK_SIZE, size - begin));
+		});
+		return hashBytes(reinterpret_cast<const char*>(hashes.data()), hashes.size() * sizeof(std::uint64_t), size);
+	}
+
+	inline std::size_t alignColumn(std::size_t offset) {
+		return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+	}
+
+} // end namespace detail
+
+// Replace the content of an entry by the given columns in the columnar binary format; columns are written in parallel by one positional write per chunk
+template<typename T, typename Manager>
+void writeColumns(Manager& manager, core::Entry entry, const std::vector<std::vector<T>>& columns, bool checksums = true, std::size_t chunkSize = core::DEFAULT_IO_CHUNK_SIZE) {
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types may be stored in columnar format!");
+	assert_lt(0u, chunkSize);
+
+	// create the header
+	detail::ColumnarHeader header;
+	std::memcpy(header.magic, detail::COLUMNAR_MAGIC, sizeof(header.magic));
+	header.version = COLUMNAR_FORMAT_VERSION;
+	header.byteOrder = detail::COLUMNAR_BYTE_ORDER;
+	header.flags = (checksums) ? detail::COLUMNAR_FLAG_CHECKSUMS : 0;
+	header.elementSize = sizeof(T);
+	header.numColumns = columns.size();
+
+	// lay out the columns
+	std::size_t numColumns = columns.size();
+	std::vector<detail::ColumnDescriptor> table(numColumns);
+	std::size_t offset = detail::alignColumn(sizeof(header) + numColumns * sizeof(detail::ColumnDescriptor));
+	for(std::size_t i = 0; i < numColumns; ++i) {
+		table[i].offset = offset;
+		table[i].size = columns[i].size() * sizeof(T);
+		table[i].checksum = 0;
+		offset = detail::alignColumn(offset + table[i].size);
+	}
+
+	// compute checksums in parallel
+	if (checksums) {
+		algorithm::pfor(std::size_t(0), numColumns, [&](std::size_t i) {
+			table[i].checksum = detail::checksum(reinterpret_cast<const char*>(columns[i].data()), table[i].size);
+		});
+	}
+
+	// enumerate the chunks of all columns
+	std::vector<std::pair<std::size_t,std::size_t>> chunks;
+	for(std::size_t i = 0; i < numColumns; ++i) {
+		for(std::size_t begin = 0; begin < table[i].size; begin += chunkSize) {
+			chunks.push_back({ i, begin });
+		}
+	}
+
+	// fix the size of the entry, write the header and all chunks independently
+	manager.resize(entry, offset);
+	std::vector<char> prefix(sizeof(header) + numColumns * sizeof(detail::ColumnDescriptor));
+	std::memcpy(prefix.data(), &header, sizeof(header));
+	if (numColumns > 0) std::memcpy(prefix.data() + sizeof(header), table.data(), numColumns * sizeof(detail::ColumnDescriptor));
+	manager.writeAt(entry, 0, prefix.data(), prefix.size());
+	algorithm::pfor(std::size_t(0), chunks.size(), [&](std::size_t i) {
+		const auto& column = table[chunks[i].first];
+		std::size_t begin = chunks[i].second;
+		const char* data = reinterpret_cast<const char*>(columns[chunks[i].first].data());
+		manager.writeAt(entry, column.offset + begin, data + begin, std::min<std::size_t>(chunkSize, column.size - begin));
+	});
+}
+
+// A zero-copy view on the columns of an entry in the columnar binary format, mapped into memory for the lifetime of the view
+template<typename T, typename Manager = core::FileIOManager>
+class MappedColumns {
+
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types may be stored in columnar format!");
+
+	Manager* manager;
+
+	core::MemoryMappedInput in;
+
+	const detail::ColumnDescriptor* table;
+
+	std::size_t numColumns;
+
+	bool checksums;
+
+	bool valid;
+
+public:
+
+	MappedColumns(Manager& manager, core::Entry entry)
+		: manager(&manager), in(manager.shareMemoryMappedInput(entry)), table(nullptr), numColumns(0), checksums(false), valid(false) {
+		valid = validate();
+	}
+
+	MappedColumns(const MappedColumns&) = delete;
+
+	MappedColumns(MappedColumns&& other)
+		: manager(other.manager), in(other.in), table(other.table), numColumns(other.numColumns), checksums(other.checksums), valid(other.valid) {
+		other.manager = nullptr;
+	}
+
+	~MappedColumns() {
+		if (manager) manager->close(in);
+	}
+
+	MappedColumns& operator=(const MappedColumns&) = delete;
+	MappedColumns& operator=(MappedColumns&&) = delete;
+
+	// Determines whether the entry is a well-formed columnar file of elements of type T
+	bool isValid() const {
+		return valid;
+	}
+
+	// Determines whether checksums have been stored for the columns
+	bool hasChecksums() const {
+		return checksums;
+	}
+
+	std::size_t getNumColumns() const {
+		return numColumns;
+	}
+
+	// The number of elements of the given column
+	std::size_t getColumnSize(std::size_t i) const {
+		assert_true(valid);
+		assert_lt(i, numColumns);
+		return table[i].size / sizeof(T);
+	}
+
+	// The elements of the given column, referencing the mapped data
+	const T* getColumn(std::size_t i) const {
+		assert_true(valid);
+		assert_lt(i, numColumns);
+		return reinterpret_cast<const T*>(in.accessArray<char>() + table[i].offset);
+	}
+
+	// Checks the integrity of all columns in parallel, succeeding trivially if no checksums have been stored
+	bool verify() const {
+		if (!valid) return false;
+		if (!checksums) return true;
+		std::atomic<bool> ok(true);
+		algorithm::pfor(std::size_t(0), numColumns, [&](std::size_t i) {
+			const char* data = in.accessArray<char>() + table[i].offset;
+			if (detail::checksum(data, table[i].size) != table[i].checksum) ok = false;
+		});
+		return ok;
+	}
+
+	// Copies all columns into vectors in parallel
+	std::vector<std::vector<T>> toVectors() const {
+		assert_true(valid);
+		std::vector<std::vector<T>> res(numColumns);
+		algorithm::pfor(std::size_t(0), numColumns, [&](std::size_t i) {
+			const T* column = getColumn(i);
+			res[i].assign(column, column + getColumnSize(i));
+		});
+		return res;
+	}
+
+private:
+
+	bool validate() {
+		const char* base = in.accessArray<char>();
+		std::size_t size = in.size();
+
+		// check the header
+		detail::ColumnarHeader header;
+		if (size < sizeof(header)) return false;
+		std::memcpy(&header, base, sizeof(header));
+		if (std::memcmp(header.magic, detail::COLUMNAR_MAGIC, sizeof(header.magic)) != 0) return false;
+		if (header.version < 1 || header.version > COLUMNAR_FORMAT_VERSION) return false;
+		if (header.byteOrder != detail::COLUMNAR_BYTE_ORDER) return false;
+		if (header.elementSize != sizeof(T)) return false;
+		if (header.numColumns > (size - sizeof(header)) / sizeof(detail::ColumnDescriptor)) return false;
+
+		// check the column table
+		auto columns = reinterpret_cast<const detail::ColumnDescriptor*>(base + sizeof(header));
+		for(std::size_t i = 0; i < header.numColumns; ++i) {
+			const auto& column = columns[i];
+			if (column.offset % alignof(T) != 0 || column.size % sizeof(T) != 0) return false;
+			if (column.offset > size || column.size > size - column.offset) return false;
+		}
+
+		table = columns;
+		numColumns = header.numColumns;
+		checksums = (header.flags & detail::COLUMNAR_FLAG_CHECKSUMS);
+		return true;
+	}
+
+};
+
+// Save vector of columns to a file in the columnar binary format, written in parallel
+template<typename T>
+void saveVecVecToFileColumnar(const std::vector<std::vector<T>>& vecVec, const std::string& filename, bool checksums = true) {
+	core::FileIOManager& manager = core::FileIOManager::getInstance();
+	core::Entry binary = manager.createEntry(filename, core::Mode::Binary);
+	writeColumns(manager, binary, vecVec, checksums);
+}
+
+// Read vector of columns from a file in the columnar binary format, copied in parallel; the result is empty if the file is not valid
+template<typename T>
+std::vector<std::vector<T>> readVecVecFromFileColumnar(const std::string& filename) {
+	core::FileIOManager& manager = core::FileIOManager::getInstance();
+	core::Entry binary = manager.createEntry(filename, core::Mode::Binary);
+	MappedColumns<T> columns(manager, binary);
+	if (!columns.verify()) return {};
+	return columns.toVectors();
+}
+
 // Read vector of vectors to binary in parallel
 template<typename T>
-std::vector<std::vector<T>> readVecVecFromFile(std::string filename, size_t outerSize, size_t innerSize) {
+std::vector<std::vector<T>> readVecVecFromFile(const std::string& filename, size_t outerSize, size_t innerSize) {
 	std::vector<std::vector<T>> vecVec;
 	core::FileIOManager& manager = core::FileIOManager::getInstance();
 
@@ -94,7 +373,7 @@ std::vector<std::vector<T>> readVecVecFromFile(std::string filename, size_t oute
 
 // Read vector of vectors to binary in parallel
 template<typename T>
-std::vector<std::vector<T>> readVecVecFromFileMM(std::string filename, unsigned outerSize, unsigned innerSize) {
+std::vector<std::vector<T>> readVecVecFromFileMM(const std::string& filename, size_t outerSize, size_t innerSize) {
 	std::vector<std::vector<T>> vecVec;
 	core::FileIOManager& manager = core::FileIOManager::getInstance();
 
@@ -102,12 +381,17 @@ std::vector<std::vector<T>> readVecVecFromFileMM(std::string filename, unsigned
 	auto fin = manager.openMemoryMappedInput(binary);
 	auto dataIn = &fin.access<T>();//<std::array<T, InnerSize*OuterSize>>();
 
+	// data is consumed in order, while being loaded in parallel
+	fin.advise(core::AccessHint::Sequential);
+	auto loaded = fin.prefetch();
+
 	for(size_t j = 0; j < outerSize; ++j) {
 		vecVec.push_back(std::vector<T>());
 		for(size_t i = 0; i < innerSize; ++i)
 			vecVec[j].push_back(T());
 	}
 
+	loaded.wait();
 	for(size_t i = 0; i < innerSize; ++i) {
 		for(size_t j = 0; j < outerSize; ++j) {
 			// read data
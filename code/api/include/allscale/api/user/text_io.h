@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "allscale/api/core/io.h"
+#include "allscale/api/user/algorithm/pfor.h"
+#include "allscale/utils/assert.h"
+#include "allscale/utils/text_format.h"
+
+
+namespace allscale {
+namespace api {
+namespace user {
+
+// The default number of bytes of text parsed by individual tasks
+constexpr std::size_t DEFAULT_TEXT_BLOCK_SIZE = 1024 * 1024;
+
+// The default number of lines formatted by individual tasks
+constexpr std::size_t DEFAULT_TEXT_LINES_PER_BLOCK = 16 * 1024;
+
+// Split the given text into blocks of about the given size, ending at line boundaries; the result lists the bounds of all blocks
+inline std::vector<const char*> splitAtLines(const char* begin, const char* end, std::size_t blockSize = DEFAULT_TEXT_BLOCK_SIZE) {
+	assert_lt(0u, blockSize);
+	std::vector<const char*> bounds;
+	bounds.push_back(begin);
+	const char* cur = begin;
+	while(std::size_t(end - cur) > blockSize) {
+		// move the cut to the end of the line crossing the nominal block boundary
+		auto pos = static_cast<const char*>(std::memchr(cur + blockSize - 1, '\n', end - (cur + blockSize - 1)));
+		if (!pos || pos + 1 == end) break;
+		cur = pos + 1;
+		bounds.push_back(cur);
+	}
+	bounds.push_back(end);
+	return bounds;
+}
+
+// Process all lines of the given text in parallel, one task per block; the body is called with the index of the line and a reader for its content
+template<typename Body>
+std::size_t pforLines(const char* begin, const char* end, const Body& body, std::size_t blockSize = DEFAULT_TEXT_BLOCK_SIZE) {
+	auto bounds = splitAtLines(begin, end, blockSize);
+	std::size_t numBlocks = bounds.size() - 1;
+
+	// count the lines of each block, all but the last one ending with a line break
+	std::vector<std::size_t> firstLine(numBlocks + 1, 0);
+	algorithm::pfor(std::size_t(0), numBlocks, [&](std::size_t i) {
+		const char* blockBegin = bounds[i];
+		const char* blockEnd = bounds[i+1];
+		if (blockBegin == blockEnd) return;
+		firstLine[i+1] = std::count(blockBegin, blockEnd, '\n') + ((*(blockEnd - 1) != '\n') ? 1 : 0);
+	});
+	std::partial_sum(firstLine.begin(), firstLine.end(), firstLine.begin());
+
+	// process the lines of all blocks independently
+	algorithm::pfor(std::size_t(0), numBlocks, [&](std::size_t i) {
+		utils::TextReader reader(bounds[i], bounds[i+1]);
+		std::size_t line = firstLine[i];
+		while(reader.getPosition() != reader.getEnd()) {
+			auto current = reader.nextLine();
+			body(line++, current);
+		}
+	});
+
+	return firstLine.back();
+}
+
+// Process all lines of the given mapped text in parallel
+template<typename Body>
+std::size_t pforLines(const core::MemoryMappedInput& in, const Body& body, std::size_t blockSize = DEFAULT_TEXT_BLOCK_SIZE) {
+	in.advise(core::AccessHint::Sequential);
+	const char* begin = in.accessArray<char>();
+	return pforLines(begin, begin + in.size(), body, blockSize);
+}
+
+// Process all lines of a text entry in parallel, parsing them directly from the mapped content; returns the number of lines
+template<typename Manager, typename Body>
+std::size_t readLines(Manager& manager, core::Entry entry, const Body& body, std::size_t blockSize = DEFAULT_TEXT_BLOCK_SIZE) {
+	auto in = manager.shareMemoryMappedInput(entry);
+	auto res = pforLines(in, body, blockSize);
+	manager.close(in);
+	return res;
+}
+
+// Replace the content of an entry by the given number of lines, formatted in parallel by the body and written at their final positions
+template<typename Manager, typename Body>
+void writeLines(Manager& manager, core::Entry entry, std::size_t numLines, const Body& body, std::size_t linesPerBlock = DEFAULT_TEXT_LINES_PER_BLOCK) {
+	assert_lt(0u, linesPerBlock);
+
+	// format blocks of lines independently
+	std::size_t numBlocks = (numLines + linesPerBlock - 1) / linesPerBlock;
+	std::vector<utils::TextWriter> blocks(numBlocks);
+	algorithm::pfor(std::size_t(0), numBlocks, [&](std::size_t i) {
+		auto& out = blocks[i];
+		std::size_t end = std::min(numLines, (i + 1) * linesPerBlock);
+		for(std::size_t line = i * linesPerBlock; line < end; ++line) {
+			body(line, out);
+			out << '\n';
+		}
+	});
+
+	// compute the position of each block
+	std::vector<std::size_t> offsets(numBlocks + 1, 0);
+	for(std::size_t i = 0; i < numBlocks; ++i) {
+		offsets[i+1] = offsets[i] + blocks[i].size();
+	}
+
+	// fix the size of the entry and write blocks independently
+	manager.resize(entry, offsets.back());
+	algorithm::pfor(std::size_t(0), numBlocks, [&](std::size_t i) {
+		manager.writeAt(entry, offsets[i], blocks[i].data(), blocks[i].size());
+	});
+}
+
+} // end namespace user
+} // end namespace api
+} // end namespace allscale
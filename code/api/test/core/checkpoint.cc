@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "allscale/api/core/checkpoint.h"
+#include "allscale/api/user/data/grid.h"
+#include "allscale/api/user/data/scalar.h"
+
+namespace allscale {
+namespace api {
+namespace core {
+
+	using user::data::GridFragment;
+	using user::data::GridPoint;
+	using user::data::GridRegion;
+	using user::data::GridSharedData;
+
+	template<typename Manager>
+	void testCheckpointRestart(Manager& manager) {
+
+		GridPoint<2> size = { 100, 80 };
+		GridRegion<2> full(0, size);
+		GridSharedData<2> shared { size };
+
+		// a fragment covering the entire grid and one covering a part of it
+		GridFragment<int,2> a(shared, full);
+		GridFragment<double,2> b(shared, GridRegion<2>({10,10},{50,40}));
+		user::data::detail::ScalarFragment<int> s(core::no_shared_data(), true);
+
+		auto fill = [&](int step) {
+			full.scan([&](const GridPoint<2>& p) {
+				a[p] = step * 1000 + int(p[0] * size[1] + p[1]);
+			});
+			b.getCoveredRegion().scan([&](const GridPoint<2>& p) {
+				b[p] = step + p[0] * 0.5;
+			});
+			s.mask().set(step);
+		};
+
+		{
+			CheckpointManager<Manager> checkpoints(manager, "state");
+			checkpoints.add(a);
+			checkpoints.add(b);
+			checkpoints.add(s);
+
+			// the first checkpoint is a full one
+			fill(1);
+			checkpoints.checkpoint();
+			EXPECT_EQ(1, checkpoints.getChainLength());
+
+			// modifications after the checkpoint request do not affect it
+			fill(2);
+
+			// an incremental checkpoint stores only a written part of a
+			GridRegion<2> part({0,0},{10,80});
+			part.scan([&](const GridPoint<2>& p) {
+				a[p] = -1;
+			});
+			checkpoints.markWritten(a, part);
+			checkpoints.checkpoint();
+			EXPECT_EQ(2, checkpoints.getChainLength());
+
+			// this update is not checkpointed
+			fill(3);
+			checkpoints.wait();
+		}
+
+		// restore into fresh fragments
+		GridFragment<int,2> ra(shared, full);
+		GridFragment<double,2> rb(shared, GridRegion<2>({10,10},{50,40}));
+		user::data::detail::ScalarFragment<int> rs(core::no_shared_data(), true);
+		{
+			CheckpointManager<Manager> checkpoints(manager, "state");
+			checkpoints.add(ra);
+			checkpoints.add(rb);
+			checkpoints.add(rs);
+			EXPECT_TRUE(checkpoints.restore());
+			EXPECT_EQ(2, checkpoints.getChainLength());
+
+			// the state is the one of the first checkpoint, updated by the written part
+			int errors = 0;
+			full.scan([&](const GridPoint<2>& p) {
+				int expected = (p[0] < 10) ? -1 : 1000 + int(p[0] * size[1] + p[1]);
+				if (ra[p] != expected) errors++;
+			});
+			EXPECT_EQ(0, errors);
+			rb.getCoveredRegion().scan([&](const GridPoint<2>& p) {
+				if (rb[p] != 1 + p[0] * 0.5) errors++;
+			});
+			EXPECT_EQ(0, errors);
+			EXPECT_EQ(1, rs.mask().get());
+
+			// a new full checkpoint replaces the chain
+			rs.mask().set(4);
+			checkpoints.checkpoint(true);
+			EXPECT_EQ(1, checkpoints.getChainLength());
+		}
+
+		{
+			CheckpointManager<Manager> checkpoints(manager, "state");
+			checkpoints.add(ra);
+			checkpoints.add(rb);
+			checkpoints.add(rs);
+			EXPECT_TRUE(checkpoints.restore());
+			EXPECT_EQ(1, checkpoints.getChainLength());
+			EXPECT_EQ(4, rs.mask().get());
+		}
+
+		// a mismatching set of fragments is rejected
+		{
+			CheckpointManager<Manager> checkpoints(manager, "state");
+			checkpoints.add(ra);
+			EXPECT_FALSE(checkpoints.restore());
+		}
+
+		// as is a missing checkpoint
+		{
+			CheckpointManager<Manager> checkpoints(manager, "missing");
+			checkpoints.add(ra);
+			EXPECT_FALSE(checkpoints.restore());
+		}
+	}
+
+	template<typename Manager>
+	void testCheckpointRecovery(Manager& manager) {
+
+		GridPoint<2> size = { 20, 10 };
+		GridRegion<2> full(0, size);
+		GridSharedData<2> shared { size };
+		GridFragment<int,2> a(shared, full);
+
+		auto fill = [&](const GridRegion<2>& region, int value) {
+			region.scan([&](const GridPoint<2>& p) {
+				a[p] = value;
+			});
+		};
+
+		auto count = [&](int value) {
+			int res = 0;
+			full.scan([&](const GridPoint<2>& p) {
+				if (a[p] == value) res++;
+			});
+			return res;
+		};
+
+		auto exists = [&](const std::string& name) {
+			return manager.exists(manager.createEntry(name));
+		};
+
+		// create a chain of a full and an incremental checkpoint
+		{
+			CheckpointManager<Manager> checkpoints(manager, "recovery");
+			checkpoints.add(a);
+			fill(full, 1);
+			checkpoints.checkpoint();
+			fill(full, 2);
+			checkpoints.markWritten(a, full);
+			checkpoints.checkpoint();
+		}
+
+		// a manager over an existing chain replaces it by a full checkpoint if not restored
+		{
+			CheckpointManager<Manager> checkpoints(manager, "recovery");
+			checkpoints.add(a);
+			EXPECT_EQ(2, checkpoints.getChainLength());
+			fill(full, 3);
+			checkpoints.checkpoint();
+			EXPECT_EQ(1, checkpoints.getChainLength());
+		}
+
+		// a restored chain is extended by incremental checkpoints
+		GridRegion<2> part({0,0},{5,10});
+		{
+			CheckpointManager<Manager> checkpoints(manager, "recovery");
+			checkpoints.add(a);
+			fill(full, 0);
+			EXPECT_TRUE(checkpoints.restore());
+			EXPECT_EQ(200, count(3));
+			fill(part, 4);
+			checkpoints.markWritten(a, part);
+			checkpoints.checkpoint();
+			EXPECT_EQ(2, checkpoints.getChainLength());
+		}
+		{
+			CheckpointManager<Manager> checkpoints(manager, "recovery");
+			checkpoints.add(a);
+			fill(full, 0);
+			EXPECT_TRUE(checkpoints.restore());
+			EXPECT_EQ(50, count(4));
+			EXPECT_EQ(150, count(3));
+		}
+
+		// a torn manifest falls back to the previous one
+		manager.resize(manager.createEntry("recovery.manifest.1"), 10);
+		{
+			CheckpointManager<Manager> checkpoints(manager, "recovery");
+			checkpoints.add(a);
+			fill(full, 0);
+			EXPECT_TRUE(checkpoints.restore());
+			EXPECT_EQ(1, checkpoints.getChainLength());
+			EXPECT_EQ(200, count(3));
+
+			// and is replaced by the next update
+			fill(part, 5);
+			checkpoints.markWritten(a, part);
+			checkpoints.checkpoint();
+		}
+		{
+			CheckpointManager<Manager> checkpoints(manager, "recovery");
+			checkpoints.add(a);
+			fill(full, 0);
+			EXPECT_TRUE(checkpoints.restore());
+			EXPECT_EQ(2, checkpoints.getChainLength());
+			EXPECT_EQ(50, count(5));
+		}
+
+		// without any manifest, there is nothing to restore
+		manager.remove(manager.createEntry("recovery.manifest.0"));
+		manager.remove(manager.createEntry("recovery.manifest.1"));
+		{
+			CheckpointManager<Manager> checkpoints(manager, "recovery");
+			checkpoints.add(a);
+			fill(full, 0);
+			EXPECT_FALSE(checkpoints.restore());
+			EXPECT_EQ(200, count(0));
+		}
+
+		// clean up
+		for(auto name : { "recovery.0", "recovery.1", "recovery.2", "recovery.3" }) {
+			if (exists(name)) manager.remove(manager.createEntry(name));
+		}
+	}
+
+	TEST(CheckpointManager, Buffers) {
+		BufferIOManager manager;
+		testCheckpointRestart(manager);
+	}
+
+	TEST(CheckpointManager, BuffersRecovery) {
+		BufferIOManager manager;
+		testCheckpointRecovery(manager);
+	}
+
+	TEST(CheckpointManager, Files) {
+		auto& manager = FileIOManager::getInstance();
+		testCheckpointRestart(manager);
+
+		// the entries of the replaced chain have been removed
+		EXPECT_FALSE(manager.exists(manager.createEntry("state.0")));
+		EXPECT_FALSE(manager.exists(manager.createEntry("state.1")));
+		EXPECT_TRUE(manager.exists(manager.createEntry("state.2")));
+
+		// clean up
+		for(auto name : { "state.manifest.0", "state.manifest.1", "state.0", "state.1", "state.2" }) {
+			auto entry = manager.createEntry(name);
+			if (manager.exists(entry)) manager.remove(entry);
+		}
+	}
+
+	TEST(CheckpointManager, FilesRecovery) {
+		auto& manager = FileIOManager::getInstance();
+
+		// the replaced chain is removed once its replacement is completed
+		{
+			GridSharedData<1> shared { 10 };
+			GridFragment<int,1> a(shared, GridRegion<1>(0, 10));
+			CheckpointManager<FileIOManager> checkpoints(manager, "replaced");
+			checkpoints.add(a);
+			checkpoints.checkpoint();
+		}
+		{
+			GridSharedData<1> shared { 10 };
+			GridFragment<int,1> a(shared, GridRegion<1>(0, 10));
+			CheckpointManager<FileIOManager> checkpoints(manager, "replaced");
+			checkpoints.add(a);
+			checkpoints.checkpoint();
+		}
+		EXPECT_FALSE(manager.exists(manager.createEntry("replaced.0")));
+		EXPECT_TRUE(manager.exists(manager.createEntry("replaced.1")));
+		for(auto name : { "replaced.manifest.0", "replaced.manifest.1", "replaced.1" }) {
+			manager.remove(manager.createEntry(name));
+		}
+
+		testCheckpointRecovery(manager);
+	}
+
+} // end namespace core
+} // end namespace api
+} // end namespace allscale
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "allscale/api/core/impl/reference/io.h"
+
+namespace allscale {
+namespace api {
+namespace core {
+namespace impl {
+namespace reference {
+
+	std::string getContent(const ChunkedBuffer& buffer) {
+		std::string res(buffer.size(),' ');
+		EXPECT_EQ(buffer.size(), buffer.read(0,&res[0],res.size()));
+		return res;
+	}
+
+	TEST(ChunkedBuffer, Append) {
+
+		ChunkedBuffer buffer;
+		EXPECT_EQ(0,buffer.size());
+		EXPECT_EQ(0,buffer.getNumChunks());
+
+		// append more data than fits into a single chunk
+		std::string data;
+		for(int i=0; i<100000; i++) {
+			data += std::to_string(i);
+		}
+		for(std::size_t i=0; i<data.size(); i+=1000) {
+			buffer.append(data.c_str() + i, std::min<std::size_t>(1000, data.size() - i));
+		}
+
+		EXPECT_EQ(data.size(), buffer.size());
+		EXPECT_LT(1, buffer.getNumChunks());
+		EXPECT_EQ(data, getContent(buffer));
+
+		// all chunks but the last are full
+		for(std::size_t i=0; i<buffer.getNumChunks()-1; i++) {
+			EXPECT_EQ(buffer.getChunk(i).capacity, buffer.getChunk(i).size);
+		}
+	}
+
+	TEST(ChunkedBuffer, PositionalAccess) {
+
+		ChunkedBuffer buffer;
+
+		// write beyond the end, creating a zero-filled gap
+		const std::size_t offset = 3 * ChunkedBuffer::CHUNK_SIZE / 2;
+		buffer.write(offset, "Hello", 5);
+		EXPECT_EQ(offset + 5, buffer.size());
+
+		char data[10];
+		EXPECT_EQ(5, buffer.read(offset, data, 10));
+		EXPECT_EQ("Hello", std::string(data,5));
+		EXPECT_EQ(2, buffer.read(offset-2, data, 2));
+		EXPECT_EQ(std::string(2,'\0'), std::string(data,2));
+
+		// overwrite a range covering a chunk boundary
+		std::string text(1000, 'x');
+		const std::size_t boundary = buffer.getChunk(0).size;
+		buffer.write(boundary - 500, text.c_str(), text.size());
+		std::string content = getContent(buffer);
+		EXPECT_EQ(text, content.substr(boundary - 500, 1000));
+		EXPECT_EQ('\0', content[boundary - 501]);
+		EXPECT_EQ('\0', content[boundary + 500]);
+
+		// truncate within the first chunk and extend again
+		buffer.resize(boundary - 100);
+		EXPECT_EQ(1, buffer.getNumChunks());
+		buffer.resize(boundary + 100);
+		content = getContent(buffer);
+		EXPECT_EQ(std::string(400,'x'), content.substr(boundary - 500, 400));
+		EXPECT_EQ(std::string(200,'\0'), content.substr(boundary - 100));
+
+		// reads beyond the end obtain nothing
+		EXPECT_EQ(0, buffer.read(buffer.size(), data, 10));
+	}
+
+	TEST(ChunkedBuffer, Contiguous) {
+
+		ChunkedBuffer buffer;
+
+		// an empty buffer may be accessed
+		EXPECT_TRUE(buffer.getContiguous());
+
+		std::vector<int> data(100000);
+		for(std::size_t i=0; i<data.size(); i++) data[i] = (int)i;
+		buffer.append(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(int));
+		EXPECT_LT(1, buffer.getNumChunks());
+
+		// the content is consolidated once
+		const int* view = reinterpret_cast<const int*>(buffer.getContiguous());
+		EXPECT_EQ(1, buffer.getNumChunks());
+		EXPECT_EQ(data, std::vector<int>(view, view + data.size()));
+
+		// afterwards, the content is accessed directly
+		EXPECT_EQ((const char*)view, buffer.getContiguous());
+		EXPECT_EQ((const char*)view, buffer.resizeContiguous(sizeof(int)));
+
+		// growing preserves the prefix and clears the rest
+		auto grown = reinterpret_cast<const int*>(buffer.resizeContiguous(4 * sizeof(int)));
+		EXPECT_EQ(0, grown[0]);
+		EXPECT_EQ(0, grown[1]);
+		EXPECT_EQ(0, grown[3]);
+		EXPECT_EQ(4 * sizeof(int), buffer.size());
+	}
+
+	TEST(ChunkedBuffer, Streams) {
+
+		ChunkedBuffer buffer;
+
+		// write formatted and raw data
+		{
+			ChunkedBufferOutputStream out(buffer);
+			for(int i=0; i<100000; i++) {
+				out << i << " ";
+			}
+			std::string block(3 * ChunkedBuffer::CHUNK_SIZE, 'a');
+			out.write(block.c_str(), block.size());
+			out << " end";
+		}
+		EXPECT_LT(1, buffer.getNumChunks());
+
+		// read it back
+		ChunkedBufferInputStream in(buffer);
+		int x;
+		for(int i=0; i<100000; i++) {
+			EXPECT_TRUE(in >> x);
+			EXPECT_EQ(i,x);
+		}
+		std::string word;
+		EXPECT_TRUE(in >> word);
+		EXPECT_EQ(3 * ChunkedBuffer::CHUNK_SIZE, word.size());
+		EXPECT_TRUE(in >> word);
+		EXPECT_EQ("end", word);
+		EXPECT_FALSE(in >> word);
+
+		// a new output stream replaces the content
+		{
+			ChunkedBufferOutputStream out(buffer);
+			out << "new";
+		}
+		EXPECT_EQ("new", getContent(buffer));
+	}
+
+	TEST(AsyncStreamWriter, Formatting) {
+
+		std::stringstream target;
+		target << std::hex << std::setprecision(3) << std::fixed;
+
+		{
+			AsyncStreamWriter<OutputStream::OStreamWrapper> writer(target);
+			writer.atomic([](OutputStream::OStreamWrapper& out) {
+				out << 255 << " " << 0.5;
+			});
+		}
+
+		// buffered text is formatted like text written to the target directly
+		EXPECT_EQ("ff 0.500", target.str());
+	}
+
+} // end namespace reference
+} // end namespace impl
+} // end namespace core
+} // end namespace api
+} // end namespace allscale
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "allscale/api/core/impl/reference/task_id.h"
@@ -40,6 +41,25 @@ namespace reference {
 
 	}
 
+	TEST(TaskID, Serialization) {
+
+		EXPECT_TRUE(utils::is_serializable<TaskPath>::value);
+		EXPECT_TRUE(utils::is_serializable<TaskID>::value);
+
+		// the size of the serialized form is known at compile time
+		static_assert(utils::serialized_size<TaskID>::is_fixed, "Size of task IDs should be fixed.");
+		EXPECT_EQ(17,utils::serialized_size<TaskID>::value);
+
+		TaskID id = TaskID(12).getLeftChild().getRightChild().getRightChild();
+
+		auto archive = utils::serialize(id);
+		EXPECT_EQ(17,archive.getBuffer().size());
+
+		auto restored = utils::deserialize<TaskID>(archive);
+		EXPECT_EQ(id,restored);
+		EXPECT_EQ(toString(id),toString(restored));
+	}
+
 	TEST(TaskID, Basic) {
 
 		TaskID a = 12;
@@ -1,10 +1,22 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "allscale/api/core/io.h"
 #include "allscale/utils/serializer.h"
+#include "allscale/utils/serializer/strings.h"
+#include "allscale/utils/serializer/vectors.h"
 
 namespace allscale {
 namespace api {
@@ -141,6 +153,83 @@ namespace core {
 		manager.close(in);
 	}
 
+	TEST(IO, Buffers_Archive) {
+
+		BufferIOManager manager;
+
+		std::vector<int> data;
+		for(int i=0; i<10000; i++) {
+			data.push_back(i);
+		}
+
+		Entry binary = manager.createEntry("archive", Mode::Binary);
+		auto out = manager.openOutputStream(binary);
+		{
+			// stream through a buffer much smaller than the data
+			auto writer = out.createArchiveWriter(256);
+			writer.write(std::string("header"));
+			writer.write(data);
+			writer.write(12);
+		}
+		out.write(14);
+		manager.close(out);
+
+		auto in = manager.openInputStream(binary);
+		{
+			auto reader = in.createArchiveReader(256);
+			EXPECT_EQ("header",reader.read<std::string>());
+			EXPECT_EQ(data,reader.read<std::vector<int>>());
+			EXPECT_EQ(12,reader.read<int>());
+		}
+
+		// data read ahead by the reader is given back to the stream
+		EXPECT_TRUE(in);
+		EXPECT_EQ(14,in.read<int>());
+		manager.close(in);
+	}
+
+	TEST(IO, Buffers_Async) {
+
+		BufferIOManager manager;
+
+		Entry binary = manager.createEntry("async", Mode::Binary);
+		auto out = manager.openAsyncOutputStream(binary);
+		EXPECT_TRUE(out.isAsync());
+
+		// write records from many threads
+		const int N = 100000;
+		std::vector<std::thread> threads;
+		for(int t=0; t<4; t++) {
+			threads.emplace_back([&,t]{
+				auto out = manager.getOutputStream(binary);
+				for(int i=t; i<N; i+=4) {
+					out.atomic([&](auto& out) {
+						out.write(i);
+						out.write(i * 0.5);
+					});
+				}
+			});
+		}
+		for(auto& cur : threads) cur.join();
+
+		out.flush().wait();
+		manager.close(out);
+
+		// all records need to be present and intact
+		auto in = manager.openInputStream(binary);
+		std::vector<bool> seen(N,false);
+		for(int i=0; i<N; i++) {
+			int x = in.read<int>();
+			double y = in.read<double>();
+			ASSERT_LE(0,x);
+			ASSERT_LT(x,N);
+			EXPECT_FALSE(seen[x]);
+			EXPECT_EQ(x * 0.5,y);
+			seen[x] = true;
+		}
+		manager.close(in);
+	}
+
 	TEST(IO, File_Text) {
 
 		FileIOManager& manager = FileIOManager::getInstance();
@@ -220,6 +309,262 @@ namespace core {
 
 	}
 
+	TEST(IO, File_Async) {
+
+		FileIOManager& manager = FileIOManager::getInstance();
+
+		Entry text = manager.createEntry("async.txt", Mode::Text);
+		auto out = manager.openAsyncOutputStream(text);
+
+		out << "Hello";
+		out.atomic([](auto& out) {
+			out << " World";
+		});
+
+		// after flushing, the data is in the file
+		out.flush().wait();
+		{
+			std::ifstream file("async.txt");
+			std::string content;
+			std::getline(file,content);
+			EXPECT_EQ("Hello World",content);
+		}
+
+		manager.close(out);
+		manager.remove(text);
+		EXPECT_PRED1(notExists, "async.txt");
+	}
+
+	TEST(IO, Buffers_Positional) {
+
+		BufferIOManager manager;
+
+		Entry entry = manager.createEntry("positional", Mode::Binary);
+
+		// write blocks out of order, leaving a gap
+		manager.writeAt(entry, 6, "World", 5);
+		manager.writeAt(entry, 0, "Hello", 5);
+
+		char buffer[16];
+		EXPECT_EQ(11, manager.readAt(entry, 0, buffer, 16));
+		EXPECT_EQ(std::string("Hello\0World",11), std::string(buffer,11));
+
+		// the content is also visible to streams
+		manager.writeAt(entry, 5, " ", 1);
+		auto in = manager.openInputStream(entry);
+		std::string word;
+		in >> word;
+		EXPECT_EQ("Hello",word);
+		manager.close(in);
+
+		// reads beyond the end are truncated
+		EXPECT_EQ(5, manager.readAt(entry, 6, buffer, 16));
+		EXPECT_EQ(0, manager.readAt(entry, 20, buffer, 16));
+
+		// resizing drops the tail
+		manager.resize(entry, 5);
+		EXPECT_EQ(5, manager.readAt(entry, 0, buffer, 16));
+	}
+
+	TEST(IO, File_Positional) {
+
+		FileIOManager& manager = FileIOManager::getInstance();
+
+		Entry entry = manager.createEntry("positional.dat", Mode::Binary);
+
+		// write blocks concurrently from different threads
+		const int N = 8;
+		const int M = 1000;
+		std::vector<std::thread> threads;
+		for(int t=0; t<N; t++) {
+			threads.emplace_back([&,t]{
+				std::vector<int> data(M,t);
+				manager.writeAt(entry, t * M * sizeof(int), reinterpret_cast<const char*>(data.data()), M * sizeof(int));
+			});
+		}
+		for(auto& cur : threads) cur.join();
+
+		EXPECT_PRED1(exists, "positional.dat");
+
+		// read the data back in reverse order
+		std::vector<int> data(N*M);
+		for(int t=N-1; t>=0; t--) {
+			EXPECT_EQ(M * sizeof(int), manager.readAt(entry, t * M * sizeof(int), reinterpret_cast<char*>(&data[t*M]), M * sizeof(int)));
+		}
+		for(int i=0; i<N*M; i++) {
+			EXPECT_EQ(i / M, data[i]) << "Position: " << i;
+		}
+
+		// shrink the file
+		manager.resize(entry, sizeof(int));
+		EXPECT_EQ(sizeof(int), manager.readAt(entry, 0, reinterpret_cast<char*>(data.data()), N * M * sizeof(int)));
+
+		manager.remove(entry);
+		EXPECT_PRED1(notExists, "positional.dat");
+	}
+
+	template<typename Manager>
+	void testChunkedIO(Manager& manager, const std::string& name) {
+
+		Entry entry = manager.createEntry(name, Mode::Binary);
+
+		// a buffer not aligned to the chunk size
+		std::vector<char> data(10000 + 17);
+		for(std::size_t i = 0; i < data.size(); ++i) {
+			data[i] = (char)(i * 7);
+		}
+
+		// a stale, larger content is truncated
+		std::vector<char> stale(2 * data.size(), 'x');
+		manager.writeChunked(entry, stale.data(), stale.size(), 4096);
+		manager.writeChunked(entry, data.data(), data.size(), 1000);
+
+		std::vector<char> loaded(stale.size());
+		EXPECT_EQ(data.size(), manager.readChunked(entry, loaded.data(), loaded.size(), 1024));
+		loaded.resize(data.size());
+		EXPECT_EQ(data, loaded);
+
+		manager.remove(entry);
+	}
+
+	TEST(IO, Buffers_Chunked) {
+		BufferIOManager manager;
+		testChunkedIO(manager, "chunked");
+	}
+
+	TEST(IO, File_Chunked) {
+		testChunkedIO(FileIOManager::getInstance(), "chunked.dat");
+		EXPECT_PRED1(notExists, "chunked.dat");
+	}
+
+	TEST(IO, SharedHandles) {
+
+		BufferIOManager manager;
+
+		Entry entry = manager.createEntry("shared", Mode::Binary);
+
+		// opening an open entry has no effect, the first close closes it
+		auto out = manager.openOutputStream(entry);
+		out.write(1);
+		manager.openOutputStream(entry).write(2);
+		manager.close(out);
+
+		auto in = manager.openInputStream(entry);
+		EXPECT_EQ(1,in.read<int>());
+		EXPECT_EQ(2,in.read<int>());
+		manager.close(in);
+
+		// two tasks sharing the same entry share the stream
+		auto out1 = manager.shareOutputStream(entry);
+		auto out2 = manager.shareOutputStream(entry);
+		out1.write(3);
+
+		// the stream remains open until both have closed it
+		manager.close(out1);
+		out2.write(4);
+		manager.close(out2);
+
+		auto in2 = manager.openInputStream(entry);
+		EXPECT_EQ(3,in2.read<int>());
+		EXPECT_EQ(4,in2.read<int>());
+		manager.close(in2);
+
+		// the same holds for memory mapped outputs
+		auto mm1 = manager.shareMemoryMappedOutput(entry,sizeof(int));
+		auto mm2 = manager.shareMemoryMappedOutput(entry,sizeof(int));
+		EXPECT_EQ(mm1.accessArray<int>(),mm2.accessArray<int>());
+		manager.close(mm1);
+		EXPECT_EQ(mm2.accessArray<int>(),manager.getMemoryMappedOutput(entry).accessArray<int>());
+		manager.close(mm2);
+	}
+
+	TEST(IO, File_RemoveDuringPositional) {
+
+		FileIOManager& manager = FileIOManager::getInstance();
+
+		Entry entry = manager.createEntry("io_test_removed.dat", Mode::Binary);
+
+		// positional writes racing with the removal of their entry
+		std::atomic<bool> done(false);
+		std::vector<std::thread> threads;
+		for(int t=0; t<4; t++) {
+			threads.emplace_back([&,t]{
+				std::vector<int> data(1000,t);
+				while(!done) {
+					manager.writeAt(entry, t * sizeof(int) * data.size(), reinterpret_cast<const char*>(data.data()), sizeof(int) * data.size());
+				}
+			});
+		}
+		for(int i=0; i<100; i++) {
+			manager.remove(entry);
+		}
+		done = true;
+		for(auto& cur : threads) cur.join();
+
+		// the entry remains usable
+		manager.writeAt(entry, 0, "Hello", 5);
+		char buffer[5];
+		EXPECT_EQ(5, manager.readAt(entry, 0, buffer, 5));
+		EXPECT_EQ("Hello", std::string(buffer,5));
+
+		manager.remove(entry);
+		EXPECT_PRED1(notExists, "io_test_removed.dat");
+	}
+
+	template<typename Manager>
+	void testConcurrentPartitions(Manager& manager, const std::string& prefix) {
+		const int T = 8;
+		const int N = 50;
+
+		auto name = [&](int t, int i) {
+			return prefix + std::to_string(t) + "_" + std::to_string(i) + ".dat";
+		};
+
+		// each thread creates, writes, and closes its own entries
+		std::vector<std::thread> threads;
+		for(int t=0; t<T; t++) {
+			threads.emplace_back([&,t]{
+				for(int i=0; i<N; i++) {
+					Entry entry = manager.createEntry(name(t,i), Mode::Binary);
+					auto out = manager.openOutputStream(entry);
+					out.write(t);
+					out.write(i);
+					manager.close(out);
+				}
+			});
+		}
+		for(auto& cur : threads) cur.join();
+		threads.clear();
+
+		// read and delete the entries concurrently
+		std::atomic<int> errors(0);
+		for(int t=0; t<T; t++) {
+			threads.emplace_back([&,t]{
+				for(int i=0; i<N; i++) {
+					Entry entry = manager.createEntry(name(t,i), Mode::Binary);
+					auto in = manager.openInputStream(entry);
+					if (in.template read<int>() != t) errors++;
+					if (in.template read<int>() != i) errors++;
+					manager.close(in);
+					manager.remove(entry);
+				}
+			});
+		}
+		for(auto& cur : threads) cur.join();
+
+		EXPECT_EQ(0,errors);
+	}
+
+	TEST(IO, Buffers_ConcurrentPartitions) {
+		BufferIOManager manager;
+		testConcurrentPartitions(manager, "part_");
+	}
+
+	TEST(IO, File_ConcurrentPartitions) {
+		testConcurrentPartitions(FileIOManager::getInstance(), "io_test_part_");
+		EXPECT_PRED1(notExists, "io_test_part_0_0.dat");
+	}
+
 	TEST(IO, MemoryMappedBuffers) {
 
 		using data = std::array<int,1000>;
@@ -251,8 +596,133 @@ namespace core {
 
 	}
 
+	TEST(IO, MemoryMappedBuffers_Streams) {
+
+		BufferIOManager mgr;
+
+		auto entry = mgr.createEntry("shared", Mode::Binary);
+
+		// write data through a stream
+		auto out = mgr.openOutputStream(entry);
+		for(int i=0; i<100000; i++) {
+			out.write(i);
+		}
+		mgr.close(out);
+
+		// map the written data
+		auto in = mgr.openMemoryMappedInput(entry);
+		EXPECT_EQ(100000*sizeof(int),in.size());
+		const int* data = in.accessArray<int>();
+		for(int i=0; i<100000; i++) {
+			EXPECT_EQ(i,data[i]);
+		}
+		mgr.close(in);
+
+		// mapping it again provides the same memory
+		auto in2 = mgr.openMemoryMappedInput(entry);
+		EXPECT_EQ(data,in2.accessArray<int>());
+		mgr.close(in2);
+
+		// data written through a mapping is visible to streams
+		auto mm = mgr.openMemoryMappedOutput(entry,2*sizeof(int));
+		mm.accessArray<int>()[1] = 42;
+		mgr.close(mm);
+
+		auto sin = mgr.openInputStream(entry);
+		EXPECT_EQ(0,sin.read<int>());
+		EXPECT_EQ(42,sin.read<int>());
+		mgr.close(sin);
+	}
+
+	TEST(IO, MemoryMappedBuffers_Resize) {
+
+		BufferIOManager mgr;
+
+		auto entry = mgr.createEntry("growing");
+
+		// start with a small buffer
+		auto out = mgr.openMemoryMappedOutput(entry,10*sizeof(int));
+		EXPECT_EQ(10*sizeof(int),out.size());
+		for(int i=0; i<10; i++) {
+			out.accessArray<int>()[i] = i;
+		}
+
+		// extend it
+		out = mgr.resizeMemoryMappedOutput(out,1000*sizeof(int));
+		EXPECT_EQ(1000*sizeof(int),out.size());
+		int* data = out.accessArray<int>();
+		for(int i=0; i<1000; i++) {
+			EXPECT_EQ((i<10) ? i : 0, data[i]);
+		}
+
+		// hints and prefetching have no effect on buffers
+		out.advise(AccessHint::Sequential);
+		out.prefetch().wait();
+
+		mgr.close(out);
+
+		// the new size is visible to readers
+		auto in = mgr.openMemoryMappedInput(entry);
+		EXPECT_EQ(1000*sizeof(int),in.size());
+		EXPECT_EQ(9,in.accessArray<int>()[9]);
+		mgr.close(in);
+	}
+
 #ifndef _MSC_VER
 
+	TEST(IO, MemoryMappedFiles_Resize) {
+
+		FileIOManager& mgr = FileIOManager::getInstance();
+
+		auto entry = mgr.createEntry("growing.dat", Mode::Binary);
+
+		// grow the output step by step, as if its final size was not known
+		std::size_t N = 1 << 20;
+		auto out = mgr.openMemoryMappedOutput(entry,sizeof(int));
+		for(std::size_t i=0; i<N; i++) {
+			if ((i+1)*sizeof(int) > out.size()) {
+				out = mgr.resizeMemoryMappedOutput(out,2*out.size());
+			}
+			out.accessArray<int>()[i] = (int)i;
+		}
+
+		// shrink to the final size
+		out = mgr.resizeMemoryMappedOutput(out,N*sizeof(int));
+		mgr.close(out);
+
+		struct stat fileStat;
+		EXPECT_EQ(0,stat("growing.dat",&fileStat));
+		EXPECT_EQ(N*sizeof(int),(std::size_t)fileStat.st_size);
+
+		// read the data with access hints and prefetching
+		auto in = mgr.openMemoryMappedInput(entry);
+		EXPECT_EQ(N*sizeof(int),in.size());
+		in.advise(AccessHint::Random);
+		in.advise(AccessHint::HugePages);
+		in.advise(AccessHint::Sequential, 100, 1000);
+		auto done = in.prefetch(17, N);
+		done.wait();
+
+		const int* data = in.accessArray<int>();
+		for(std::size_t i=0; i<N; i++) {
+			if (data[i] != (int)i) {
+				EXPECT_EQ(i,data[i]);
+				break;
+			}
+		}
+
+		// hints outside the mapped range are ignored
+		in.advise(AccessHint::DontNeed, N*sizeof(int), 100);
+		in.prefetch(N*sizeof(int)).wait();
+
+		// dropping pages does not lose data
+		in.advise(AccessHint::DontNeed);
+		EXPECT_EQ(N-1,data[N-1]);
+
+		mgr.close(in);
+		mgr.remove(entry);
+	}
+
 	TEST(IO, MemoryMappedFiles) {
 		static const size_t N = 1000u;
 
@@ -298,6 +768,77 @@ namespace core {
 #endif
 
 
+	TEST(DISABLED_IO, BufferBenchmark) {
+
+		// data size: 256MB
+		const int N = 64*1024*1024;
+		const int R = 3;
+
+		auto time = [](const std::string& name, const auto& op) {
+			auto begin = std::chrono::high_resolution_clock::now();
+			op();
+			auto end = std::chrono::high_resolution_clock::now();
+			std::cout << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+		};
+
+		for(int r=0; r<R; r++) {
+
+			// -- the string stream based approach, as utilized by the former buffer IO manager --
+
+			time("stringstream - round trip", [&]{
+				std::stringstream out(std::ios_base::out | std::ios_base::binary);
+				for(int i=0; i<N; i++) {
+					out.write(reinterpret_cast<const char*>(&i),sizeof(int));
+				}
+
+				// opening an input stream copied the content
+				std::stringstream in(out.str(), std::ios_base::in | std::ios_base::binary);
+				long long sum = 0;
+				for(int i=0; i<N; i++) {
+					int x;
+					in.read(reinterpret_cast<char*>(&x),sizeof(int));
+					sum += x;
+				}
+				EXPECT_EQ((long long)N*(N-1)/2,sum);
+
+				// mapping the content copied it to a separate buffer
+				std::string content = in.str();
+				std::unique_ptr<char[]> mapped(new char[content.size()]);
+				std::memcpy(mapped.get(),content.c_str(),content.size());
+				EXPECT_EQ(N-1,reinterpret_cast<const int*>(mapped.get())[N-1]);
+			});
+
+			// -- the chunked buffer based IO manager --
+
+			time("BufferIOManager - round trip", [&]{
+				BufferIOManager mgr;
+				auto entry = mgr.createEntry("data", Mode::Binary);
+
+				auto out = mgr.openOutputStream(entry);
+				out.atomic([&](auto& out) {
+					for(int i=0; i<N; i++) {
+						out.write(i);
+					}
+				});
+				mgr.close(out);
+
+				auto in = mgr.openInputStream(entry);
+				long long sum = 0;
+				in.atomic([&](auto& in) {
+					for(int i=0; i<N; i++) {
+						sum += in.template read<int>();
+					}
+				});
+				mgr.close(in);
+				EXPECT_EQ((long long)N*(N-1)/2,sum);
+
+				auto mapped = mgr.openMemoryMappedInput(entry);
+				EXPECT_EQ(N-1,mapped.accessArray<int>()[N-1]);
+				mgr.close(mapped);
+			});
+		}
+	}
+
 	TEST(DISABLED_IO, LargeFile) {
 
 		// file size: 1GB
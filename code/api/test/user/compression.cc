@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "allscale/api/user/compression.h"
+#include "allscale/utils/serializer/strings.h"
+#include "allscale/utils/serializer/vectors.h"
+
+namespace allscale {
+namespace api {
+namespace user {
+
+	TEST(Compression, Parallel) {
+
+		std::vector<double> field(200000);
+		for(std::size_t i = 0; i < field.size(); ++i) field[i] = std::cos(i * 0.0001);
+		auto data = reinterpret_cast<const char*>(field.data());
+		std::size_t size = field.size() * sizeof(double);
+
+		utils::CompressionOptions options;
+		options.chunkSize = 16 * 1024;
+
+		// the parallel compression produces the same chunks as the sequential one
+		auto compressed = parallelCompress(data, size, options);
+		EXPECT_EQ(utils::compress(data, size, options), compressed);
+		EXPECT_LT(compressed.size(), size);
+
+		// and gets decompressed exactly
+		std::vector<char> res;
+		EXPECT_TRUE(parallelDecompress(compressed.data(), compressed.size(), res));
+		EXPECT_EQ(std::vector<char>(data, data + size), res);
+
+		// malformed data is detected
+		res.clear();
+		EXPECT_FALSE(parallelDecompress(compressed.data(), compressed.size() - 3, res));
+
+		// empty inputs are supported
+		EXPECT_TRUE(parallelCompress(data, 0).empty());
+		res.clear();
+		EXPECT_TRUE(parallelDecompress(nullptr, 0, res));
+		EXPECT_TRUE(res.empty());
+	}
+
+	template<typename Manager>
+	void testCompressedStreams(Manager& manager) {
+
+		std::vector<int> values(300000);
+		for(std::size_t i = 0; i < values.size(); ++i) values[i] = int(i / 7);
+		std::vector<std::string> names(1000, "name");
+
+		utils::CompressionOptions options;
+		options.filter = utils::CompressionFilter::DeltaShuffle;
+		options.elementSize = 4;
+		options.chunkSize = 8 * 1024;
+
+		// some data following the compressed one in the same stream
+		std::string trailer = "trailing data";
+
+		auto entry = manager.createEntry("compressed.bin", core::Mode::Binary);
+		{
+			core::OutputStream out = manager.openOutputStream(entry);
+			{
+				utils::ArchiveWriter writer = createCompressingWriter(out, options, 4);
+				writer.write(values);
+				writer.write(names);
+				writer.write(42);
+			}
+			out.write(trailer.data(), trailer.size());
+			manager.close(out);
+		}
+
+		// the data has been compressed
+		{
+			core::MemoryMappedInput in = manager.openMemoryMappedInput(entry);
+			EXPECT_LT(in.size() * 10, values.size() * sizeof(int));
+			manager.close(in);
+		}
+
+		// the parallel reader restores it exactly
+		{
+			core::InputStream in = manager.openInputStream(entry);
+			{
+				utils::ArchiveReader reader = createDecompressingReader(in, 3);
+				EXPECT_EQ(values, reader.read<std::vector<int>>());
+				EXPECT_EQ(names, reader.read<std::vector<std::string>>());
+				EXPECT_EQ(42, reader.read<int>());
+			}
+			std::string rest(trailer.size(), ' ');
+			EXPECT_EQ(trailer.size(), in.read(&rest[0], rest.size()));
+			EXPECT_EQ(trailer, rest);
+			manager.close(in);
+		}
+
+		// as does the sequential one
+		{
+			core::InputStream in = manager.openInputStream(entry);
+			{
+				utils::ArchiveReader reader = utils::createDecompressingReader([&](char* dst, std::size_t count) {
+					return in.read(dst, count);
+				});
+				EXPECT_EQ(values, reader.read<std::vector<int>>());
+			}
+			std::string rest(trailer.size(), ' ');
+			EXPECT_EQ(trailer.size(), in.read(&rest[0], rest.size()));
+			EXPECT_EQ(trailer, rest);
+			manager.close(in);
+		}
+
+		manager.remove(entry);
+	}
+
+	TEST(Compression, BufferStreams) {
+		core::BufferIOManager manager;
+		testCompressedStreams(manager);
+	}
+
+	TEST(Compression, FileStreams) {
+		testCompressedStreams(core::FileIOManager::getInstance());
+	}
+
+	TEST(DISABLED_Compression, Benchmark) {
+
+		// 64M doubles of a smooth field
+		const std::size_t N = 64 * 1024 * 1024;
+		std::vector<double> field(N);
+		for(std::size_t i = 0; i < N; ++i) field[i] = std::sin(i * 1e-6) * 1000;
+		auto data = reinterpret_cast<const char*>(field.data());
+		std::size_t size = N * sizeof(double);
+
+		auto time = [](const std::string& name, const auto& op) {
+			auto begin = std::chrono::high_resolution_clock::now();
+			op();
+			auto end = std::chrono::high_resolution_clock::now();
+			std::cout << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+		};
+
+		for(auto filter : { utils::CompressionFilter::None, utils::CompressionFilter::Shuffle, utils::CompressionFilter::DeltaShuffle }) {
+			utils::CompressionOptions options;
+			options.filter = filter;
+			std::cout << "Filter " << int(filter) << ":\n";
+
+			std::vector<char> compressed;
+			time("  compress", [&]{
+				compressed = parallelCompress(data, size, options);
+			});
+			std::cout << "  ratio: " << double(size) / compressed.size() << "\n";
+
+			std::vector<char> res;
+			time("  decompress", [&]{
+				EXPECT_TRUE(parallelDecompress(compressed.data(), compressed.size(), res));
+			});
+			EXPECT_EQ(size, res.size());
+		}
+	}
+
+} // end namespace user
+} // end namespace api
+} // end namespace allscale
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
 #include "allscale/api/user/data/grid.h"
 #include "allscale/utils/string_utils.h"
 
@@ -13,6 +17,16 @@ namespace data {
 
 	#include "data_item_test.inl"
 
+	namespace {
+
+		// a path for a temporary file of the given name, placed in the temp directory instead of the working directory
+		std::string getTempFile(const std::string& name) {
+			const char* dir = std::getenv("TMPDIR");
+			return std::string((dir && *dir) ? dir : "/tmp") + "/" + name;
+		}
+
+	}
+
 	TEST(GridPoint,Basic) {
 
 		GridPoint<1> a = 3;
@@ -68,6 +82,25 @@ namespace data {
 
 	}
 
+	TEST(GridBox,Serialization) {
+
+		using box = GridBox<3>;
+
+		EXPECT_TRUE(utils::is_serializable<box>::value);
+		EXPECT_TRUE(utils::is_trivially_serializable<box>::value);
+		EXPECT_EQ(6 * sizeof(coordinate_type),utils::serialized_size<box>::value);
+
+		box b({1,2,3},{4,5,6});
+		auto archive = utils::serialize(b);
+		EXPECT_EQ(6 * sizeof(coordinate_type),archive.getBuffer().size());
+		EXPECT_EQ(b,utils::deserialize<box>(archive));
+
+		// regions are serialized as vectors of boxes
+		GridRegion<3> r = GridRegion<3>::merge(b,box({5,5,5},{8,8,8}));
+		auto archive2 = utils::serialize(r);
+		EXPECT_EQ(r,utils::deserialize<GridRegion<3>>(archive2));
+	}
+
 	TEST(GridBox1D,IsIntersecting) {
 
 		using Box = GridBox<1>;
@@ -860,6 +893,106 @@ namespace data {
 
 	}
 
+	TEST(Grid3D, HugePagesAndPrefault) {
+
+		GridPoint<3> size = {50,60,70};
+
+		// create a grid backed by huge pages
+		Grid<double,3> grid(size, utils::PagingPolicy::HugePages);
+		EXPECT_EQ(size, grid.size());
+
+		// populate its memory in parallel
+		grid.prefault();
+
+		// the grid is usable as usual
+		grid.pforEach([](double& x) { x = 1.0; });
+
+		double sum = 0;
+		grid.forEach([&](double x) { sum += x; });
+		EXPECT_EQ(50*60*70, sum);
+
+	}
+
+	TEST(Grid3D, FileBacked) {
+
+		const std::string file = getTempFile("grid_file_backed.bin");
+
+		GridPoint<3> size = {50,60,70};
+
+		{
+			// create a grid stored in a file
+			Grid<double,3> grid(size, file);
+
+			grid.pforEach([](double& x) { x = 2.0; });
+			grid.flush();
+
+			double sum = 0;
+			grid.forEach([&](double x) { sum += x; });
+			EXPECT_EQ(2*50*60*70, sum);
+		}
+
+		// the data is persisted in the file
+		{
+			Grid<double,3> grid(size, file);
+			EXPECT_EQ(2.0, (grid[{49,59,69}]));
+		}
+
+		std::remove(file.c_str());
+	}
+
+	TEST(GridFragment3D, FileBacked) {
+
+		const std::string file = getTempFile("grid_fragment_file_backed.bin");
+
+		GridPoint<3> size = {50,60,70};
+		GridRegion<3> a({5,6,7},{20,30,40});
+		GridRegion<3> b({15,25,35},{45,55,65});
+
+		{
+			GridFragment<int,3> fragment({ size }, a, file);
+			EXPECT_TRUE(fragment.isFileBacked());
+
+			a.scan([&](const GridPoint<3>& p) { fragment[p] = 12; });
+
+			// grow and shrink the covered region
+			fragment.resize(GridRegion<3>::merge(a,b));
+			fragment.resize(b);
+			EXPECT_EQ(b, fragment.getCoveredRegion());
+
+			// the shared part is preserved
+			GridRegion<3>::intersect(a,b).scan([&](const GridPoint<3>& p) {
+				EXPECT_EQ(12, fragment[p]);
+			});
+
+			fragment.advise(utils::AccessPattern::WillNeed);
+			fragment.flush();
+		}
+
+		std::remove(file.c_str());
+	}
+
+	TEST(GridFragment3D, Prefault) {
+
+		GridPoint<3> size = {50,60,70};
+
+		// a fragment covering a ragged region
+		GridRegion<3> region = GridRegion<3>::merge(GridRegion<3>({5,6,7},{20,30,40}), GridRegion<3>({15,25,35},{45,55,65}));
+		GridFragment<int,3> fragment({ size }, region);
+
+		// prefaulting must be possible without altering the covered region
+		fragment.prefault();
+		EXPECT_EQ(region, fragment.getCoveredRegion());
+
+		region.scan([&](const GridPoint<3>& p) {
+			fragment[p] = 12;
+		});
+
+		region.scan([&](const GridPoint<3>& p) {
+			EXPECT_EQ(12, fragment[p]);
+		});
+
+	}
+
 	struct InstanceCounted {
 
 		static int num_instances;
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <set>
+
 #include "allscale/api/core/data.h"
 #include "allscale/api/user/data/mesh.h"
 #include "allscale/utils/string_utils.h"
@@ -246,6 +251,60 @@ namespace data {
 
 	}
 
+	TEST(MeshData, FragmentTransfer) {
+
+		using namespace detail;
+
+		auto mesh = createBarMesh(100);
+
+		using facade = decltype(mesh.createNodeData<Vertex,int>());
+		using fragment = typename facade::fragment_type;
+		using region = typename fragment::region_type;
+		using shared_data = typename fragment::shared_data_type;
+
+		const shared_data& shared = mesh.getPartitionTree();
+
+		SubMeshRef r = SubMeshRef::root();
+		MeshRegion partA = r.getLeftChild();
+		MeshRegion partB = r.getRightChild();
+		MeshRegion partC {
+			r.getLeftChild().getRightChild(),
+			r.getRightChild().getLeftChild()
+		};
+
+		// create and fill source fragments
+		fragment fA(shared,partA);
+		fragment fB(shared,partB);
+
+		auto a = fA.mask();
+		partA.scan<Vertex,0>(shared,[&](const NodeRef<Vertex,0>& node) {
+			a[node] = node.getOrdinal();
+		});
+
+		auto b = fB.mask();
+		partB.scan<Vertex,0>(shared,[&](const NodeRef<Vertex,0>& node) {
+			b[node] = node.getOrdinal();
+		});
+
+		// transfer data from A directly and from B through an archive
+		fragment fC(shared,partC);
+		fC.insert(fA,region::intersect(partC,partA));
+
+		utils::ArchiveWriter writer;
+		fB.extract(writer,region::intersect(partC,partB));
+		auto archive = std::move(writer).toArchive();
+		utils::ArchiveReader reader(archive);
+		fC.insert(reader);
+
+		auto c = fC.mask();
+		int count = 0;
+		partC.scan<Vertex,0>(shared,[&](const NodeRef<Vertex,0>& node) {
+			EXPECT_EQ(int(node.getOrdinal()),c[node]);
+			count++;
+		});
+		EXPECT_EQ(50,count);
+	}
+
 	TEST(Mesh, TypeProperties) {
 
 		struct Cell {};
@@ -287,6 +346,41 @@ namespace data {
 		builder.link<Tree>(root,cell);
 	}
 
+	TEST(MeshBuilder, BuildFromTemporary) {
+
+		struct Cell {};
+		struct Edge : public edge<Cell,Cell> {};
+		struct Tree : public hierarchy<Cell,Cell> {};
+
+		using Builder = MeshBuilder<nodes<Cell>,edges<Edge>,hierarchies<Tree>,2>;
+
+		// a ring of cells, pairwise refining a coarser ring
+		const int N = 16;
+		auto create = [&]() {
+			Builder builder;
+			auto cells = builder.create<Cell>(N);
+			auto roots = builder.create<Cell,1>(N/2);
+			for(int i = 0; i < N; i++) {
+				builder.link<Edge>(cells[i],cells[(i+1)%N]);
+				builder.link<Tree>(roots[i/2],cells[i]);
+			}
+			return builder;
+		};
+
+		// consuming the builder closes the topology just as building from a retained one
+		auto retained = create();
+		auto a = retained.build<detail::NaiveMeshPartitioner,2>(detail::NaiveMeshPartitioner());
+		auto b = create().build<detail::NaiveMeshPartitioner,2>(detail::NaiveMeshPartitioner());
+		b.forAll<Cell>([&](const auto& cell) {
+			ASSERT_EQ(1,b.getSinks<Edge>(cell).size());
+			EXPECT_EQ(*a.getSinks<Edge>(cell).begin(),*b.getSinks<Edge>(cell).begin());
+			EXPECT_EQ((a.getParent<Tree>(cell)),(b.getParent<Tree>(cell)));
+		});
+		b.forAll<Cell,1>([&](const auto& cell) {
+			EXPECT_EQ(2,(b.getChildren<Tree>(cell).size()));
+		});
+	}
+
 
 	TEST(MeshData, Basic) {
 
@@ -1138,6 +1232,26 @@ namespace data {
 	}
 
 
+	TEST(MeshRegion, Serialization) {
+
+		using namespace detail;
+
+		EXPECT_TRUE(utils::is_serializable<SubMeshRef>::value);
+		EXPECT_TRUE(utils::is_serializable<MeshRegion>::value);
+
+		SubMeshRef r = SubMeshRef::root();
+
+		MeshRegion a { r.getLeftChild().getLeftChild(), r.getRightChild().getRightChild() };
+		MeshRegion b { r.getLeftChild().getRightChild(), r.getRightChild().getRightChild() };
+
+		for(const auto& cur : { MeshRegion(), MeshRegion(r), a, b }) {
+			auto archive = utils::serialize(cur);
+			auto restored = utils::deserialize<MeshRegion>(archive);
+			EXPECT_EQ(cur,restored);
+			EXPECT_EQ(toString(cur),toString(restored));
+		}
+	}
+
 	TEST(MeshRegion, Scan) {
 
 		using namespace detail;
@@ -1499,6 +1613,56 @@ namespace data {
 
 	}
 
+	TEST(Mesh,MappedIO) {
+
+		using Mesh = detail::plain_type<decltype(createBarMesh<2,2>(5))>;
+
+		auto& manager = core::FileIOManager::getInstance();
+		auto entry = manager.createEntry("mesh_mapped.bin",core::Mode::Binary);
+
+		{ // -- creation --
+
+			auto bar = createBarMesh<2,2>(5);
+			bar.storeTo("mesh_mapped.bin");
+		}
+
+		{ // -- map the mesh into memory --
+
+			auto bar = Mesh::mapFrom("mesh_mapped.bin");
+			ASSERT_TRUE(bar);
+
+			// check the content of the mesh
+			checkMesh(*bar);
+
+			// the mesh may be mapped multiple times
+			auto other = Mesh::mapFrom("mesh_mapped.bin");
+			ASSERT_TRUE(other);
+			checkMesh(*other);
+		}
+
+		// meshes of other types are rejected
+		using OtherDepth = detail::plain_type<decltype(createBarMesh<2,3>(5))>;
+		using OtherLevels = detail::plain_type<decltype(createBarMesh<3,2>(5))>;
+		EXPECT_FALSE(OtherDepth::mapFrom("mesh_mapped.bin"));
+		EXPECT_FALSE(OtherLevels::mapFrom("mesh_mapped.bin"));
+
+		// as are missing files
+		EXPECT_FALSE(Mesh::mapFrom("mesh_missing.bin"));
+
+		// and truncated files
+		manager.resize(entry,sizeof(detail::MeshFileHeader) + 16);
+		EXPECT_FALSE(Mesh::mapFrom("mesh_mapped.bin"));
+		manager.resize(entry,16);
+		EXPECT_FALSE(Mesh::mapFrom("mesh_mapped.bin"));
+
+		// and files of other formats
+		createBarMesh<2,2>(5).storeTo("mesh_mapped.bin");
+		manager.writeAt(entry,0,"X",1);
+		EXPECT_FALSE(Mesh::mapFrom("mesh_mapped.bin"));
+
+		manager.remove(entry);
+	}
+
 	TEST(Mesh,Scan) {
 
 		auto bar = createBarMesh<2,2>(5);
@@ -1524,6 +1688,374 @@ namespace data {
 		EXPECT_EQ(31,mask);
 	}
 
+	TEST(Mesh,EdgeScan) {
+
+		auto bar = createBarMesh<2,2>(500);
+
+		// check the number of edges on both levels
+		EXPECT_EQ(2*(1000-1),bar.getNumEdges<Edge>());
+		EXPECT_EQ(2*(500-1),(bar.getNumEdges<Edge,1>()));
+
+		// sequentially, edges are visited in the order of their index
+		std::size_t next = 0;
+		bar.forAllEdges<Edge>([&](const EdgeRef<Edge,0>& edge){
+			EXPECT_EQ(next,edge.getOrdinal());
+			next++;
+
+			// the end points are connected
+			const auto& sinks = bar.getSinks<Edge>(edge.getSource());
+			EXPECT_NE(sinks.end(),std::find(sinks.begin(),sinks.end(),edge.getSink()));
+		});
+		EXPECT_EQ(bar.getNumEdges<Edge>(),next);
+
+		// in parallel, each edge is visited exactly once for any grain size
+		for(std::size_t grain : { 1, 7, 100, 10000 }) {
+			std::vector<std::atomic<int>> visits(bar.getNumEdges<Edge>());
+			for(auto& cur : visits) cur = 0;
+			bar.pforAllEdges<Edge>([&](const auto& edge){
+				visits[edge.getOrdinal()]++;
+			},grain);
+			EXPECT_TRUE(std::all_of(visits.begin(),visits.end(),[](const std::atomic<int>& cur) { return cur == 1; })) << "Grain size: " << grain;
+		}
+
+		// edge indices may be utilized for storing per-edge data, e.g. fluxes to be accumulated per node
+		auto meshWithOneLeaf = createBarMesh<1,0>(1000);
+		std::vector<double> flux(meshWithOneLeaf.getNumEdges<Edge>());
+		meshWithOneLeaf.pforAllEdges<Edge>([&](const EdgeRef<Edge,0>& edge){
+			flux[edge.getOrdinal()] = double(edge.getSink().id) - double(edge.getSource().id);
+		},16);
+
+		auto balance = meshWithOneLeaf.createNodeData<Vertex,double>();
+		meshWithOneLeaf.forAll<Vertex>([&](const auto& node){ balance[node] = 0; });
+		meshWithOneLeaf.forAllEdges<Edge>([&](const auto& edge){
+			balance[edge.getSource()] += flux[edge.getOrdinal()];
+		});
+
+		// inner vertices have one neighbour on each side
+		meshWithOneLeaf.forAll<Vertex>([&](const auto& node){
+			double expected = (node.id == 0) ? 1 : (node.id == 999) ? -1 : 0;
+			EXPECT_EQ(expected,balance[node]) << node;
+		});
+	}
+
+	TEST(Mesh,Coloring) {
+
+		auto bar = createBarMesh<2,2>(500);
+
+		// a utility checking that no two items in conflict share a color
+		auto isValid = [](const MeshColoring& coloring, const std::vector<std::pair<std::size_t,std::size_t>>& conflicts) {
+			for(const auto& cur : conflicts) {
+				if (cur.first != cur.second && coloring.getColor(cur.first) == coloring.getColor(cur.second)) return false;
+			}
+			return true;
+		};
+
+		// collect the pairs of vertices within distance 1 and 2 and edges sharing an end point
+		std::vector<std::pair<std::size_t,std::size_t>> distance1, distance2, edges;
+		bar.forAll<Vertex>([&](const auto& node){
+			for(const auto& a : bar.getSinks<Edge>(node)) {
+				distance1.push_back({ node.id, a.id });
+				for(const auto& b : bar.getSinks<Edge>(a)) {
+					distance2.push_back({ node.id, b.id });
+				}
+			}
+		});
+		bar.forAllEdges<Edge>([&](const EdgeRef<Edge,0>& a){
+			bar.forAllEdges<Edge>([&](const EdgeRef<Edge,0>& b){
+				if (a.src == b.src || a.src == b.trg || a.trg == b.src || a.trg == b.trg) edges.push_back({ a.id, b.id });
+			});
+		});
+
+		const auto& nodes1 = bar.getNodeColoring<Edge>(1);
+		EXPECT_EQ(bar.getNumNodes<Vertex>(),nodes1.size());
+		EXPECT_TRUE(isValid(nodes1,distance1));
+		EXPECT_LE(2,nodes1.getNumColors());
+		EXPECT_GE(3,nodes1.getNumColors());
+
+		const auto& nodes2 = bar.getNodeColoring<Edge>(2);
+		EXPECT_TRUE(isValid(nodes2,distance2));
+		EXPECT_LE(3,nodes2.getNumColors());
+		EXPECT_GE(5,nodes2.getNumColors());
+
+		const auto& edges1 = bar.getEdgeColoring<Edge>();
+		EXPECT_EQ(bar.getNumEdges<Edge>(),edges1.size());
+		EXPECT_TRUE(isValid(edges1,edges));
+
+		// colorings are cached
+		EXPECT_EQ(&nodes1,&bar.getNodeColoring<Edge>(1));
+		EXPECT_EQ(&edges1,&bar.getEdgeColoring<Edge>(1));
+		EXPECT_NE(&nodes1,&(bar.getNodeColoring<Edge,1>(1)));
+
+		// the items of each color are listed in order
+		std::size_t count = 0;
+		for(std::size_t c = 0; c < nodes2.getNumColors(); c++) {
+			auto items = nodes2.getItems(c);
+			EXPECT_TRUE(std::is_sorted(items.begin(),items.end()));
+			for(auto cur : items) EXPECT_EQ(c,nodes2.getColor(cur));
+			count += items.size();
+		}
+		EXPECT_EQ(nodes2.size(),count);
+
+		// scatter updates to neighbors do not need to be synchronized
+		std::vector<int> degrees(bar.getNumNodes<Vertex>(),0);
+		bar.pforAllColored<Edge>(2,[&](const NodeRef<Vertex>& node){
+			degrees[node.id]++;
+			for(const auto& cur : bar.getSinks<Edge>(node)) degrees[cur.id]++;
+		});
+		bar.forAll<Vertex>([&](const auto& node){
+			EXPECT_EQ(int(1 + bar.getSinks<Edge>(node).size()),degrees[node.id]) << node;
+		});
+
+		// nor do updates to the end points of edges
+		std::vector<int> incident(bar.getNumNodes<Vertex>(),0);
+		bar.pforAllEdgesColored<Edge>(1,[&](const EdgeRef<Edge,0>& edge){
+			incident[edge.getSource().id]++;
+			incident[edge.getSink().id]++;
+		});
+		bar.forAll<Vertex>([&](const auto& node){
+			EXPECT_EQ(int(2 * bar.getSinks<Edge>(node).size()),incident[node.id]) << node;
+		});
+	}
+
+	TEST(Mesh,ColoringOfRelationsAmongKinds) {
+
+		struct Cell {};
+		struct Face {};
+		struct Face2Cell : public edge<Face,Cell> {};
+
+		using Builder = MeshBuilder<nodes<Cell,Face>,edges<Face2Cell>,hierarchies<>,1>;
+
+		// a grid of cells, connected by faces
+		const int N = 20;
+		Builder mb;
+		mb.create<Cell>(N*N);
+		for(int x=0; x<N; x++) {
+			for(int y=0; y<N; y++) {
+				for(auto cur : { std::make_pair(x+1,y), std::make_pair(x,y+1) }) {
+					if (cur.first >= N || cur.second >= N) continue;
+					auto f = mb.create<Face>();
+					mb.link<Face2Cell>(f,NodeRef<Cell,0>(x * N + y));
+					mb.link<Face2Cell>(f,NodeRef<Cell,0>(cur.first * N + cur.second));
+				}
+			}
+		}
+		auto mesh = std::move(mb).build<3>();
+
+		// faces are not adjacent to each other
+		EXPECT_EQ(1,mesh.getNodeColoring<Face2Cell>(1).getNumColors());
+
+		// faces sharing a cell get different colors
+		const auto& faces = mesh.getNodeColoring<Face2Cell>(2);
+		mesh.forAll<Cell>([&](const auto& cell){
+			std::set<std::uint32_t> colors;
+			for(const auto& face : mesh.getSources<Face2Cell>(cell)) colors.insert(faces.getColor(face.id));
+			EXPECT_EQ(mesh.getSources<Face2Cell>(cell).size(),colors.size());
+		});
+		EXPECT_GE(7,faces.getNumColors());
+
+		// as do the edges of the same face or cell
+		const auto& edges = mesh.getEdgeColoring<Face2Cell>(1);
+		std::vector<std::set<std::uint32_t>> faceColors(mesh.getNumNodes<Face>());
+		std::vector<std::set<std::uint32_t>> cellColors(mesh.getNumNodes<Cell>());
+		mesh.forAllEdges<Face2Cell>([&](const auto& edge){
+			auto color = edges.getColor(edge.getOrdinal());
+			EXPECT_TRUE(faceColors[edge.getSource().id].insert(color).second);
+			EXPECT_TRUE(cellColors[edge.getSink().id].insert(color).second);
+		});
+	}
+
+	TEST(Mesh,CompressedEdges) {
+
+		auto toVector = [](const auto& list) {
+			return std::vector<std::decay_t<decltype(*list.begin())>>(list.begin(),list.end());
+		};
+
+		// checks that the compressed relation lists the same nodes as the given mesh
+		auto check = [&](const auto& mesh, const auto& compressed, const auto& edge) {
+			using EdgeKind = std::decay_t<decltype(edge)>;
+			using SrcKind = typename EdgeKind::src_node_kind;
+			using TrgKind = typename EdgeKind::trg_node_kind;
+			EXPECT_EQ(mesh.template getNumEdges<EdgeKind>(),compressed.getNumEdges());
+			mesh.template forAll<SrcKind>([&](const auto& node){
+				const auto& list = compressed.getSinks(node);
+				EXPECT_EQ(toVector(mesh.template getSinks<EdgeKind>(node)),std::vector<NodeRef<TrgKind>>(list.begin(),list.end())) << node;
+				EXPECT_EQ(mesh.template getSinks<EdgeKind>(node).size(),list.size());
+				EXPECT_EQ(list.empty(),list.size() == 0);
+			});
+			mesh.template forAll<TrgKind>([&](const auto& node){
+				const auto& list = compressed.getSources(node);
+				EXPECT_EQ(toVector(mesh.template getSources<EdgeKind>(node)),std::vector<NodeRef<SrcKind>>(list.begin(),list.end())) << node;
+			});
+
+			// parallel traversals of the compressed relation visit the edges of the mesh
+			using Link = std::pair<node_index_t,node_index_t>;
+			std::vector<Link> expected;
+			mesh.template forAllEdges<EdgeKind>([&](const auto& edge){
+				expected.push_back({ edge.getSource().id, edge.getSink().id });
+			});
+			for(std::size_t grain : { 1, 100, 100000 }) {
+				std::vector<Link> visited(expected.size(), { 0, 0 });
+				std::vector<std::atomic<int>> visits(expected.size());
+				for(auto& cur : visits) cur = 0;
+				mesh.pforAllEdges(compressed,[&](const auto& edge){
+					visited[edge.getOrdinal()] = { edge.getSource().id, edge.getSink().id };
+					visits[edge.getOrdinal()]++;
+				},grain);
+				EXPECT_EQ(expected,visited) << "Grain size: " << grain;
+				EXPECT_TRUE(std::all_of(visits.begin(),visits.end(),[](const std::atomic<int>& cur) { return cur == 1; })) << "Grain size: " << grain;
+			}
+		};
+
+		// neighbours in a bar are stored with a byte per edge
+		auto bar = createBarMesh<2,2>(500);
+		auto links = bar.compressEdges<Edge>();
+		check(bar,links,Edge());
+		EXPECT_TRUE(links.hasNarrowOffsets());
+		EXPECT_GE(links.getNumEdges() * 2 + 2 * 4 * 1001 + 8 * (1000 / 64 + 1),links.getMemorySize());
+
+		// nodes on the second level are compressed independently
+		auto coarse = bar.compressEdges<Edge,1>();
+		EXPECT_EQ(2*(500-1),coarse.getNumEdges());
+		EXPECT_EQ((std::vector<NodeRef<Vertex,1>>{ NodeRef<Vertex,1>(1) }),toVector(coarse.getSinks(NodeRef<Vertex,1>(0))));
+
+		// arbitrary links, including distant nodes and duplicates, are supported
+		struct Cell {};
+		struct Face {};
+		struct Face2Cell : public edge<Face,Cell> {};
+		using Builder = MeshBuilder<nodes<Cell,Face>,edges<Face2Cell>,hierarchies<>,1>;
+
+		const unsigned N = 20000;
+		std::mt19937 random(42);
+		Builder mb;
+		mb.create<Cell>(N);
+		mb.create<Face>(N/2);
+		for(unsigned i=0; i<4*N; i++) {
+			auto face = NodeRef<Face>(random() % (N/2));
+			auto cell = (i % 2) ? NodeRef<Cell>(random() % N) : NodeRef<Cell>(std::min<unsigned>(2 * face.id + i % 3, N-1));
+			mb.link<Face2Cell>(face,cell);
+		}
+		auto mesh = mb.build();
+		auto faces = mesh.compressEdges<Face2Cell>();
+		check(mesh,faces,Face2Cell());
+
+		// nodes without edges
+		auto empty = createBarMesh<1,0>(1).compressEdges<Edge>();
+		EXPECT_EQ(0,empty.getNumEdges());
+		EXPECT_TRUE(empty.getSinks(NodeRef<Vertex>(0)).empty());
+	}
+
+	TEST(Mesh,SparseProducts) {
+
+		// checks the products of the given mesh against products computed edge by edge
+		auto check = [](const auto& mesh, const auto& edge) {
+			using EdgeKind = std::decay_t<decltype(edge)>;
+			using SrcKind = typename EdgeKind::src_node_kind;
+			using TrgKind = typename EdgeKind::trg_node_kind;
+
+			// small integral values, such that sums are exact in any order
+			std::vector<double> values(mesh.template getNumEdges<EdgeKind>());
+			for(std::size_t i = 0; i < values.size(); ++i) values[i] = double(i % 7) - 3;
+
+			auto x = mesh.template createNodeData<TrgKind,double>();
+			mesh.template forAll<TrgKind>([&](const auto& node){ x[node] = double(node.id % 5); });
+			auto u = mesh.template createNodeData<SrcKind,double>();
+			mesh.template forAll<SrcKind>([&](const auto& node){ u[node] = double(node.id % 3) + 1; });
+
+			auto expectedY = mesh.template createNodeData<SrcKind,double>();
+			auto expectedV = mesh.template createNodeData<TrgKind,double>();
+			mesh.template forAll<SrcKind>([&](const auto& node){ expectedY[node] = 0; });
+			mesh.template forAll<TrgKind>([&](const auto& node){ expectedV[node] = 0; });
+			mesh.template forAllEdges<EdgeKind>([&](const auto& edge){
+				expectedY[edge.getSource()] += values[edge.getOrdinal()] * x[edge.getSink()];
+				expectedV[edge.getSink()] += values[edge.getOrdinal()] * u[edge.getSource()];
+			});
+
+			auto compressed = mesh.template compressEdges<EdgeKind>();
+			for(std::size_t grain : { 1, 100, 100000 }) {
+
+				// y = A * x
+				auto y = mesh.template createNodeData<SrcKind,double>();
+				mesh.template forAll<SrcKind>([&](const auto& node){ y[node] = -1; });
+				mesh.template multiply<EdgeKind>(values,x,y,grain);
+				mesh.template forAll<SrcKind>([&](const auto& node){
+					EXPECT_EQ(expectedY[node],y[node]) << node << " grain " << grain;
+				});
+
+				// the same, decoding a compressed relation
+				mesh.template forAll<SrcKind>([&](const auto& node){ y[node] = -1; });
+				mesh.multiply(compressed,values,x,y,grain);
+				mesh.template forAll<SrcKind>([&](const auto& node){
+					EXPECT_EQ(expectedY[node],y[node]) << node << " compressed, grain " << grain;
+				});
+
+				// v = A^T * u
+				auto v = mesh.template createNodeData<TrgKind,double>();
+				mesh.template multiplyTransposed<EdgeKind>(values,u,v,grain);
+				mesh.template forAll<TrgKind>([&](const auto& node){
+					EXPECT_EQ(expectedV[node],v[node]) << node << " grain " << grain;
+				});
+			}
+
+			// multiple vectors at once
+			auto xs = mesh.template createNodeData<TrgKind,std::array<double,3>>();
+			mesh.template forAll<TrgKind>([&](const auto& node){ xs[node] = {{ x[node], 2 * x[node], -x[node] }}; });
+			auto ys = mesh.template createNodeData<SrcKind,std::array<double,3>>();
+			mesh.template multiply<EdgeKind>(values,xs,ys);
+			mesh.template forAll<SrcKind>([&](const auto& node){
+				EXPECT_EQ((std::array<double,3>{{ expectedY[node], 2 * expectedY[node], -expectedY[node] }}),ys[node]) << node;
+			});
+			mesh.template forAll<SrcKind>([&](const auto& node){ ys[node] = std::array<double,3>(); });
+			mesh.multiply(compressed,values,xs,ys);
+			mesh.template forAll<SrcKind>([&](const auto& node){
+				EXPECT_EQ((std::array<double,3>{{ expectedY[node], 2 * expectedY[node], -expectedY[node] }}),ys[node]) << node;
+			});
+
+			auto us = mesh.template createNodeData<SrcKind,std::array<double,2>>();
+			mesh.template forAll<SrcKind>([&](const auto& node){ us[node] = {{ u[node], 0 }}; });
+			auto vs = mesh.template createNodeData<TrgKind,std::array<double,2>>();
+			mesh.template multiplyTransposed<EdgeKind>(values,us,vs);
+			mesh.template forAll<TrgKind>([&](const auto& node){
+				EXPECT_EQ((std::array<double,2>{{ expectedV[node], 0 }}),vs[node]) << node;
+			});
+		};
+
+		// a bar, forming a symmetric pattern
+		auto bar = createBarMesh<2,2>(500);
+		check(bar,Edge());
+
+		// rows of nodes on the second level
+		std::vector<float> values(bar.getNumEdges<Edge,1>(),0.5f);
+		auto x = bar.createNodeData<Vertex,float,1>();
+		bar.forAll<Vertex,1>([&](const auto& node){ x[node] = 2; });
+		auto y = bar.createNodeData<Vertex,float,1>();
+		bar.multiply<Edge>(values,x,y);
+		bar.forAll<Vertex,1>([&](const auto& node){
+			EXPECT_EQ((node.id == 0 || node.id == 499) ? 1 : 2,y[node]) << node;
+		});
+
+		// arbitrary links among different kinds of nodes, including duplicates and nodes without edges
+		struct Cell {};
+		struct Face {};
+		struct Face2Cell : public edge<Face,Cell> {};
+		using Builder = MeshBuilder<nodes<Cell,Face>,edges<Face2Cell>,hierarchies<>,1>;
+
+		const unsigned N = 20000;
+		std::mt19937 random(42);
+		Builder mb;
+		mb.create<Cell>(N);
+		mb.create<Face>(N/2);
+		for(unsigned i=0; i<3*N; i++) {
+			auto face = NodeRef<Face>(random() % (N/4));
+			auto cell = (i % 2) ? NodeRef<Cell>(random() % (N/2)) : NodeRef<Cell>(2 * face.id + i % 3);
+			mb.link<Face2Cell>(face,cell);
+		}
+		check(mb.build<4>(),Face2Cell());
+
+		// the same, with sorted rows
+		mb.sortLinks(true);
+		check(mb.build<4>(),Face2Cell());
+	}
+
 	TEST(Mesh,Preduce) {
 
 		auto bar = createBarMesh<2,2>(5);
@@ -1776,6 +2308,533 @@ namespace data {
 	}
 
 
+	TEST(Mesh, GraphPartitioner) {
+
+		// define 'object' types
+		struct Cell {};
+		struct Face {};
+
+		// define 'relations'
+		struct Cell2Cell : public edge<Cell,Cell> {};
+		struct Face2Cell : public edge<Face,Cell> {};
+
+		// and 'hierarchies'
+		struct Cell2Child : public hierarchy<Cell,Cell> {};
+
+		using Builder = MeshBuilder<nodes<Cell,Face>,edges<Cell2Cell,Face2Cell>,hierarchies<Cell2Child>,2>;
+
+		// create a grid of cells, numbered in random order
+		const int N = 32;
+		std::vector<node_index_t> ids(N*N);
+		std::iota(ids.begin(),ids.end(),0);
+		std::shuffle(ids.begin(),ids.end(),std::mt19937(42));
+		auto cell = [&](int x, int y) { return NodeRef<Cell,0>(ids[x * N + y]); };
+
+		Builder mb;
+		mb.create<Cell>(N*N);
+
+		std::vector<std::pair<NodeRef<Cell,0>,NodeRef<Cell,0>>> links;
+		std::vector<std::pair<int,int>> positions(N*N);
+		for(int x=0; x<N; x++) {
+			for(int y=0; y<N; y++) {
+				positions[ids[x * N + y]] = { x, y };
+				for(auto cur : { std::make_pair(x+1,y), std::make_pair(x,y+1) }) {
+					if (cur.first >= N || cur.second >= N) continue;
+					auto a = cell(x,y);
+					auto b = cell(cur.first,cur.second);
+					mb.link<Cell2Cell>(a,b);
+					mb.link<Cell2Cell>(b,a);
+					links.push_back({ a, b });
+
+					// the face in-between
+					auto f = mb.create<Face>();
+					mb.link<Face2Cell>(f,a);
+					mb.link<Face2Cell>(f,b);
+				}
+			}
+		}
+
+		// and a coarser grid on top
+		auto coarse = mb.create<Cell,1>((N/2)*(N/2));
+		for(int x=0; x<N; x++) {
+			for(int y=0; y<N; y++) {
+				mb.link<Cell2Child>(coarse[(x/2) * (N/2) + y/2], cell(x,y));
+			}
+		}
+
+		// build the mesh with both partitioners
+		auto naive = mb.build<detail::NaiveMeshPartitioner,4>(detail::NaiveMeshPartitioner());
+		Builder::permutation_type perm;
+		auto m = mb.build<GraphMeshPartitioner,4>(GraphMeshPartitioner(),perm);
+
+		EXPECT_FALSE(perm.isIdentity<Cell>());
+		EXPECT_EQ(N*N, perm.getMapping<Cell>().size());
+
+		// the partitions are much better connected
+		auto a = naive.getPartitionStatistics<Cell2Cell>();
+		auto b = m.getPartitionStatistics<Cell2Cell>();
+		EXPECT_EQ(a.numEdges, b.numEdges);
+		EXPECT_LT(b.edgeCut * 4, a.edgeCut) << "Naive: " << a << "\nGraph: " << b;
+		EXPECT_LT(b.forwardClosureSize * 2, a.forwardClosureSize) << "Naive: " << a << "\nGraph: " << b;
+		EXPECT_LT(b.maxBackwardClosureSize, a.maxBackwardClosureSize) << "Naive: " << a << "\nGraph: " << b;
+
+		auto c = m.getPartitionStatistics<Face2Cell>();
+		EXPECT_EQ(2 * links.size(), c.numEdges);
+		EXPECT_LT(c.forwardClosureSize * 2, naive.getPartitionStatistics<Face2Cell>().forwardClosureSize);
+
+		// the partitions remain balanced
+		const auto& ptree = m.getPartitionTree();
+		detail::SubTreeRef::root().enumerate<4,true>([&](const detail::SubTreeRef& ref) {
+			if (ref.getDepth() != 4) return;
+			auto size = ptree.getNodeRange<Cell,0>(ref).size();
+			EXPECT_LE(N*N/16, size);
+			EXPECT_GE(N*N/16+1, size);
+		});
+
+		// the relations have been re-ordered consistently
+		for(const auto& cur : links) {
+			auto sinks = m.getSinks<Cell2Cell>(perm(cur.first));
+			EXPECT_NE(sinks.end(), std::find(sinks.begin(),sinks.end(),perm(cur.second)));
+			auto sources = m.getSources<Cell2Cell>(perm(cur.first));
+			EXPECT_NE(sources.end(), std::find(sources.begin(),sources.end(),perm(cur.second)));
+		}
+		for(int x=0; x<N; x++) {
+			for(int y=0; y<N; y++) {
+				EXPECT_EQ(perm(coarse[(x/2) * (N/2) + y/2]), m.getParent<Cell2Child>(perm(cell(x,y))));
+			}
+		}
+
+		// user data can be re-mapped
+		auto pos = perm.apply<Cell>(positions);
+		m.forAll<Cell>([&](const NodeRef<Cell>& cur) {
+			for(const auto& next : m.getSinks<Cell2Cell>(cur)) {
+				EXPECT_EQ(1, std::abs(pos[cur.id].first - pos[next.id].first) + std::abs(pos[cur.id].second - pos[next.id].second));
+			}
+		});
+
+		// closures cover all neighbours
+		auto contains = [&](const detail::MeshRegion& region, const auto& node) {
+			bool res = false;
+			region.scan([&](const detail::SubTreeRef& ref) {
+				auto range = ptree.getNodeRange<typename std::decay_t<decltype(node)>::node_kind,std::decay_t<decltype(node)>::level>(ref);
+				res = res || (range.getBegin().id <= node.id && node.id < range.getEnd().id);
+			});
+			return res;
+		};
+		detail::SubTreeRef::root().enumerate<4,true>([&](const detail::SubTreeRef& ref) {
+			auto forward = ptree.getForwardClosure<Face2Cell,0>(ref);
+			auto backward = ptree.getBackwardClosure<Face2Cell,0>(ref);
+			auto parents = ptree.getParentClosure<Cell2Child,0>(ref);
+			for(const auto& f : ptree.getNodeRange<Face,0>(ref)) {
+				for(const auto& c : m.getSinks<Face2Cell>(f)) {
+					EXPECT_TRUE(contains(forward,c));
+				}
+			}
+			for(const auto& c : ptree.getNodeRange<Cell,0>(ref)) {
+				for(const auto& f : m.getSources<Face2Cell>(c)) {
+					EXPECT_TRUE(contains(backward,f));
+				}
+				EXPECT_TRUE(contains(parents,m.getParent<Cell2Child>(c)));
+			}
+		});
+
+		// coarse cells are placed close to their children
+		detail::SubTreeRef::root().enumerate<4,true>([&](const detail::SubTreeRef& ref) {
+			if (ref.getDepth() != 4) return;
+			auto closure = ptree.getParentClosure<Cell2Child,0>(ref);
+			EXPECT_NE("[r]", toString(closure));
+		});
+	}
+
+
+	TEST(Mesh, Renumbering) {
+
+		// define 'object' types
+		struct Cell {};
+		struct Face {};
+
+		// define 'relations'
+		struct Cell2Cell : public edge<Cell,Cell> {};
+		struct Face2Cell : public edge<Face,Cell> {};
+
+		// and 'hierarchies'
+		struct Cell2Child : public hierarchy<Cell,Cell> {};
+
+		using Builder = MeshBuilder<nodes<Cell,Face>,edges<Cell2Cell,Face2Cell>,hierarchies<Cell2Child>,2>;
+		using Point = utils::Vector<double,2>;
+
+		// create a grid of cells, numbered in random order
+		const int N = 32;
+		std::vector<node_index_t> ids(N*N);
+		std::iota(ids.begin(),ids.end(),0);
+		std::shuffle(ids.begin(),ids.end(),std::mt19937(42));
+		auto cell = [&](int x, int y) { return NodeRef<Cell,0>(ids[x * N + y]); };
+		auto parent = [&](int x, int y) { return NodeRef<Cell,1>((x/2) * (N/2) + y/2); };
+
+		std::vector<std::pair<NodeRef<Cell,0>,NodeRef<Cell,0>>> links;
+		std::vector<std::pair<NodeRef<Face,0>,NodeRef<Cell,0>>> faces;
+		std::vector<Point> positions(N*N);
+		auto create = [&]() {
+			Builder mb;
+			links.clear();
+			faces.clear();
+			mb.create<Cell>(N*N);
+			mb.create<Cell,1>((N/2)*(N/2));
+			for(int x=0; x<N; x++) {
+				for(int y=0; y<N; y++) {
+					positions[ids[x * N + y]] = Point(x,y);
+					mb.link<Cell2Child>(parent(x,y), cell(x,y));
+					for(auto cur : { std::make_pair(x+1,y), std::make_pair(x,y+1) }) {
+						if (cur.first >= N || cur.second >= N) continue;
+						auto a = cell(x,y);
+						auto b = cell(cur.first,cur.second);
+						mb.link<Cell2Cell>(a,b);
+						mb.link<Cell2Cell>(b,a);
+						links.push_back({ a, b });
+						auto f = mb.create<Face>();
+						mb.link<Face2Cell>(f,a);
+						mb.link<Face2Cell>(f,b);
+						faces.push_back({ f, a });
+						faces.push_back({ f, b });
+					}
+				}
+			}
+			return mb;
+		};
+
+		// the largest distance of the indices of neighbouring cells
+		auto getBandwidth = [&](const Builder::permutation_type& perm) {
+			std::size_t res = 0;
+			for(const auto& cur : links) {
+				auto a = perm(cur.first).id;
+				auto b = perm(cur.second).id;
+				res = std::max<std::size_t>(res, (a < b) ? b - a : a - b);
+			}
+			return res;
+		};
+
+		// checks that all relations have been re-mapped consistently
+		auto checkRelations = [&](const auto& m, const Builder::permutation_type& perm) {
+			for(const auto& cur : links) {
+				auto sinks = m.template getSinks<Cell2Cell>(perm(cur.first));
+				EXPECT_NE(sinks.end(), std::find(sinks.begin(),sinks.end(),perm(cur.second)));
+			}
+			for(const auto& cur : faces) {
+				auto sources = m.template getSources<Face2Cell>(perm(cur.second));
+				EXPECT_NE(sources.end(), std::find(sources.begin(),sources.end(),perm(cur.first)));
+			}
+			for(int x=0; x<N; x++) {
+				for(int y=0; y<N; y++) {
+					EXPECT_EQ(perm(parent(x,y)), m.template getParent<Cell2Child>(perm(cell(x,y))));
+				}
+			}
+		};
+
+		// the sum of the distances of the indices of neighbouring cells
+		auto getTotalDistance = [&](const Builder::permutation_type& perm) {
+			std::size_t res = 0;
+			for(const auto& cur : links) {
+				auto a = perm(cur.first).id;
+				auto b = perm(cur.second).id;
+				res += (a < b) ? b - a : a - b;
+			}
+			return res;
+		};
+
+		// reverse Cuthill-McKee ordering
+		{
+			Builder::permutation_type perm;
+			auto mb = create();
+			EXPECT_LT(N*N/2, getBandwidth(perm));
+			mb.renumber(perm);
+			EXPECT_FALSE(perm.isIdentity<Cell>());
+			EXPECT_FALSE(perm.isIdentity<Face>());
+			EXPECT_FALSE((perm.isIdentity<Cell,1>()));
+			EXPECT_GE(2*N, getBandwidth(perm));
+
+			auto m = std::move(mb).build();
+			checkRelations(m, perm);
+			EXPECT_EQ(N*N, m.getNumNodes<Cell>());
+			EXPECT_EQ(2*N*(N-1), m.getNumNodes<Face>());
+		}
+
+		// space-filling curve ordering
+		{
+			Builder::permutation_type perm;
+			auto mb = create();
+			auto initial = getTotalDistance(perm);
+			mb.renumber<Cell>(positions, perm);
+			EXPECT_FALSE(perm.isIdentity<Cell>());
+			EXPECT_TRUE(perm.isIdentity<Face>());
+			EXPECT_TRUE((perm.isIdentity<Cell,1>()));
+
+			// neighbouring cells are closer on average
+			EXPECT_LT(getTotalDistance(perm) * 3, initial);
+
+			// consecutive cells are close in space
+			auto pos = perm.apply<Cell>(positions);
+			for(std::size_t i = 1; i < pos.size(); ++i) {
+				EXPECT_GE(4, std::abs(pos[i].x - pos[i-1].x) + std::abs(pos[i].y - pos[i-1].y)) << i;
+			}
+
+			auto m = mb.build();
+			checkRelations(m, perm);
+		}
+
+		// re-numbering can be combined with re-ordering partitioners
+		{
+			Builder::permutation_type perm;
+			auto mb = create();
+			mb.renumber(perm);
+			auto m = std::move(mb).build<GraphMeshPartitioner,3>(GraphMeshPartitioner(),perm);
+			checkRelations(m, perm);
+		}
+	}
+
+	TEST(Mesh, ParallelBuild) {
+
+		struct Vertex {};
+		struct Link : public edge<Vertex,Vertex> {};
+		struct Refine : public hierarchy<Vertex,Vertex> {};
+
+		using Builder = MeshBuilder<nodes<Vertex>,edges<Link>,hierarchies<Refine>,2>;
+
+		// create relations large enough to be closed in parallel
+		const unsigned N = 100000;
+		const unsigned E = 3 * N;
+		std::mt19937 random(42);
+
+		Builder mb;
+		mb.create<Vertex>(N);
+		mb.create<Vertex,1>(N/4);
+
+		std::vector<std::vector<NodeRef<Vertex>>> sinks(N);
+		std::vector<std::vector<NodeRef<Vertex>>> sources(N);
+		for(unsigned i=0; i<E; i++) {
+			NodeRef<Vertex> a(random() % N);
+			NodeRef<Vertex> b(random() % N);
+			mb.link<Link>(a,b);
+			sinks[a.id].push_back(b);
+			sources[b.id].push_back(a);
+		}
+
+		std::vector<std::vector<NodeRef<Vertex>>> children(N/4);
+		std::vector<NodeRef<Vertex,1>> parents(N);
+		for(unsigned i=0; i<N; i++) {
+			NodeRef<Vertex> child((i * 7919) % N);
+			NodeRef<Vertex,1> parent(random() % (N/4));
+			mb.link<Refine>(parent,child);
+			children[parent.id].push_back(child);
+			parents[child.id] = parent;
+		}
+
+		auto toVector = [](const auto& list) {
+			return std::vector<NodeRef<Vertex>>(list.begin(),list.end());
+		};
+
+		// links are listed in the order they have been added
+		{
+			auto m = mb.build();
+			for(unsigned i=0; i<N; i++) {
+				NodeRef<Vertex> cur(i);
+				EXPECT_EQ(sinks[i], toVector(m.getSinks<Link>(cur)));
+				EXPECT_EQ(sources[i], toVector(m.getSources<Link>(cur)));
+				EXPECT_EQ(parents[i], m.getParent<Refine>(cur));
+			}
+			for(unsigned i=0; i<N/4; i++) {
+				EXPECT_EQ(children[i], toVector(m.getChildren<Refine>(NodeRef<Vertex,1>(i))));
+			}
+		}
+
+		// or in the order of their indices
+		{
+			auto sort = [](auto& lists) {
+				for(auto& cur : lists) std::sort(cur.begin(),cur.end());
+			};
+			sort(sinks);
+			sort(sources);
+			sort(children);
+
+			mb.sortLinks();
+			auto m = std::move(mb).build();
+			for(unsigned i=0; i<N; i++) {
+				NodeRef<Vertex> cur(i);
+				EXPECT_EQ(sinks[i], toVector(m.getSinks<Link>(cur)));
+				EXPECT_EQ(sources[i], toVector(m.getSources<Link>(cur)));
+				EXPECT_EQ(parents[i], m.getParent<Refine>(cur));
+			}
+			for(unsigned i=0; i<N/4; i++) {
+				EXPECT_EQ(children[i], toVector(m.getChildren<Refine>(NodeRef<Vertex,1>(i))));
+			}
+		}
+	}
+
+	TEST(DISABLED_Mesh, BuildBenchmark) {
+
+		struct Vertex {};
+		struct Link : public edge<Vertex,Vertex> {};
+
+		using Builder = MeshBuilder<nodes<Vertex>,edges<Link>,hierarchies<>,1>;
+
+		const unsigned N = 10000000;
+		std::mt19937 random(42);
+
+		Builder mb;
+		mb.create<Vertex>(N);
+		std::vector<std::pair<node_index_t,node_index_t>> links(4*N);
+		for(auto& cur : links) {
+			cur = { node_index_t(random() % N), node_index_t(random() % N) };
+			mb.link<Link>(NodeRef<Vertex>(cur.first),NodeRef<Vertex>(cur.second));
+		}
+
+		// the baseline: building the forward and backward tables of a copy of the edges sequentially
+		{
+			auto begin = std::chrono::high_resolution_clock::now();
+			auto edges = links;
+			std::vector<std::uint64_t> forwardOffsets(N + 1, 0);
+			std::vector<std::uint64_t> backwardOffsets(N + 1, 0);
+			for(const auto& cur : edges) {
+				++forwardOffsets[cur.first + 1];
+				++backwardOffsets[cur.second + 1];
+			}
+			for(unsigned i=0; i<N; i++) {
+				forwardOffsets[i+1] += forwardOffsets[i];
+				backwardOffsets[i+1] += backwardOffsets[i];
+			}
+			std::vector<node_index_t> forwardTargets(edges.size());
+			std::vector<node_index_t> backwardTargets(edges.size());
+			for(const auto& cur : edges) {
+				forwardTargets[forwardOffsets[cur.first]++] = cur.second;
+				backwardTargets[backwardOffsets[cur.second]++] = cur.first;
+			}
+			auto end = std::chrono::high_resolution_clock::now();
+			std::cout << "Sequential tables for " << (4*N) << " edges: "
+					<< std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+		}
+
+		for(bool sorted : { false, true }) {
+			mb.sortLinks(sorted);
+			auto begin = std::chrono::high_resolution_clock::now();
+			auto m = mb.build();
+			auto end = std::chrono::high_resolution_clock::now();
+			std::cout << "Building mesh with " << (4*N) << " edges" << (sorted ? " (sorted)" : "") << ": "
+					<< std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+		}
+	}
+
+	TEST(DISABLED_Mesh, CompressedEdgesBenchmark) {
+
+		struct Vertex {};
+		struct Link : public edge<Vertex,Vertex> {};
+
+		using Builder = MeshBuilder<nodes<Vertex>,edges<Link>,hierarchies<>,1>;
+
+		// a 3D grid, numbered for locality
+		const int N = 160;
+		auto id = [&](int x, int y, int z) { return NodeRef<Vertex>((x * N + y) * N + z); };
+		Builder mb;
+		mb.create<Vertex>(N*N*N);
+		for(int x=0; x<N; x++) {
+			for(int y=0; y<N; y++) {
+				for(int z=0; z<N; z++) {
+					if (x+1 < N) mb.link<Link>(id(x,y,z),id(x+1,y,z));
+					if (y+1 < N) mb.link<Link>(id(x,y,z),id(x,y+1,z));
+					if (z+1 < N) mb.link<Link>(id(x,y,z),id(x,y,z+1));
+				}
+			}
+		}
+		auto m = mb.build();
+		auto compressed = m.compressEdges<Link>();
+
+		auto measure = [&](const char* name, std::size_t bytes, const auto& sinks) {
+			std::atomic<std::size_t> sum(0);
+			auto begin = std::chrono::high_resolution_clock::now();
+			m.pforAll<Vertex>([&](const auto& node){
+				std::size_t local = 0;
+				for(const auto& cur : sinks(node)) local += cur.id;
+				sum += local;
+			});
+			auto end = std::chrono::high_resolution_clock::now();
+			std::cout << name << ": " << (bytes >> 20) << "MB, "
+					<< std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms (checksum " << sum << ")\n";
+		};
+
+		std::size_t numEdges = m.getNumEdges<Link>();
+		measure("Uncompressed edges", 2 * numEdges * sizeof(NodeRef<Vertex>) + 2 * m.getNumNodes<Vertex>() * sizeof(std::size_t), [&](const auto& node) { return m.getSinks<Link>(node); });
+		measure("Compressed edges", compressed.getMemorySize(), [&](const auto& node) { return compressed.getSinks(node); });
+	}
+
+	TEST(DISABLED_Mesh, SparseProductBenchmark) {
+
+		struct Vertex {};
+		struct Link : public edge<Vertex,Vertex> {};
+
+		using Builder = MeshBuilder<nodes<Vertex>,edges<Link>,hierarchies<>,1>;
+
+		// a 7-point stencil on a 3D grid
+		const int N = 128;
+		auto id = [&](int x, int y, int z) { return NodeRef<Vertex>((x * N + y) * N + z); };
+		Builder mb;
+		mb.create<Vertex>(N*N*N);
+		for(int x=0; x<N; x++) {
+			for(int y=0; y<N; y++) {
+				for(int z=0; z<N; z++) {
+					mb.link<Link>(id(x,y,z),id(x,y,z));
+					if (x > 0)   mb.link<Link>(id(x,y,z),id(x-1,y,z));
+					if (x+1 < N) mb.link<Link>(id(x,y,z),id(x+1,y,z));
+					if (y > 0)   mb.link<Link>(id(x,y,z),id(x,y-1,z));
+					if (y+1 < N) mb.link<Link>(id(x,y,z),id(x,y+1,z));
+					if (z > 0)   mb.link<Link>(id(x,y,z),id(x,y,z-1));
+					if (z+1 < N) mb.link<Link>(id(x,y,z),id(x,y,z+1));
+				}
+			}
+		}
+		auto m = mb.build<8>();
+
+		std::size_t numNodes = m.getNumNodes<Vertex>();
+		std::size_t numEdges = m.getNumEdges<Link>();
+		std::vector<double> values(numEdges,1.0);
+
+		// reports the rate of the given operation, processing the given number of vectors and bytes per edge value
+		auto measure = [&](const char* name, std::size_t numVectors, std::size_t valueSize, const auto& op) {
+			const int repetitions = 10;
+			op();
+			auto begin = std::chrono::high_resolution_clock::now();
+			for(int i=0; i<repetitions; i++) op();
+			auto end = std::chrono::high_resolution_clock::now();
+			double seconds = std::chrono::duration<double>(end - begin).count() / repetitions;
+
+			// the minimal traffic: values, column indices, row offsets, and both vectors
+			double bytes = numEdges * (valueSize + sizeof(NodeID)) + numNodes * sizeof(std::uint64_t) + 2 * numNodes * numVectors * sizeof(double);
+			double flops = 2.0 * numEdges * numVectors;
+			std::cout << name << ": " << (seconds * 1000) << "ms, " << (flops / seconds / 1e9) << " GFLOP/s, " << (bytes / seconds / 1e9) << " GB/s\n";
+		};
+
+		auto x = m.createNodeData<Vertex,double>();
+		auto y = m.createNodeData<Vertex,double>();
+		m.pforAll<Vertex>([&](const auto& node){ x[node] = 1; });
+		measure("SpMV",1,sizeof(double),[&]{ m.multiply<Link>(values,x,y); });
+		measure("SpMV (transposed)",1,sizeof(double) + sizeof(std::size_t),[&]{ m.multiplyTransposed<Link>(values,x,y); });
+
+		// the traffic of the column indices is reduced by decoding a compressed relation, reported as if uncompressed
+		auto compressed = m.compressEdges<Link>();
+		measure("SpMV (compressed)",1,sizeof(double),[&]{ m.multiply(compressed,values,x,y); });
+
+		auto xs = m.createNodeData<Vertex,std::array<double,4>>();
+		auto ys = m.createNodeData<Vertex,std::array<double,4>>();
+		m.pforAll<Vertex>([&](const auto& node){ xs[node] = {{ 1, 2, 3, 4 }}; });
+		measure("SpMM (4 vectors)",4,sizeof(double),[&]{ m.multiply<Link>(values,xs,ys); });
+
+		// a product with unit values, computed through node-wise neighbor lookups
+		measure("Node loop",1,0,[&]{
+			m.pforAll<Vertex>([&](const auto& node){
+				double sum = 0;
+				for(const auto& cur : m.getSinks<Link>(node)) sum += x[cur];
+				y[node] = sum;
+			});
+		});
+	}
+
 	TEST(MeshData,IO) {
 
 		std::stringstream buffer(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
@@ -1835,6 +2894,57 @@ namespace data {
 
 	}
 
+	TEST(MeshData,MappedIO) {
+
+		auto& manager = core::FileIOManager::getInstance();
+		auto entry = manager.createEntry("mesh_data_mapped.bin",core::Mode::Binary);
+
+		// create a mesh
+		auto bar = createBarMesh<2,2>(50);
+
+		{ // -- creation --
+
+			// create some mesh data
+			auto data = bar.createNodeData<Vertex,int>();
+
+			// fill in some data
+			int c = 0;
+			bar.forAll<Vertex>([&](const NodeRef<Vertex>& node){
+				data[node] = c;
+				c++;
+			});
+
+			data.storeTo("mesh_data_mapped.bin");
+		}
+
+		{ // -- load mesh data through a memory mapping --
+
+			auto data = bar.mapNodeData<Vertex,int>("mesh_data_mapped.bin");
+			ASSERT_TRUE(data);
+
+			// check the content of the restored data
+			int c = 0;
+			bar.forAll<Vertex>([&](const NodeRef<Vertex>& node){
+				EXPECT_EQ(c,(*data)[node]);
+				c++;
+			});
+		}
+
+		// data of other types or levels is rejected
+		EXPECT_FALSE((bar.mapNodeData<Vertex,double>("mesh_data_mapped.bin")));
+		EXPECT_FALSE((bar.mapNodeData<Vertex,int,1>("mesh_data_mapped.bin")));
+
+		// as is data of a mesh of a different size
+		auto other = createBarMesh<2,2>(20);
+		EXPECT_FALSE((other.mapNodeData<Vertex,int>("mesh_data_mapped.bin")));
+
+		// and a mesh file
+		bar.storeTo("mesh_data_mapped.bin");
+		EXPECT_FALSE((bar.mapNodeData<Vertex,int>("mesh_data_mapped.bin")));
+
+		manager.remove(entry);
+	}
+
 #ifndef _MSC_VER
 
 	TEST(MeshProperties,Basic) {
@@ -1948,6 +3058,62 @@ namespace data {
 
 	}
 
+	TEST(MeshProperties,MappedIO) {
+
+		struct PropertyA : public mesh_property<Vertex,int> {};
+		struct PropertyB : public mesh_property<Vertex,double> {};
+
+		auto& manager = core::FileIOManager::getInstance();
+		auto entry = manager.createEntry("mesh_properties_mapped.bin",core::Mode::Binary);
+
+		// create a mesh
+		auto bar = createBarMesh<2,2>(50);
+
+		{ // -- creation --
+
+			// create some properties
+			auto props = bar.createProperties<PropertyA,PropertyB>();
+
+			// fill in some property data
+			int c = 0;
+			bar.forAll<Vertex>([&](const NodeRef<Vertex>& node){
+				props.get<PropertyA>()[node] = c;
+				props.get<PropertyB>()[node] = c + 0.5;
+				c++;
+			});
+			bar.forAll<Vertex,1>([&](const NodeRef<Vertex,1>& node){
+				props.get<PropertyA,1>()[node] = -c;
+				c++;
+			});
+
+			props.storeTo("mesh_properties_mapped.bin");
+		}
+
+		{ // -- load properties through a memory mapping --
+
+			auto props = bar.mapProperties<PropertyA,PropertyB>("mesh_properties_mapped.bin");
+			ASSERT_TRUE(props);
+
+			// check the content of the restored properties
+			int c = 0;
+			bar.forAll<Vertex>([&](const NodeRef<Vertex>& node){
+				EXPECT_EQ(c,props->get<PropertyA>()[node]);
+				EXPECT_DOUBLE_EQ(c + 0.5,props->get<PropertyB>()[node]);
+				c++;
+			});
+			bar.forAll<Vertex,1>([&](const NodeRef<Vertex,1>& node){
+				EXPECT_EQ(-c,(props->get<PropertyA,1>()[node]));
+				c++;
+			});
+		}
+
+		// other lists of properties are rejected
+		EXPECT_FALSE((bar.mapProperties<PropertyB,PropertyA>("mesh_properties_mapped.bin")));
+		EXPECT_FALSE((bar.mapProperties<PropertyA>("mesh_properties_mapped.bin")));
+
+		manager.remove(entry);
+	}
+
 #endif
 
 } // end namespace data
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "allscale/api/user/save_to_binary.h"
 
 namespace allscale {
@@ -52,8 +56,100 @@ TEST(SaveToBinary, ArtificialVectorOfVectors) {
 
 #endif
 
+	// columnar format
+	saveVecVecToFileColumnar(vecVec, filename);
+	loaded = readVecVecFromFileColumnar<double>(filename);
+
+	check(vecVec, loaded);
+	EXPECT_EQ(0, std::remove(filename.c_str()));
+
 }
 
+template<typename Manager>
+void testColumnarFormat(Manager& manager, std::size_t alignment) {
+	core::Entry entry = manager.createEntry("columns.dat", core::Mode::Binary);
+
+	// columns of different lengths, including an empty one
+	std::vector<std::vector<int>> columns(5);
+	for(std::size_t i = 0; i < columns.size(); ++i) {
+		for(std::size_t j = 0; j < i * 1000; ++j) {
+			columns[i].push_back(int(i * j));
+		}
+	}
+
+	// write it in small chunks
+	writeColumns(manager, entry, columns, true, 1000);
+
+	{
+		MappedColumns<int,Manager> mapped(manager, entry);
+		EXPECT_TRUE(mapped.isValid());
+		EXPECT_TRUE(mapped.hasChecksums());
+		EXPECT_TRUE(mapped.verify());
+		EXPECT_EQ(columns.size(), mapped.getNumColumns());
+
+		// columns are accessed in place, aligned as far as the mapping is
+		for(std::size_t i = 0; i < columns.size(); ++i) {
+			EXPECT_EQ(columns[i].size(), mapped.getColumnSize(i));
+			EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(mapped.getColumn(i)) % alignment);
+			EXPECT_EQ(columns[i], std::vector<int>(mapped.getColumn(i), mapped.getColumn(i) + mapped.getColumnSize(i)));
+		}
+		EXPECT_EQ(columns, mapped.toVectors());
+
+		// the element type is checked
+		MappedColumns<double,Manager> wrongType(manager, entry);
+		EXPECT_FALSE(wrongType.isValid());
+		EXPECT_FALSE(wrongType.verify());
+	}
+
+	// corrupted data is detected by checksums
+	detail::ColumnDescriptor descriptor;
+	manager.readAt(entry, sizeof(detail::ColumnarHeader) + 3 * sizeof(descriptor), reinterpret_cast<char*>(&descriptor), sizeof(descriptor));
+	int value = -1;
+	manager.writeAt(entry, descriptor.offset + 10 * sizeof(int), reinterpret_cast<const char*>(&value), sizeof(value));
+	{
+		MappedColumns<int,Manager> mapped(manager, entry);
+		EXPECT_TRUE(mapped.isValid());
+		EXPECT_FALSE(mapped.verify());
+	}
+
+	// without checksums, only the structure is validated
+	writeColumns(manager, entry, columns, false);
+	{
+		MappedColumns<int,Manager> mapped(manager, entry);
+		EXPECT_TRUE(mapped.isValid());
+		EXPECT_FALSE(mapped.hasChecksums());
+		EXPECT_TRUE(mapped.verify());
+		EXPECT_EQ(columns, mapped.toVectors());
+	}
+
+	// other data is rejected
+	std::string text = "this is not a columnar file, but it is long enough";
+	manager.writeChunked(entry, text.c_str(), text.size());
+	{
+		MappedColumns<int,Manager> mapped(manager, entry);
+		EXPECT_FALSE(mapped.isValid());
+	}
+
+	// as are truncated files
+	writeColumns(manager, entry, columns);
+	manager.resize(entry, 100);
+	{
+		MappedColumns<int,Manager> mapped(manager, entry);
+		EXPECT_FALSE(mapped.isValid());
+	}
+
+	manager.remove(entry);
+}
+
+TEST(SaveToBinary, ColumnarBuffers) {
+	core::BufferIOManager manager;
+	testColumnarFormat(manager, alignof(int));
+}
+
+TEST(SaveToBinary, ColumnarFiles) {
+	// files are mapped at page boundaries
+	testColumnarFormat(core::FileIOManager::getInstance(), COLUMN_ALIGNMENT);
+}
 
 } // end namespace user
 } // end namespace api
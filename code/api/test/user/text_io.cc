@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "allscale/api/user/text_io.h"
+
+namespace allscale {
+namespace api {
+namespace user {
+
+	TEST(TextIO, SplitAtLines) {
+
+		std::string text;
+		for(int i=0; i<1000; i++) {
+			text += std::to_string(i) + " " + std::to_string(i*i) + "\n";
+		}
+		const char* begin = text.c_str();
+		const char* end = begin + text.size();
+
+		auto bounds = splitAtLines(begin, end, 100);
+		EXPECT_LT(10, bounds.size());
+		EXPECT_EQ(begin, bounds.front());
+		EXPECT_EQ(end, bounds.back());
+
+		// all cuts are located at the start of lines
+		for(std::size_t i=1; i<bounds.size()-1; i++) {
+			EXPECT_LT(bounds[i-1], bounds[i]);
+			EXPECT_EQ('\n', *(bounds[i]-1));
+		}
+
+		// small texts are not split
+		EXPECT_EQ(2, splitAtLines(begin, end).size());
+		EXPECT_EQ(2, splitAtLines(begin, begin).size());
+	}
+
+	TEST(TextIO, PforLines) {
+
+		// the last line is not terminated
+		std::string text;
+		for(int i=0; i<10000; i++) {
+			if (i > 0) text += (i % 2) ? "\r\n" : "\n";
+			text += std::to_string(i) + " " + std::to_string(i / 4.0);
+		}
+
+		std::vector<int> ids(10000, -1);
+		std::vector<double> values(10000, -1);
+		std::atomic<int> failures(0);
+		auto lines = pforLines(text.c_str(), text.c_str() + text.size(), [&](std::size_t line, utils::TextReader& in) {
+			if (!(in >> ids[line] >> values[line]) || !in.atEnd()) failures++;
+		}, 1000);
+
+		EXPECT_EQ(10000, lines);
+		EXPECT_EQ(0, failures);
+		for(int i=0; i<10000; i++) {
+			EXPECT_EQ(i, ids[i]);
+			EXPECT_EQ(i / 4.0, values[i]);
+		}
+
+		// empty lines are counted
+		std::string empty = "\n\n";
+		EXPECT_EQ(2, pforLines(empty.c_str(), empty.c_str() + empty.size(), [](std::size_t, utils::TextReader& in) {
+			EXPECT_TRUE(in.atEnd());
+		}));
+	}
+
+	template<typename Manager>
+	void testTextRoundTrip(Manager& manager) {
+		const int N = 100000;
+
+		// write the coordinates of points in parallel
+		auto entry = manager.createEntry("coordinates.txt", core::Mode::Text);
+		writeLines(manager, entry, N, [](std::size_t i, utils::TextWriter& out) {
+			out << i << " " << (i * 0.1) << " " << -(i / 3.0);
+		}, 1000);
+
+		// parse them from the mapped file
+		std::vector<double> x(N), y(N);
+		std::atomic<int> failures(0);
+		auto lines = readLines(manager, entry, [&](std::size_t line, utils::TextReader& in) {
+			std::size_t i;
+			if (!(in >> i >> x[line] >> y[line]) || i != line) failures++;
+		}, 4096);
+		EXPECT_EQ(N, lines);
+		EXPECT_EQ(0, failures);
+		for(int i=0; i<N; i++) {
+			EXPECT_EQ(i * 0.1, x[i]);
+			EXPECT_EQ(-(i / 3.0), y[i]);
+		}
+
+		// the text is compatible to formatted stream input
+		auto in = manager.openInputStream(entry);
+		for(int i=0; i<N; i += 1) {
+			std::size_t j = 0;
+			double a = 0, b = 0;
+			in >> j >> a >> b;
+			EXPECT_EQ(i, j);
+			EXPECT_EQ(i * 0.1, a);
+			EXPECT_EQ(-(i / 3.0), b);
+		}
+		manager.close(in);
+
+		// rewriting replaces the content
+		writeLines(manager, entry, 1, [](std::size_t, utils::TextWriter& out) {
+			out << "end";
+		});
+		std::vector<std::string> words(1);
+		EXPECT_EQ(1, readLines(manager, entry, [&](std::size_t line, utils::TextReader& in) {
+			in >> words[line];
+		}));
+		EXPECT_EQ("end", words[0]);
+
+		manager.remove(entry);
+	}
+
+	TEST(TextIO, BufferRoundTrip) {
+		core::BufferIOManager manager;
+		testTextRoundTrip(manager);
+	}
+
+	TEST(TextIO, FileRoundTrip) {
+		testTextRoundTrip(core::FileIOManager::getInstance());
+	}
+
+	TEST(DISABLED_TextIO, Benchmark) {
+
+		// 10M lines of coordinates
+		const int N = 10*1000*1000;
+		const int R = 3;
+
+		auto time = [](const std::string& name, const auto& op) {
+			auto begin = std::chrono::high_resolution_clock::now();
+			op();
+			auto end = std::chrono::high_resolution_clock::now();
+			std::cout << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+		};
+
+		core::FileIOManager& manager = core::FileIOManager::getInstance();
+		auto entry = manager.createEntry("coordinates.txt", core::Mode::Text);
+		std::vector<double> x(N), y(N);
+
+		for(int r=0; r<R; r++) {
+
+			// -- formatted stream IO --
+
+			time("streams - write", [&]{
+				auto out = manager.openOutputStream(entry);
+				for(int i=0; i<N; i++) {
+					out << (i * 0.1) << " " << -(i / 3.0) << "\n";
+				}
+				manager.close(out);
+			});
+
+			time("streams - read", [&]{
+				auto in = manager.openInputStream(entry);
+				for(int i=0; i<N; i++) {
+					in >> x[i] >> y[i];
+				}
+				manager.close(in);
+			});
+
+			// -- parallel text IO --
+
+			time("text io - write", [&]{
+				writeLines(manager, entry, N, [](std::size_t i, utils::TextWriter& out) {
+					out << (i * 0.1) << " " << -(i / 3.0);
+				});
+			});
+
+			time("text io - read", [&]{
+				readLines(manager, entry, [&](std::size_t i, utils::TextReader& in) {
+					in >> x[i] >> y[i];
+				});
+			});
+			EXPECT_EQ(-((N-1) / 3.0), y[N-1]);
+		}
+
+		manager.remove(entry);
+	}
+
+} // end namespace user
+} // end namespace api
+} // end namespace allscale
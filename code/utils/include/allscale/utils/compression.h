@@ -0,0 +1,591 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "allscale/utils/assert.h"
+#include "allscale/utils/serializer.h"
+
+namespace allscale {
+namespace utils {
+
+	/**
+	 * The default number of bytes compressed into a single, independently decodable chunk.
+	 */
+	constexpr std::size_t DEFAULT_COMPRESSION_CHUNK_SIZE = 256 * 1024;
+
+	/**
+	 * The filters applied to data before it gets compressed, rearranging it such that
+	 * it compresses better. Both filters treat the data as a sequence of elements of
+	 * a fixed size.
+	 *
+	 *  - Shuffle groups the i-th bytes of all elements, such that e.g. the similar
+	 *    sign and exponent bytes of floating point values end up next to each other
+	 *  - Delta replaces elements, interpreted as unsigned integers of 1, 2, 4, or 8
+	 *    bytes, by their difference to their predecessor
+	 */
+	enum class CompressionFilter : std::uint8_t {
+		None = 0,
+		Shuffle = 1,
+		Delta = 2,
+		DeltaShuffle = 3
+	};
+
+	/**
+	 * The parameters of a compression.
+	 */
+	struct CompressionOptions {
+
+		// the filter to be applied before compressing data
+		CompressionFilter filter = CompressionFilter::Shuffle;
+
+		// the size of the elements the filters are operating on
+		std::uint8_t elementSize = 8;
+
+		// the number of bytes to be compressed into a single chunk
+		std::size_t chunkSize = DEFAULT_COMPRESSION_CHUNK_SIZE;
+
+	};
+
+	namespace detail {
+
+		// -- filters --
+
+		inline void shuffle(const char* src, char* dst, std::size_t size, std::size_t elementSize) {
+			std::size_t n = size / elementSize;
+			for(std::size_t i = 0; i < n; ++i) {
+				for(std::size_t j = 0; j < elementSize; ++j) {
+					dst[j * n + i] = src[i * elementSize + j];
+				}
+			}
+			// trailing bytes of an incomplete element are kept in place
+			std::memcpy(dst + n * elementSize, src + n * elementSize, size - n * elementSize);
+		}
+
+		inline void unshuffle(const char* src, char* dst, std::size_t size, std::size_t elementSize) {
+			std::size_t n = size / elementSize;
+			for(std::size_t i = 0; i < n; ++i) {
+				for(std::size_t j = 0; j < elementSize; ++j) {
+					dst[i * elementSize + j] = src[j * n + i];
+				}
+			}
+			std::memcpy(dst + n * elementSize, src + n * elementSize, size - n * elementSize);
+		}
+
+		template<typename T>
+		void delta(char* data, std::size_t size) {
+			std::size_t n = size / sizeof(T);
+			T last = 0;
+			for(std::size_t i = 0; i < n; ++i) {
+				T cur;
+				std::memcpy(&cur, data + i * sizeof(T), sizeof(T));
+				T diff = T(cur - last);
+				std::memcpy(data + i * sizeof(T), &diff, sizeof(T));
+				last = cur;
+			}
+		}
+
+		template<typename T>
+		void undelta(char* data, std::size_t size) {
+			std::size_t n = size / sizeof(T);
+			T last = 0;
+			for(std::size_t i = 0; i < n; ++i) {
+				T diff;
+				std::memcpy(&diff, data + i * sizeof(T), sizeof(T));
+				last = T(last + diff);
+				std::memcpy(data + i * sizeof(T), &last, sizeof(T));
+			}
+		}
+
+		inline void delta(char* data, std::size_t size, std::size_t elementSize, bool inverse) {
+			switch(elementSize) {
+				case 1: return (inverse) ? undelta<std::uint8_t>(data, size) : delta<std::uint8_t>(data, size);
+				case 2: return (inverse) ? undelta<std::uint16_t>(data, size) : delta<std::uint16_t>(data, size);
+				case 4: return (inverse) ? undelta<std::uint32_t>(data, size) : delta<std::uint32_t>(data, size);
+				case 8: return (inverse) ? undelta<std::uint64_t>(data, size) : delta<std::uint64_t>(data, size);
+			}
+			assert_fail() << "Unsupported element size for delta filter: " << elementSize;
+		}
+
+		inline bool isValidFilter(std::uint8_t filter, std::size_t elementSize) {
+			if (filter > std::uint8_t(CompressionFilter::DeltaShuffle) || elementSize == 0) return false;
+			if (!(filter & std::uint8_t(CompressionFilter::Delta))) return true;
+			return elementSize == 1 || elementSize == 2 || elementSize == 4 || elementSize == 8;
+		}
+
+		// -- LZ codec --
+
+		/**
+		 * The block format of the LZ codec is a sequence of (literals, match) pairs, each encoded by
+		 *  - a token, whose upper 4 bits hold the number of literals and lower 4 bits the match length - 4,
+		 *  - additional bytes of the literal count if it is at least 15, each adding up to 255,
+		 *  - the literals,
+		 *  - a 2-byte little-endian offset of the match, counting backwards from the current position,
+		 *  - additional bytes of the match length if it is at least 19, each adding up to 255.
+		 * The final pair consists of literals only.
+		 */
+		constexpr std::size_t LZ_MIN_MATCH = 4;
+		constexpr std::size_t LZ_MAX_OFFSET = 65535;
+		constexpr std::size_t LZ_LAST_LITERALS = 5;
+		constexpr int LZ_HASH_BITS = 14;
+		constexpr int LZ_MAX_CHAIN = 4;
+
+		inline std::uint32_t lzRead32(const unsigned char* pos) {
+			std::uint32_t res;
+			std::memcpy(&res, pos, sizeof(res));
+			return res;
+		}
+
+		inline std::uint32_t lzHash(std::uint32_t value) {
+			return (value * 2654435761u) >> (32 - LZ_HASH_BITS);
+		}
+
+		// determines the number of equal bytes at the given positions, skipping equal words first
+		inline std::size_t lzMatchLength(const unsigned char* a, const unsigned char* b, const unsigned char* end) {
+			const unsigned char* begin = b;
+			while(b + sizeof(std::uint64_t) <= end) {
+				std::uint64_t x, y;
+				std::memcpy(&x, a, sizeof(x));
+				std::memcpy(&y, b, sizeof(y));
+				if (x != y) break;
+				a += sizeof(std::uint64_t);
+				b += sizeof(std::uint64_t);
+			}
+			while(b < end && *a == *b) {
+				++a;
+				++b;
+			}
+			return b - begin;
+		}
+
+		/**
+		 * Compresses the given data into the given buffer.
+		 *
+		 * @return the size of the compressed data, or 0 if it would exceed the capacity of the buffer
+		 */
+		inline std::size_t lzCompress(const char* data, std::size_t size, char* buffer, std::size_t capacity) {
+			auto src = reinterpret_cast<const unsigned char*>(data);
+			auto dst = reinterpret_cast<unsigned char*>(buffer);
+			std::size_t out = 0;
+
+			auto writeLength = [&](std::size_t length) {
+				for(; length >= 255; length -= 255) {
+					if (out >= capacity) return false;
+					dst[out++] = 255;
+				}
+				if (out >= capacity) return false;
+				dst[out++] = (unsigned char)length;
+				return true;
+			};
+
+			auto writeSequence = [&](std::size_t anchor, std::size_t literals, std::size_t offset, std::size_t match) {
+				if (out >= capacity) return false;
+				std::size_t matchCode = (match > 0) ? match - LZ_MIN_MATCH : 0;
+				dst[out++] = (unsigned char)(((literals < 15) ? literals : 15) << 4 | ((matchCode < 15) ? matchCode : 15));
+				if (literals >= 15 && !writeLength(literals - 15)) return false;
+				if (literals > capacity - out) return false;
+				std::memcpy(dst + out, src + anchor, literals);
+				out += literals;
+				if (match == 0) return true;
+				if (2 > capacity - out) return false;
+				dst[out++] = (unsigned char)(offset & 0xff);
+				dst[out++] = (unsigned char)(offset >> 8);
+				return matchCode < 15 || writeLength(matchCode - 15);
+			};
+
+			// positions are linked to their predecessors sharing the same hash
+			const std::uint32_t none = ~std::uint32_t(0);
+			std::vector<std::uint32_t> heads(std::size_t(1) << LZ_HASH_BITS, none);
+			std::vector<std::uint32_t> chain(size, none);
+			auto insert = [&](std::size_t pos) {
+				auto& head = heads[lzHash(lzRead32(src + pos))];
+				chain[pos] = head;
+				head = std::uint32_t(pos);
+			};
+
+			std::size_t pos = 0;
+			std::size_t anchor = 0;
+			while(pos + LZ_MIN_MATCH + LZ_LAST_LITERALS <= size) {
+
+				// find the longest match among the most recent positions with the same hash, keeping the last bytes as literals
+				std::size_t limit = size - LZ_LAST_LITERALS;
+				std::size_t best = 0;
+				std::size_t bestLength = 0;
+				std::uint32_t prefix = lzRead32(src + pos);
+				std::uint32_t candidate = heads[lzHash(prefix)];
+				for(int i = 0; i < LZ_MAX_CHAIN && candidate != none && pos - candidate <= LZ_MAX_OFFSET; ++i, candidate = chain[candidate]) {
+					if (src[candidate + bestLength] != src[pos + bestLength] || lzRead32(src + candidate) != prefix) continue;
+					std::size_t length = lzMatchLength(src + candidate + LZ_MIN_MATCH, src + pos + LZ_MIN_MATCH, src + limit) + LZ_MIN_MATCH;
+					if (length > bestLength) {
+						best = candidate;
+						bestLength = length;
+					}
+				}
+				insert(pos);
+
+				if (bestLength < LZ_MIN_MATCH) {
+					// skip faster through data without matches
+					pos += 1 + ((pos - anchor) >> 6);
+					continue;
+				}
+
+				if (!writeSequence(anchor, pos - anchor, pos - best, bestLength)) return 0;
+
+				// record the positions covered by the match for future references
+				for(std::size_t i = pos + 1; i < pos + bestLength && i + LZ_MIN_MATCH <= size; ++i) insert(i);
+				pos += bestLength;
+				anchor = pos;
+			}
+
+			// the remaining data is stored as literals
+			if (!writeSequence(anchor, size - anchor, 0, 0)) return 0;
+			return out;
+		}
+
+		/**
+		 * Decompresses the given data into the given buffer, which has to be filled exactly.
+		 *
+		 * @return true if the data was well-formed, false otherwise
+		 */
+		inline bool lzDecompress(const char* data, std::size_t size, char* buffer, std::size_t capacity) {
+			auto src = reinterpret_cast<const unsigned char*>(data);
+			auto dst = reinterpret_cast<unsigned char*>(buffer);
+			std::size_t in = 0;
+			std::size_t out = 0;
+
+			auto readLength = [&](std::size_t& length) {
+				while(true) {
+					if (in >= size) return false;
+					unsigned char cur = src[in++];
+					length += cur;
+					if (cur != 255) return true;
+				}
+			};
+
+			while(in < size) {
+				unsigned char token = src[in++];
+
+				// copy literals
+				std::size_t literals = token >> 4;
+				if (literals == 15 && !readLength(literals)) return false;
+				if (literals > size - in || literals > capacity - out) return false;
+				std::memcpy(dst + out, src + in, literals);
+				in += literals;
+				out += literals;
+
+				// the last sequence has no match
+				if (in == size) break;
+
+				// copy the match, which may overlap with its own output
+				if (2 > size - in) return false;
+				std::size_t offset = src[in] | (std::size_t(src[in+1]) << 8);
+				in += 2;
+				std::size_t length = token & 0xf;
+				if (length == 15 && !readLength(length)) return false;
+				length += LZ_MIN_MATCH;
+				if (offset == 0 || offset > out || length > capacity - out) return false;
+				const unsigned char* match = dst + out - offset;
+				if (offset >= length) {
+					std::memcpy(dst + out, match, length);
+				} else {
+					for(std::size_t i = 0; i < length; ++i) dst[out + i] = match[i];
+				}
+				out += length;
+			}
+
+			return out == capacity;
+		}
+
+		// -- chunks --
+
+		/**
+		 * The header of each chunk of compressed data.
+		 */
+		struct ChunkHeader {
+			std::uint32_t rawSize;
+			std::uint32_t storedSize;
+			std::uint8_t filter;
+			std::uint8_t elementSize;
+			std::uint8_t codec;
+			std::uint8_t reserved;
+		};
+
+		static_assert(sizeof(ChunkHeader) == 12, "Unexpected padding in chunk header!");
+
+		constexpr std::uint8_t CODEC_STORED = 0;
+		constexpr std::uint8_t CODEC_LZ = 1;
+
+		/**
+		 * Creates the header of the chunk terminating a stream of chunks. It is the only
+		 * chunk without any data, since no empty chunks are produced otherwise.
+		 */
+		inline ChunkHeader endOfStream() {
+			ChunkHeader header;
+			header.rawSize = 0;
+			header.storedSize = 0;
+			header.filter = 0;
+			header.elementSize = 1;
+			header.codec = CODEC_STORED;
+			header.reserved = 0;
+			return header;
+		}
+
+	} // end namespace detail
+
+	/**
+	 * Compresses the given data into a single, self-contained chunk, which is appended to the given buffer.
+	 * The data may not exceed 4 GiB.
+	 */
+	inline void compressChunk(const char* data, std::size_t size, const CompressionOptions& options, std::vector<char>& res) {
+		assert_lt(size, std::size_t(1) << 32);
+		assert_true(detail::isValidFilter(std::uint8_t(options.filter), options.elementSize))
+			<< "Invalid filter " << int(options.filter) << " for elements of size " << int(options.elementSize);
+
+		detail::ChunkHeader header;
+		header.rawSize = std::uint32_t(size);
+		header.filter = std::uint8_t(options.filter);
+		header.elementSize = options.elementSize;
+		header.codec = detail::CODEC_LZ;
+		header.reserved = 0;
+
+		// apply the filters
+		std::unique_ptr<char[]> filtered;
+		const char* input = data;
+		if (options.filter != CompressionFilter::None) {
+			filtered.reset(new char[size]);
+			std::unique_ptr<char[]> temp;
+			const char* cur = data;
+			if (std::uint8_t(options.filter) & std::uint8_t(CompressionFilter::Delta)) {
+				temp.reset(new char[size]);
+				std::memcpy(temp.get(), data, size);
+				detail::delta(temp.get(), size, options.elementSize, false);
+				cur = temp.get();
+			}
+			if (std::uint8_t(options.filter) & std::uint8_t(CompressionFilter::Shuffle)) {
+				detail::shuffle(cur, filtered.get(), size, options.elementSize);
+			} else {
+				std::memcpy(filtered.get(), cur, size);
+			}
+			input = filtered.get();
+		}
+
+		// compress the data, keeping it uncompressed if it does not get smaller
+		std::size_t start = res.size();
+		res.resize(start + sizeof(header) + size);
+		char* payload = res.data() + start + sizeof(header);
+		std::size_t compressed = detail::lzCompress(input, size, payload, size);
+		if (compressed == 0) {
+			header.filter = std::uint8_t(CompressionFilter::None);
+			header.codec = detail::CODEC_STORED;
+			std::memcpy(payload, data, size);
+			compressed = size;
+		}
+		header.storedSize = std::uint32_t(compressed);
+		std::memcpy(res.data() + start, &header, sizeof(header));
+		res.resize(start + sizeof(header) + compressed);
+	}
+
+	/**
+	 * Obtains the size of the chunk starting at the given position and the size of its uncompressed data.
+	 *
+	 * @return false if there is no complete chunk at the given position
+	 */
+	inline bool getChunkSize(const char* data, std::size_t size, std::size_t& chunkSize, std::size_t& rawSize) {
+		detail::ChunkHeader header;
+		if (size < sizeof(header)) return false;
+		std::memcpy(&header, data, sizeof(header));
+		if (header.storedSize > size - sizeof(header)) return false;
+		chunkSize = sizeof(header) + header.storedSize;
+		rawSize = header.rawSize;
+		return true;
+	}
+
+	/**
+	 * Decompresses the chunk of the given size into the given buffer, which has to be large enough
+	 * to hold the uncompressed data of the chunk.
+	 *
+	 * @return false if the chunk is malformed
+	 */
+	inline bool decompressChunk(const char* chunk, std::size_t size, char* res) {
+		detail::ChunkHeader header;
+		if (size < sizeof(header)) return false;
+		std::memcpy(&header, chunk, sizeof(header));
+		if (header.storedSize != size - sizeof(header)) return false;
+		if (!detail::isValidFilter(header.filter, header.elementSize)) return false;
+		const char* payload = chunk + sizeof(header);
+
+		// stored chunks are not filtered
+		if (header.codec == detail::CODEC_STORED) {
+			if (header.storedSize != header.rawSize || header.filter != 0) return false;
+			std::memcpy(res, payload, header.rawSize);
+			return true;
+		}
+		if (header.codec != detail::CODEC_LZ) return false;
+
+		// decompress and revert the filters
+		if (!(header.filter & std::uint8_t(CompressionFilter::Shuffle))) {
+			if (!detail::lzDecompress(payload, header.storedSize, res, header.rawSize)) return false;
+		} else {
+			std::unique_ptr<char[]> temp(new char[header.rawSize]);
+			if (!detail::lzDecompress(payload, header.storedSize, temp.get(), header.rawSize)) return false;
+			detail::unshuffle(temp.get(), res, header.rawSize, header.elementSize);
+		}
+		if (header.filter & std::uint8_t(CompressionFilter::Delta)) {
+			detail::delta(res, header.rawSize, header.elementSize, true);
+		}
+		return true;
+	}
+
+	/**
+	 * Compresses the given data into a sequence of chunks.
+	 */
+	inline std::vector<char> compress(const char* data, std::size_t size, const CompressionOptions& options = CompressionOptions()) {
+		assert_lt(0u, options.chunkSize);
+		std::vector<char> res;
+		for(std::size_t begin = 0; begin < size; begin += options.chunkSize) {
+			compressChunk(data + begin, std::min(options.chunkSize, size - begin), options, res);
+		}
+		return res;
+	}
+
+	/**
+	 * Decompresses the given sequence of chunks, appending the data to the given buffer.
+	 *
+	 * @return false if the data is malformed
+	 */
+	inline bool decompress(const char* data, std::size_t size, std::vector<char>& res) {
+		const char* end = data + size;
+		while(data != end) {
+			std::size_t chunkSize, rawSize;
+			if (!getChunkSize(data, end - data, chunkSize, rawSize)) return false;
+			std::size_t start = res.size();
+			res.resize(start + rawSize);
+			if (!decompressChunk(data, chunkSize, res.data() + start)) return false;
+			data += chunkSize;
+		}
+		return true;
+	}
+
+#if !defined(ALLSCALE_WITH_HPX)
+
+	namespace detail {
+
+		/**
+		 * A sink for chunks appending the end-of-stream chunk once it is no longer
+		 * referenced, i.e. after the last flush of the writer using it.
+		 */
+		struct TerminatingSink {
+
+			ArchiveWriter::Sink sink;
+
+			explicit TerminatingSink(ArchiveWriter::Sink sink) : sink(std::move(sink)) {}
+
+			TerminatingSink(const TerminatingSink&) = delete;
+			TerminatingSink& operator=(const TerminatingSink&) = delete;
+
+			~TerminatingSink() {
+				ChunkHeader header = endOfStream();
+				sink(reinterpret_cast<const char*>(&header), sizeof(header));
+			}
+		};
+
+	} // end namespace detail
+
+	/**
+	 * Creates an archive writer compressing its data chunk by chunk, handing the resulting
+	 * sequence of chunks to the given sink. Once the writer is destroyed, the sequence is
+	 * terminated by an empty chunk, such that readers stop in front of any subsequent data.
+	 */
+	inline ArchiveWriter createCompressingWriter(ArchiveWriter::Sink sink, const CompressionOptions& options = CompressionOptions()) {
+		auto out = std::make_shared<detail::TerminatingSink>(std::move(sink));
+		return ArchiveWriter([out,options](const char* data, std::size_t size) {
+			std::vector<char> chunks = compress(data, size, options);
+			out->sink(chunks.data(), chunks.size());
+		}, options.chunkSize);
+	}
+
+	/**
+	 * Creates an archive reader consuming a sequence of compressed chunks provided by the given source.
+	 * The reader stops at the chunk terminating the sequence; once it is destroyed, the source is
+	 * positioned right after that chunk, such that subsequent data can be read from it.
+	 */
+	inline ArchiveReader createDecompressingReader(ArchiveReader::Source source) {
+
+		struct State {
+			ArchiveReader::Source source;
+			std::vector<char> chunk;
+			std::vector<char> data;
+			std::size_t pos = 0;
+			bool ended = false;
+
+			bool readFully(char* dst, std::size_t count) {
+				while(count > 0) {
+					auto res = source(dst, count);
+					if (res == 0) return false;
+					dst += res;
+					count -= res;
+				}
+				return true;
+			}
+
+			// reads the header of the next chunk, false at the end of the stream
+			bool nextHeader(detail::ChunkHeader& header) {
+				if (ended) return false;
+				chunk.resize(sizeof(header));
+				if (!readFully(chunk.data(), sizeof(header))) return false;
+				std::memcpy(&header, chunk.data(), sizeof(header));
+
+				// stop at the end of the stream, without touching any data following it
+				if (header.rawSize == 0) {
+					ended = true;
+					return false;
+				}
+
+				// chunks are never stored larger than their data
+				bool ok = header.storedSize <= header.rawSize;
+				assert_true(ok) << "Malformed compressed data!";
+				if (!ok) return false;
+
+				chunk.resize(sizeof(header) + header.storedSize);
+				ok = readFully(chunk.data() + sizeof(header), header.storedSize);
+				assert_true(ok) << "Unexpected end of compressed data!";
+				return ok;
+			}
+
+			bool nextChunk() {
+				detail::ChunkHeader header;
+				if (!nextHeader(header)) return false;
+				data.resize(header.rawSize);
+				bool ok = decompressChunk(chunk.data(), chunk.size(), data.data());
+				assert_true(ok) << "Malformed compressed data!";
+				pos = 0;
+				return ok;
+			}
+
+			~State() {
+				// skip chunks not consumed, leaving the source positioned after the stream
+				detail::ChunkHeader header;
+				while(nextHeader(header)) {}
+			}
+		};
+
+		auto state = std::make_shared<State>();
+		state->source = std::move(source);
+		return ArchiveReader([state](char* dst, std::size_t count) -> std::size_t {
+			while(state->pos == state->data.size()) {
+				if (!state->nextChunk()) return 0;
+			}
+			std::size_t res = std::min(count, state->data.size() - state->pos);
+			std::memcpy(dst, state->data.data() + state->pos, res);
+			state->pos += res;
+			return res;
+		});
+	}
+
+#endif
+
+} // end namespace utils
+} // end namespace allscale
@@ -1,6 +1,7 @@
 #pragma once
 
 #ifndef _MSC_VER
+	#include <fcntl.h>
 	#include <sys/mman.h>
 	#include <unistd.h>
 #else
@@ -10,9 +11,13 @@
 #endif
 
 #include <cstddef>
+#include <cstdint>
 
 #include <algorithm>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "allscale/utils/assert.h"
 
@@ -50,6 +55,23 @@ namespace utils {
 				return res;
 			}
 
+			/**
+			 * A factory function creating a list of intervals covering the union of the given,
+			 * potentially unsorted and overlapping ranges [begin,end).
+			 */
+			static Intervals fromRanges(std::vector<std::pair<std::size_t,std::size_t>> ranges) {
+				// sort ranges by their start
+				std::sort(ranges.begin(), ranges.end());
+
+				// coalesce ranges in a single pass
+				Intervals res;
+				res.data.reserve(ranges.size() * 2);
+				for(const auto& cur : ranges) {
+					res.append(cur.first, cur.second);
+				}
+				return res;
+			}
+
 			/**
 			 * Compares this and the given intervals for equality.
 			 */
@@ -232,14 +254,64 @@ namespace utils {
 			}
 
 			/**
-			 * Removes the given intervals from the covered range.
+			 * Adds the given intervals to the covered range in a single merge pass.
+			 * @param other the intervals to be added
+			 */
+			void add(const Intervals& other) {
+
+				// quick exits
+				if (other.empty()) return;
+				if (empty()) {
+					data = other.data;
+					return;
+				}
+
+				// merge the two sorted lists of intervals
+				Intervals res;
+				res.data.reserve(data.size() + other.data.size());
+				std::size_t i = 0;
+				std::size_t j = 0;
+				while(i < data.size() || j < other.data.size()) {
+					if (j >= other.data.size() || (i < data.size() && data[i] <= other.data[j])) {
+						res.append(data[i],data[i+1]);
+						i += 2;
+					} else {
+						res.append(other.data[j],other.data[j+1]);
+						j += 2;
+					}
+				}
+				swap(res);
+			}
+
+			/**
+			 * Removes the given intervals from the covered range in a single merge pass.
 			 * @param other the intervals to be removed
 			 */
 			void remove(const Intervals& other) {
-				// iteratively remove the elements of the given interval
-				for(std::size_t i =0; i<other.data.size(); i+=2) {
-					remove(other.data[i],other.data[i+1]);
+
+				// quick exits
+				if (empty() || other.empty()) return;
+
+				Intervals res;
+				res.data.reserve(data.size() + other.data.size());
+				std::size_t j = 0;
+				for(std::size_t i = 0; i<data.size(); i+=2) {
+					std::size_t from = data[i];
+					std::size_t to = data[i+1];
+
+					// skip removed intervals ending before the current interval
+					while(j < other.data.size() && other.data[j+1] <= from) j += 2;
+
+					// cut out the removed intervals overlapping with the current interval
+					for(std::size_t k = j; k < other.data.size() && other.data[k] < to; k += 2) {
+						res.append(from, other.data[k]);
+						from = std::max(from, other.data[k+1]);
+					}
+
+					// add the remaining tail
+					res.append(from,to);
 				}
+				swap(res);
 			}
 
 			/**
@@ -277,10 +349,20 @@ namespace utils {
 			 * @param other the range of entries to be retained
 			 */
 			void retain(const Intervals& other) {
-				invert();
-				auto tmp = other;
-				tmp.remove(*this);
-				swap(tmp);
+
+				// intersect the two sorted lists of intervals
+				Intervals res;
+				std::size_t i = 0;
+				std::size_t j = 0;
+				while(i < data.size() && j < other.data.size()) {
+					res.append(std::max(data[i],other.data[j]), std::min(data[i+1],other.data[j+1]));
+					if (data[i+1] < other.data[j+1]) {
+						i += 2;
+					} else {
+						j += 2;
+					}
+				}
+				swap(res);
 			}
 
 			/**
@@ -340,6 +422,17 @@ namespace utils {
 				}
 			}
 
+			/**
+			 * Invokes the given function for each of the covered intervals, passing
+			 * its start (inclusive) and end (exclusive).
+			 */
+			template<typename Fun>
+			void forEachInterval(const Fun& fun) const {
+				for(std::size_t i =0; i<data.size(); i+=2) {
+					fun(data[i],data[i+1]);
+				}
+			}
+
 			/**
 			 * Enables the printing of the list of intervals.
 			 */
@@ -352,11 +445,94 @@ namespace utils {
 				return out << "}";
 			}
 
+		private:
+
+			/**
+			 * Appends the interval [from,to) to the end of this list, where from must not be
+			 * smaller than the start of the last interval. Overlapping or adjacent intervals are fused.
+			 */
+			void append(std::size_t from, std::size_t to) {
+				if (from >= to) return;
+				if (!data.empty() && from <= data.back()) {
+					data.back() = std::max(data.back(),to);
+					return;
+				}
+				data.push_back(from);
+				data.push_back(to);
+			}
+
 		};
 
+		/**
+		 * Converts the given region into the list of flattened index intervals it is covering,
+		 * where the given function maps the end points of the lines of the region to their index.
+		 */
+		template<typename Region, typename Flatten>
+		Intervals toIntervals(const Region& region, const Flatten& flatten) {
+			std::vector<std::pair<std::size_t,std::size_t>> lines;
+			region.scanByLines([&](const auto& a, const auto& b){
+				lines.push_back({ flatten(a), flatten(b) });
+			});
+			return Intervals::fromRanges(std::move(lines));
+		}
+
 	} // end namespace detail
 
 
+	/**
+	 * The paging policies supported by the LargeArray class for the reserved address space.
+	 */
+	enum class PagingPolicy {
+
+		/**
+		 * The address space is backed by pages of the system's default page size.
+		 */
+		Default,
+
+		/**
+		 * The address space is aligned to huge page boundaries and advised to be backed
+		 * by transparent huge pages, reducing the number of page faults and TLB misses
+		 * for large, densely used arrays.
+		 */
+		HugePages
+
+	};
+
+
+	/**
+	 * The access patterns that may be announced to a LargeArray to guide the paging of its content.
+	 */
+	enum class AccessPattern {
+
+		/**
+		 * No special treatment, the default.
+		 */
+		Normal,
+
+		/**
+		 * The range is about to be accessed in sequential order.
+		 */
+		Sequential,
+
+		/**
+		 * The range is about to be accessed in random order.
+		 */
+		Random,
+
+		/**
+		 * The range is about to be accessed soon and should be loaded ahead of time.
+		 */
+		WillNeed,
+
+		/**
+		 * The range will not be accessed soon and its memory may be reclaimed. Only
+		 * effective for file-backed arrays, where the content is preserved in the file.
+		 */
+		DontNeed
+
+	};
+
+
 	/**
 	 * A large array is an array of objects of type T which can be manually allocated or discarded. The memory
 	 * requirements of the array only covers those elements which have been marked active and have actually been used.
@@ -379,12 +555,27 @@ namespace utils {
 		 */
 		detail::Intervals active_ranges;
 
+		/**
+		 * The paging policy utilized for the reserved address space.
+		 */
+		PagingPolicy paging;
+
+		/**
+		 * The descriptor of the file backing this array, -1 if backed by anonymous memory.
+		 */
+		int fd;
+
 	public:
 
+		/**
+		 * The size of huge pages targeted by the HugePages paging policy.
+		 */
+		static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
 		/**
 		 * Creates a new large array of the given size.
 		 */
-		LargeArray(std::size_t size) : data(nullptr), size(size) {
+		LargeArray(std::size_t size, PagingPolicy paging = PagingPolicy::Default) : data(nullptr), size(size), paging(paging), fd(-1) {
 
 			// check whether there is something to allocate
 			if (size == 0) return;
@@ -394,13 +585,51 @@ namespace utils {
 				data = (T*)malloc(sizeof(T)*size);
 				assert_true(data != nullptr) << "Failed to allocate memory of size" << sizeof(T)*size;
 			#else
+				if (paging == PagingPolicy::HugePages) {
+					data = reserveHugePageAligned(sizeof(T)*size);
+				} else {
+					data = (T*)mmap(nullptr,sizeof(T)*size,
+							PROT_READ | PROT_WRITE,
+							MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE,
+							-1,0
+						);
+				}
+			#endif
+			assert_ne((void*)-1,(void*)data);
+		}
+
+		/**
+		 * Creates a new large array of the given size backed by the given file, which is
+		 * created if necessary and extended to a sparse file of the required size. Only
+		 * allocated ranges occupy space in the file; freed ranges are punched out. This
+		 * way, arrays exceeding the main memory may be maintained on local storage.
+		 */
+		LargeArray(std::size_t size, const std::string& file) : data(nullptr), size(size), paging(PagingPolicy::Default), fd(-1) {
+
+			#ifdef _MSC_VER
+				assert_fail() << "File-backed large arrays are not supported on this platform.";
+				(void)file;
+			#else
+				// open the backing file
+				fd = open(file.c_str(), O_RDWR | O_CREAT, 0600);
+				assert_ne(-1,fd) << "Unable to open backing file " << file;
+
+				// check whether there is something to allocate
+				if (size == 0) return;
+
+				// extend the file to the required size (without allocating storage)
+				auto res = ftruncate(fd, sizeof(T)*size);
+				assert_eq(0,res) << "Unable to resize backing file " << file << " to " << sizeof(T)*size << " bytes";
+				(void)res;
+
+				// map the file into the address space
 				data = (T*)mmap(nullptr,sizeof(T)*size,
 						PROT_READ | PROT_WRITE,
-						MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE,
-						-1,0
+						MAP_SHARED | MAP_NORESERVE,
+						fd,0
 					);
+				assert_ne((void*)-1,(void*)data);
 			#endif
-			assert_ne((void*)-1,(void*)data);
 		}
 
 		/**
@@ -412,9 +641,10 @@ namespace utils {
 		 * A move constructor for large arrays.
 		 */
 		LargeArray(LargeArray&& other)
-			: data(other.data), size(other.size), active_ranges(std::move(other.active_ranges)) {
+			: data(other.data), size(other.size), active_ranges(std::move(other.active_ranges)), paging(other.paging), fd(other.fd) {
 			assert_true(other.active_ranges.empty());
 			other.data = nullptr;
+			other.fd = -1;
 		}
 
 		/**
@@ -422,6 +652,11 @@ namespace utils {
 		 */
 		~LargeArray() {
 
+			// release the backing file, which is open even if there is no data
+			#ifndef _MSC_VER
+				if (fd != -1) close(fd);
+			#endif
+
 			// if there is no data, nothing to do
 			if (data == nullptr) return;
 
@@ -457,9 +692,15 @@ namespace utils {
 				munmap(data, sizeof(T)*size);
 			#endif
 			}
+			#ifndef _MSC_VER
+				if (fd != -1) close(fd);
+			#endif
 			std::swap(data,other.data);
 			size = other.size;
 			active_ranges.swap(other.active_ranges);
+			paging = other.paging;
+			fd = other.fd;
+			other.fd = -1;
 			return *this;
 		}
 
@@ -509,6 +750,34 @@ namespace utils {
 			active_ranges.add(start,end);
 		}
 
+		/**
+		 * Allocates all the given ranges within this large array, updating the
+		 * internal bookkeeping in a single pass.
+		 */
+		void allocate(const detail::Intervals& ranges) {
+			// check for emptiness
+			if (ranges.empty()) return;
+			ranges.forEachInterval([&](std::size_t, std::size_t end) {
+				assert_le(end, size) << "Invalid ranges " << ranges << " for array of size " << size;
+			});
+
+			// invoke the constructor for the released objects (if required)
+			if (!std::is_trivially_constructible<T>::value) {
+
+				// compute the ranges of new elements
+				auto newElements = ranges;
+				newElements.remove(active_ranges);
+
+				// initialize the newly allocated elements
+				newElements.forEach([this](std::size_t i){
+					new (&data[i]) T();
+				});
+			}
+
+			// add to active range
+			active_ranges.add(ranges);
+		}
+
 		/**
 		 * Frees the given range, thereby deleting the content and freeing the
 		 * associated memory pages.
@@ -536,41 +805,144 @@ namespace utils {
 			// remove range from active ranges
 			active_ranges.remove(start,end);
 
+			// release the associated memory pages
+			releasePages(start,end);
+		}
+
+		/**
+		 * Frees all the given ranges, thereby deleting the content and freeing the
+		 * associated memory pages. The internal bookkeeping is updated in a single pass.
+		 */
+		void free(const detail::Intervals& ranges) {
+
+			// check for emptiness
+			if (ranges.empty()) return;
+			ranges.forEachInterval([&](std::size_t, std::size_t end) {
+				assert_le(end, size) << "Invalid ranges " << ranges << " for array of size " << size;
+			});
+
+			// invoke the destructor for the released objects (if required)
+			if (!std::is_trivially_destructible<T>::value) {
+
+				// compute the elements to be removed
+				auto removedElements = ranges;
+				removedElements.retain(active_ranges);
+
+				// delete elements to be removed
+				removedElements.forEach([this](std::size_t i){
+					data[i].~T(); // explicit destructor call
+				});
+
+			}
+
+			// remove ranges from active ranges
+			active_ranges.remove(ranges);
+
+			// release the associated memory pages
+			ranges.forEachInterval([this](std::size_t start, std::size_t end){
+				releasePages(start,end);
+			});
+		}
+
+		/**
+		 * Populates the memory pages backing the given, allocated range, such that subsequent
+		 * accesses do not trigger page faults. The content of the range is not altered.
+		 * Disjoint ranges may be populated concurrently, yet not while the same range is being
+		 * modified by another thread.
+		 */
+		void prefault(std::size_t start, std::size_t end) {
+
+			// check for emptiness
+			if (start >= end) return;
+			assert_le(end, size) << "Invalid range " << start << " - " << end << " for array of size " << size;
+			assert_true(active_ranges.coversAll(start,end)) << "Range " << start << " - " << end << " is not allocated";
+
 			#ifdef _MSC_VER
-				// do nothing
+				// nothing to do
 			#else
-				// get address of lower boundary
 				uintptr_t ptr_start = (uintptr_t)(data + start);
 				uintptr_t ptr_end = (uintptr_t)(data + end);
 
 				auto page_size = getPageSize();
-				uintptr_t pg_start = ptr_start - (ptr_start % page_size);
-				uintptr_t pg_end = ptr_end - (ptr_end % page_size) + page_size;
 
-				std::size_t idx_start = (pg_start - (uintptr_t)(data)) / sizeof(T);
-				std::size_t idx_end   = (pg_end - (uintptr_t)(data)) / sizeof(T);
+				#ifdef MADV_POPULATE_WRITE
+					// let the kernel populate the covering pages (Linux >= 5.14)
+					uintptr_t pg_start = ptr_start - (ptr_start % page_size);
+					if (madvise((void*)pg_start, ptr_end - pg_start, MADV_POPULATE_WRITE) == 0) return;
+				#endif
 
-				assert_le(idx_start,start);
-				assert_le(end,idx_end);
+				// fall back to touching one byte of each page within the range
+				for(uintptr_t cur = ptr_start; cur < ptr_end; cur = cur - (cur % page_size) + page_size) {
+					volatile char* pos = (volatile char*)cur;
+					*pos = *pos;
+				}
+			#endif
+		}
 
-				if (active_ranges.coversAny(idx_start,start)) pg_start += page_size;
-				if (active_ranges.coversAny(end,idx_end))     pg_end -= page_size;
-				pg_end = std::min(pg_end,ptr_end);
+		/**
+		 * Determines whether this array is backed by a file.
+		 */
+		bool isFileBacked() const {
+			return fd != -1;
+		}
 
-				if (pg_start >= pg_end) return;
+		/**
+		 * Writes modifications of the given range back to the backing file, blocking
+		 * until the data has been persisted. For anonymous arrays, this is a no-op.
+		 */
+		void flush(std::size_t start, std::size_t end) {
 
+			// check for emptiness
+			if (start >= end || fd == -1) return;
+			assert_le(end, size) << "Invalid range " << start << " - " << end << " for array of size " << size;
 
-					void* section_start = (void*)pg_start;
-					std::size_t length = pg_end - pg_start;
-					munmap(section_start, length);
-					auto res = mmap(section_start, length,
-							PROT_READ | PROT_WRITE,
-							MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE | MAP_FIXED,
-							-1,0
-						);
-					if ((void*)-1 == (void*)res) {
-						assert_ne((void*)-1,(void*)res);
-					}
+			#ifndef _MSC_VER
+				uintptr_t ptr_start = (uintptr_t)(data + start);
+				uintptr_t ptr_end = (uintptr_t)(data + end);
+				uintptr_t pg_start = ptr_start - (ptr_start % getPageSize());
+				msync((void*)pg_start, ptr_end - pg_start, MS_SYNC);
+			#endif
+		}
+
+		/**
+		 * Writes all modifications of this array back to the backing file.
+		 */
+		void flush() {
+			active_ranges.forEachInterval([this](std::size_t start, std::size_t end) {
+				flush(start,end);
+			});
+		}
+
+		/**
+		 * Announces the pattern of upcoming accesses to the given range, enabling the
+		 * system to optimize the paging accordingly. This is only a hint.
+		 */
+		void advise(std::size_t start, std::size_t end, AccessPattern pattern) {
+
+			// check for emptiness
+			if (start >= end) return;
+			assert_le(end, size) << "Invalid range " << start << " - " << end << " for array of size " << size;
+
+			#ifdef _MSC_VER
+				(void)pattern;
+			#else
+				int advice = MADV_NORMAL;
+				switch(pattern) {
+					case AccessPattern::Normal:     advice = MADV_NORMAL; break;
+					case AccessPattern::Sequential: advice = MADV_SEQUENTIAL; break;
+					case AccessPattern::Random:     advice = MADV_RANDOM; break;
+					case AccessPattern::WillNeed:   advice = MADV_WILLNEED; break;
+					case AccessPattern::DontNeed:
+						// dropping private anonymous pages would discard their content
+						if (fd == -1) return;
+						advice = MADV_DONTNEED;
+						break;
+				}
+
+				uintptr_t ptr_start = (uintptr_t)(data + start);
+				uintptr_t ptr_end = (uintptr_t)(data + end);
+				uintptr_t pg_start = ptr_start - (ptr_start % getPageSize());
+				madvise((void*)pg_start, ptr_end - pg_start, advice);
 			#endif
 		}
 
@@ -602,8 +974,121 @@ namespace utils {
 			return PAGE_SIZE;
 		}
 
+		/**
+		 * Releases the memory pages exclusively covered by the given range, which must
+		 * already have been removed from the active ranges.
+		 */
+		void releasePages(std::size_t start, std::size_t end) {
+			#ifdef _MSC_VER
+				// do nothing
+				(void)start; (void)end;
+			#else
+				// get address of lower boundary
+				uintptr_t ptr_start = (uintptr_t)(data + start);
+				uintptr_t ptr_end = (uintptr_t)(data + end);
+
+				auto page_size = getPageSize();
+				uintptr_t pg_start = ptr_start - (ptr_start % page_size);
+				uintptr_t pg_end = ptr_end - (ptr_end % page_size) + page_size;
+
+				std::size_t idx_start = (pg_start - (uintptr_t)(data)) / sizeof(T);
+				std::size_t idx_end   = (pg_end - (uintptr_t)(data)) / sizeof(T);
+
+				assert_le(idx_start,start);
+				assert_le(end,idx_end);
+
+				if (active_ranges.coversAny(idx_start,start)) pg_start += page_size;
+				if (active_ranges.coversAny(end,idx_end))     pg_end -= page_size;
+				pg_end = std::min(pg_end,ptr_end);
+
+				if (pg_start >= pg_end) return;
+
+				void* section_start = (void*)pg_start;
+				std::size_t length = pg_end - pg_start;
+
+				// for file-backed arrays, release the storage in the file
+				if (fd != -1) {
+					punchHole(pg_start - (uintptr_t)data, length);
+					return;
+				}
+
+				munmap(section_start, length);
+				auto res = mmap(section_start, length,
+						PROT_READ | PROT_WRITE,
+						MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE | MAP_FIXED,
+						-1,0
+					);
+				if ((void*)-1 == (void*)res) {
+					assert_ne((void*)-1,(void*)res);
+				}
+
+				// the fresh mapping does not inherit the huge page advice
+				if (paging == PagingPolicy::HugePages) adviseHugePages(section_start, length);
+			#endif
+		}
+
+		#ifndef _MSC_VER
+
+			/**
+			 * Reserves the given number of bytes of address space starting at a huge-page boundary.
+			 */
+			static T* reserveHugePageAligned(std::size_t bytes) {
+
+				// over-allocate to be able to align the start of the reservation
+				std::size_t reserved = bytes + HUGE_PAGE_SIZE;
+				auto base = mmap(nullptr, reserved,
+						PROT_READ | PROT_WRITE,
+						MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE,
+						-1,0
+					);
+				if (base == (void*)-1) return (T*)base;
+
+				// compute the aligned section to be retained
+				uintptr_t ptr_base = (uintptr_t)base;
+				uintptr_t ptr_start = ptr_base + (HUGE_PAGE_SIZE - ptr_base % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+				uintptr_t ptr_end = ptr_start + bytes;
+				ptr_end += (getPageSize() - ptr_end % getPageSize()) % getPageSize();
+
+				// release the excess address space
+				if (ptr_base < ptr_start) munmap(base, ptr_start - ptr_base);
+				if (ptr_end < ptr_base + reserved) munmap((void*)ptr_end, ptr_base + reserved - ptr_end);
+
+				// ask for transparent huge pages
+				adviseHugePages((void*)ptr_start, ptr_end - ptr_start);
+				return (T*)ptr_start;
+			}
+
+			/**
+			 * Releases the storage of the given byte range of the backing file, such that
+			 * subsequent reads produce zeros.
+			 */
+			void punchHole(std::size_t offset, std::size_t length) {
+				#if defined(FALLOC_FL_PUNCH_HOLE) && defined(FALLOC_FL_KEEP_SIZE)
+					if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, length) == 0) return;
+				#endif
+				// if hole punching is not supported, at least drop the pages from memory
+				madvise((char*)data + offset, length, MADV_DONTNEED);
+			}
+
+			/**
+			 * Advises the kernel to back the given section by transparent huge pages, if supported.
+			 */
+			static void adviseHugePages(void* start, std::size_t length) {
+				#ifdef MADV_HUGEPAGE
+					// this is only a hint, failures are tolerated
+					madvise(start, length, MADV_HUGEPAGE);
+				#else
+					(void)start; (void)length;
+				#endif
+			}
+
+		#endif
+
 	};
 
+	template<typename T>
+	constexpr std::size_t LargeArray<T>::HUGE_PAGE_SIZE;
+
 
 } // end namespace utils
 } // end namespace allscale
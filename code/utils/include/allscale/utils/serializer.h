@@ -1,10 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
 #include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <sstream>
 #include <type_traits>
 #include <vector>
 
+#ifndef _MSC_VER
+	#include <unistd.h>
+#endif
+
 #include "allscale/utils/assert.h"
 
 #if defined(ALLSCALE_WITH_HPX)
@@ -37,6 +48,12 @@ namespace utils {
 	 */
 	class ArchiveReader;
 
+	/**
+	 * A read-only view on a sequence of trivially serializable values stored within an archive.
+	 */
+	template<typename T>
+	class ArchiveSpan;
+
 	/**
 	 * A serializer describes the way types are converted to and restored from archives.
 	 */
@@ -50,6 +67,23 @@ namespace utils {
 	template <typename T, typename _ = void>
 	struct is_serializable;
 
+	/**
+	 * This type trait determines whether the serialized form of a type T is identical
+	 * to its in-memory representation. Sequences of such values may be stored and
+	 * restored by a single memcpy instead of element-wise.
+	 */
+	template <typename T, typename _ = void>
+	struct is_trivially_serializable;
+
+	/**
+	 * This type trait provides the number of bytes of the serialized form of values of
+	 * type T. If this number is the same for all values, the member is_fixed is true and
+	 * the compile-time constant value provides the size. In any case, get(value) computes
+	 * the size for a given value -- by default through a dry run of the serializer.
+	 */
+	template <typename T, typename _ = void>
+	struct serialized_size;
+
 	/**
 	 * A facade function for packing an object into an archive.
 	 */
@@ -72,6 +106,132 @@ namespace utils {
 
 	namespace detail {
 
+		/**
+		 * Determines whether values of type T are transferred between objects and archives
+		 * by copying their memory representation instead of invoking their serializer.
+		 */
+		template<typename T>
+		struct is_block_serializable : public std::integral_constant<bool,
+				is_trivially_serializable<T>::value && std::is_default_constructible<T>::value
+			> {};
+
+		/**
+		 * A per-thread pool of buffers to be reused by archives. Buffers released by
+		 * destroyed archives are retained, such that repeated serialization of
+		 * similar-sized data (e.g. halo exchanges in every time step) does not
+		 * have to allocate and grow a fresh buffer each time.
+		 */
+		class BufferPool {
+
+			// the largest capacity of a buffer to be retained, as a power of two
+			static constexpr std::size_t MAX_CLASS = 21;
+
+			// the maximum number of buffers retained per size class
+			static constexpr std::size_t MAX_BUFFERS_PER_CLASS = 8;
+
+			// the maximum number of bytes retained per thread
+			static constexpr std::size_t MAX_RETAINED = std::size_t(8) << 20;
+
+			// the number of size classes larger than requested that may serve a request
+			static constexpr std::size_t MAX_OVERSIZE_CLASSES = 2;
+
+			// the buffers available for reuse, by size class -- class c holds capacities in [2^c,2^(c+1))
+			std::array<std::vector<std::vector<char>>,MAX_CLASS + 1> buffers;
+
+			// the total capacity of the retained buffers
+			std::size_t retained = 0;
+
+			// the size class of the most recently released buffer
+			std::size_t recent = 0;
+
+			BufferPool() {}
+
+			~BufferPool() {
+				// buffers released during the remaining thread shutdown are not recycled
+				destroyed() = true;
+			}
+
+			static bool& destroyed() {
+				static thread_local bool flag = false;
+				return flag;
+			}
+
+			static BufferPool* get() {
+				if (destroyed()) return nullptr;
+				static thread_local BufferPool pool;
+				return &pool;
+			}
+
+			// the size class of a buffer of the given capacity
+			static std::size_t getClass(std::size_t capacity) {
+				std::size_t res = 0;
+				while(capacity >>= 1) res++;
+				return res;
+			}
+
+			// removes the buffer at the given position from the given size class
+			std::vector<char> take(std::size_t c, std::size_t i) {
+				auto& list = buffers[c];
+				std::vector<char> res = std::move(list[i]);
+				list[i] = std::move(list.back());
+				list.pop_back();
+				retained -= res.capacity();
+				return res;
+			}
+
+		public:
+
+			/**
+			 * Obtains an empty buffer for about the given number of bytes, reusing the memory of a
+			 * previously released one of a similar capacity if available. Without a size, the most
+			 * recently released buffer is reused, or otherwise the largest one retained, as the data
+			 * to be written is likely to resemble the data written before.
+			 */
+			static std::vector<char> acquire(std::size_t size = 0) {
+				auto pool = get();
+				if (!pool || pool->retained == 0) return std::vector<char>();
+
+				if (size == 0) {
+					if (!pool->buffers[pool->recent].empty()) {
+						return pool->take(pool->recent, pool->buffers[pool->recent].size() - 1);
+					}
+					for(std::size_t c = MAX_CLASS + 1; c-- > 0;) {
+						if (!pool->buffers[c].empty()) return pool->take(c, pool->buffers[c].size() - 1);
+					}
+					return std::vector<char>();
+				}
+
+				// only take buffers covering, yet not considerably exceeding the requested size
+				std::size_t first = getClass(size);
+				std::size_t last = first + MAX_OVERSIZE_CLASSES;
+				if (last > MAX_CLASS) last = MAX_CLASS;
+				for(std::size_t c = first; c <= last; c++) {
+					auto& list = pool->buffers[c];
+					for(std::size_t i = list.size(); i-- > 0;) {
+						if (list[i].capacity() >= size) return pool->take(c, i);
+					}
+				}
+				return std::vector<char>();
+			}
+
+			/**
+			 * Returns the given buffer to the pool of the current thread, if worth retaining.
+			 */
+			static void release(std::vector<char>&& buffer) {
+				auto capacity = buffer.capacity();
+				auto c = getClass(capacity);
+				if (capacity == 0 || c > MAX_CLASS) return;
+				auto pool = get();
+				if (!pool || pool->retained + capacity > MAX_RETAINED) return;
+				if (pool->buffers[c].size() >= MAX_BUFFERS_PER_CLASS) return;
+				buffer.clear();
+				pool->retained += capacity;
+				pool->buffers[c].push_back(std::move(buffer));
+				pool->recent = c;
+			}
+
+		};
+
 		/**
 		 * A simple, initial, functionally complete implementation of a data buffer
 		 * for storing data within an archive.
@@ -94,6 +254,11 @@ namespace utils {
 			DataBuffer(const std::vector<char>& data) : data(data) {}
 			DataBuffer(std::vector<char>&& data) : data(std::move(data)) {}
 
+			~DataBuffer() {
+				// recycle the underlying memory
+				BufferPool::release(std::move(data));
+			}
+
 			DataBuffer& operator=(const DataBuffer&) = default;
 			DataBuffer& operator=(DataBuffer&&) = default;
 
@@ -101,13 +266,22 @@ namespace utils {
 			 * The main function for appending data to this buffer.
 			 */
 			void append(const char* start, std::size_t count) {
-				// create space
-				auto pos = data.size();
-				data.resize(pos + count / sizeof(char));
+				// copy to the end, growing geometrically without zero-initializing the new space first
+				data.insert(data.end(), start, start + count);
+			}
 
-				// append at end
-				std::memcpy(&data[pos],start,count);
+			/**
+			 * Drops the content of this buffer, retaining the allocated memory.
+			 */
+			void clear() {
+				data.clear();
+			}
 
+			/**
+			 * Reserves space for the given total number of bytes in this buffer.
+			 */
+			void reserve(std::size_t count) {
+				data.reserve(count);
 			}
 
 			/**
@@ -117,18 +291,25 @@ namespace utils {
 				return data.size() * sizeof(char);
 			}
 
+			/**
+			 * Obtains the number of bytes this buffer may occupy without re-allocation.
+			 */
+			std::size_t capacity() const {
+				return data.capacity() * sizeof(char);
+			}
+
 			/**
 			 * Obtains a pointer to the begin of the internally maintained buffer (inclusive).
 			 */
 			const char* begin() const {
-				return &data.front();
+				return data.data();
 			}
 
 			/**
 			 * Obtains a pointer to the end of the internally maintained buffer (exclusive).
 			 */
 			const char* end() const {
-				return &data.back() + 1;
+				return data.data() + data.size();
 			}
 
 			/**
@@ -151,6 +332,82 @@ namespace utils {
 	} // end namespace detail
 
 
+	template<typename T>
+	class ArchiveSpan {
+
+		// the first element of the span
+		const T* first;
+
+		// the number of elements in the span
+		std::size_t length;
+
+		// a copy of the data, used if it could not be referenced within the archive
+		std::vector<T> copy;
+
+		// whether this span refers to the copy or the archive
+		bool owned;
+
+	public:
+
+		/**
+		 * Creates a span referencing the given range of elements.
+		 */
+		ArchiveSpan(const T* first, std::size_t length)
+			: first(first), length(length), owned(false) {}
+
+		/**
+		 * Creates a span owning the given copy of the elements.
+		 */
+		ArchiveSpan(std::vector<T>&& data)
+			: first(nullptr), length(data.size()), copy(std::move(data)), owned(true) {}
+
+		ArchiveSpan(const ArchiveSpan&) = delete;
+		ArchiveSpan(ArchiveSpan&&) = default;
+
+		ArchiveSpan& operator=(const ArchiveSpan&) = delete;
+		ArchiveSpan& operator=(ArchiveSpan&&) = default;
+
+		/**
+		 * Determines whether this span is referencing the archive buffer directly.
+		 */
+		bool isView() const {
+			return !owned;
+		}
+
+		bool empty() const {
+			return length == 0;
+		}
+
+		std::size_t size() const {
+			return length;
+		}
+
+		const T* data() const {
+			return (owned) ? copy.data() : first;
+		}
+
+		const T* begin() const {
+			return data();
+		}
+
+		const T* end() const {
+			return data() + length;
+		}
+
+		const T& operator[](std::size_t i) const {
+			return data()[i];
+		}
+
+		/**
+		 * Copies the elements of this span to the given target location.
+		 */
+		void copyTo(T* target) const {
+			if (length > 0) std::memcpy(target,data(),sizeof(T)*length);
+		}
+
+	};
+
+
 	class Archive {
 
 		friend class ArchiveWriter;
@@ -200,34 +457,169 @@ namespace utils {
 #if !defined(ALLSCALE_WITH_HPX)
 	class ArchiveWriter {
 
+	public:
+
+		/**
+		 * The type of consumer for data streamed out of a writer.
+		 */
+		using Sink = std::function<void(const char*,std::size_t)>;
+
+		/**
+		 * The default size of the buffer of streaming writers and readers.
+		 */
+		static constexpr std::size_t STREAM_BUFFER_SIZE = 1024 * 1024;
+
+	private:
+
 		// the buffer targeted by this archive writer
 		detail::DataBuffer data;
 
+		// the consumer of the buffered data, if this writer is streaming
+		Sink sink;
+
+		// the buffer size triggering a flush to the sink
+		std::size_t limit = std::numeric_limits<std::size_t>::max();
+
+		// the number of bytes already handed to the sink
+		std::size_t flushed = 0;
+
 	public:
 
-		ArchiveWriter() {}
+		ArchiveWriter() : data(detail::BufferPool::acquire()) {}
+
+		/**
+		 * Creates a writer expecting to produce an archive of about the given number of bytes.
+		 */
+		explicit ArchiveWriter(std::size_t sizeHint) : data(detail::BufferPool::acquire(sizeHint)) {
+			reserve(sizeHint);
+		}
+
+		/**
+		 * Creates a writer forwarding its data to the given sink instead of producing an
+		 * archive. Data is collected in a buffer of the given size, which is handed to the
+		 * sink whenever it is full, such that memory usage is bounded. Without a buffer,
+		 * all data is passed on to the sink directly.
+		 */
+		explicit ArchiveWriter(Sink sink, std::size_t bufferSize = STREAM_BUFFER_SIZE)
+			: sink(std::move(sink)), limit(bufferSize) {
+			if (bufferSize > 0) {
+				data = detail::DataBuffer(detail::BufferPool::acquire(bufferSize));
+				reserve(bufferSize);
+			}
+		}
+
+		#ifndef _MSC_VER
+
+		/**
+		 * Creates a writer streaming its data into the given file descriptor.
+		 */
+		static ArchiveWriter toFileDescriptor(int fd, std::size_t bufferSize = STREAM_BUFFER_SIZE) {
+			return ArchiveWriter([fd](const char* src, std::size_t count) {
+				while(count > 0) {
+					auto res = ::write(fd,src,count);
+					if (res < 0 && errno == EINTR) continue;
+					assert_lt(0,res) << "Failed to write to file descriptor " << fd << ": " << std::strerror(errno);
+					if (res <= 0) return;
+					src += res;
+					count -= res;
+				}
+			}, bufferSize);
+		}
+
+		#endif
 
 		ArchiveWriter(const ArchiveWriter&) = delete;
-		ArchiveWriter(ArchiveWriter&&) = default;
+
+		ArchiveWriter(ArchiveWriter&& other)
+			: data(std::move(other.data)), sink(std::move(other.sink)), limit(other.limit), flushed(other.flushed) {
+			// the moved-from writer must not flush anything any more
+			other.sink = nullptr;
+		}
+
+		~ArchiveWriter() {
+			// hand remaining data to the sink
+			flush();
+		}
 
 		ArchiveWriter& operator=(const ArchiveWriter&) = delete;
-		ArchiveWriter& operator=(ArchiveWriter&&) = default;
+
+		ArchiveWriter& operator=(ArchiveWriter&& other) {
+			if (this == &other) return *this;
+
+			// data buffered for the current sink must not get lost
+			flush();
+
+			data = std::move(other.data);
+			sink = std::move(other.sink);
+			limit = other.limit;
+			flushed = other.flushed;
+			other.sink = nullptr;
+			return *this;
+		}
 
 		/**
 		 * Appends a given number of bytes to the end of the underlying data buffer.
 		 */
 		void write(const char* src, std::size_t count) {
+			// common case: the data fits into the buffer
+			if (count <= limit - data.size()) {
+				data.append(src,count);
+				return;
+			}
+
+			// otherwise the buffer needs to be flushed first
+			flush();
+
+			// pass large blocks on directly
+			if (count >= limit) {
+				sink(src,count);
+				flushed += count;
+				return;
+			}
+
 			data.append(src,count);
 		}
 
+		/**
+		 * Hands the buffered data to the sink of a streaming writer. For writers
+		 * producing archives, this is a no-op.
+		 */
+		void flush() {
+			if (!sink || data.size() == 0) return;
+			sink(data.begin(),data.size());
+			flushed += data.size();
+			data.clear();
+		}
+
+		/**
+		 * Determines whether this writer is streaming its data to a sink.
+		 */
+		bool isStreaming() const {
+			return bool(sink);
+		}
+
+		/**
+		 * Reserves space for an archive of the given total number of bytes, avoiding
+		 * re-allocations while writing.
+		 */
+		void reserve(std::size_t count) {
+			data.reserve(count);
+		}
+
+		/**
+		 * Obtains the number of bytes written so far.
+		 */
+		std::size_t size() const {
+			return flushed + data.size();
+		}
+
 		/**
 		 * A utility function wrapping the invocation of the serialization mechanism.
 		 */
 		template<typename T>
 		std::enable_if_t<is_serializable<T>::value,void>
 		write(const T& value) {
-			// use serializer to store object of this type
-			serializer<T>::store(*this,value);
+			writeValue(value,detail::is_block_serializable<T>());
 		}
 
 		/**
@@ -235,9 +627,24 @@ namespace utils {
 		 * this writer must not be used any more.
 		 */
 		Archive toArchive() && {
+			assert_false(sink) << "Streaming writers do not produce archives!";
 			return std::move(data);
 		}
 
+	private:
+
+		template<typename T>
+		void writeValue(const T& value, std::true_type) {
+			// fixed-layout values are written as a single block
+			write(reinterpret_cast<const char*>(&value),sizeof(T));
+		}
+
+		template<typename T>
+		void writeValue(const T& value, std::false_type) {
+			// use serializer to store object of this type
+			serializer<T>::store(*this,value);
+		}
+
 	};
 #else
     class ArchiveWriter {
@@ -253,6 +660,11 @@ namespace utils {
             ar_ & hpx::serialization::make_array(src, count);
 		}
 
+		/**
+		 * Size hints are not needed, HPX manages the growth of its own buffers.
+		 */
+		void reserve(std::size_t) {}
+
 		/**
 		 * A utility function wrapping the invocation of the serialization mechanism.
 		 */
@@ -274,37 +686,181 @@ namespace utils {
 #if !defined(ALLSCALE_WITH_HPX)
 	class ArchiveReader {
 
+	public:
+
+		/**
+		 * The type of producer for data streamed into a reader. It fills the given
+		 * buffer with up to the given number of bytes and returns the number of bytes
+		 * obtained, 0 if there is no more data.
+		 */
+		using Source = std::function<std::size_t(char*,std::size_t)>;
+
+		/**
+		 * The type of handler returning data read ahead by a streaming reader to its
+		 * producer. It is called with the number of bytes fetched from the source but
+		 * not consumed by the reader, which the source has to step back by.
+		 */
+		using Rewind = std::function<void(std::size_t)>;
+
+	private:
+
 		// the current point of the reader
 		const char* cur;
 
-		// the end of the reader (only checked for debugging)
+		// the end of the reader
 		const char* end;
 
+		// the producer of data, if this reader is streaming
+		Source source;
+
+		// the buffer for streamed data
+		std::vector<char> buffer;
+
+		// the handler giving back data read ahead, if supported by the source
+		Rewind rewind;
+
 	public:
 
 		/**
-		 * A archive reader can only be obtained from an existing archive.
+		 * A archive reader can be obtained from an existing archive.
 		 */
 		ArchiveReader(const Archive& archive)
 			: cur(archive.data.begin()), end(archive.data.end()) {}
 
+		/**
+		 * Creates a reader consuming data from the given source, buffering up to the given
+		 * number of bytes (at least one) at a time.
+		 *
+		 * IMPORTANT: the reader fetches data ahead of what it consumes. Unless a rewind
+		 * handler is given, which is invoked on destruction with the number of bytes read
+		 * ahead, the source is left positioned after those bytes and they are lost to
+		 * other consumers of the source.
+		 */
+		explicit ArchiveReader(Source source, std::size_t bufferSize = ArchiveWriter::STREAM_BUFFER_SIZE, Rewind rewind = Rewind())
+			: cur(nullptr), end(nullptr), source(std::move(source)), buffer(bufferSize > 0 ? bufferSize : 1), rewind(std::move(rewind)) {}
+
+		#ifndef _MSC_VER
+
+		/**
+		 * Creates a reader streaming its data from the given file descriptor. Data read ahead
+		 * is given back by seeking; for descriptors not supporting this (e.g. pipes), the
+		 * reader consumes the remaining data of the descriptor.
+		 */
+		static ArchiveReader fromFileDescriptor(int fd, std::size_t bufferSize = ArchiveWriter::STREAM_BUFFER_SIZE) {
+			return ArchiveReader([fd](char* dst, std::size_t count) -> std::size_t {
+				while(true) {
+					auto res = ::read(fd,dst,count);
+					if (res < 0 && errno == EINTR) continue;
+					assert_le(0,res) << "Failed to read from file descriptor " << fd << ": " << std::strerror(errno);
+					return (res < 0) ? 0 : res;
+				}
+			}, bufferSize, [fd](std::size_t count) {
+				::lseek(fd,-off_t(count),SEEK_CUR);
+			});
+		}
+
+		#endif
+
 		ArchiveReader(const ArchiveReader&) = delete;
-		ArchiveReader(ArchiveReader&&) = default;
+
+		ArchiveReader(ArchiveReader&& other)
+			: cur(other.cur), end(other.end), source(std::move(other.source)), buffer(std::move(other.buffer)), rewind(std::move(other.rewind)) {
+			// the moved-from reader does not own any buffered data any more
+			other.cur = other.end = nullptr;
+			other.rewind = nullptr;
+		}
+
+		~ArchiveReader() {
+			// give back data read ahead
+			release();
+		}
 
 		ArchiveReader& operator=(const ArchiveReader&) = delete;
-		ArchiveReader& operator=(ArchiveReader&&) = default;
+
+		ArchiveReader& operator=(ArchiveReader&& other) {
+			if (this == &other) return *this;
+
+			// data read ahead from the current source must not get lost
+			release();
+
+			cur = other.cur;
+			end = other.end;
+			source = std::move(other.source);
+			buffer = std::move(other.buffer);
+			rewind = std::move(other.rewind);
+			other.cur = other.end = nullptr;
+			other.rewind = nullptr;
+			return *this;
+		}
 
 		/**
 		 * Reads a number of bytes from the underlying buffer.
 		 */
 		void read(char* dst, std::size_t count) {
-			// copy the data
-			std::memcpy(dst,cur,count);
-			// move pointer forward
-			cur += count;
+			// common case: data is available in the buffer
+			if (count <= std::size_t(end - cur)) {
+				std::memcpy(dst,cur,count);
+				cur += count;
+				return;
+			}
+
+			// make sure that we do not cross the end of an archive
+			assert_true(source) << "Reading beyond the end of the archive!";
+			if (!source) return;
+
+			// consume what is left in the buffer
+			auto available = std::size_t(end - cur);
+			std::memcpy(dst,cur,available);
+			dst += available;
+			count -= available;
+			cur = end;
+
+			// read large blocks directly
+			while(count >= buffer.size()) {
+				auto res = source(dst,count);
+				assert_lt(0u,res) << "Unexpected end of stream!";
+				if (res == 0) return;
+				dst += res;
+				count -= res;
+			}
+
+			// read the rest through the buffer
+			while(count > 0) {
+				auto res = source(buffer.data(),buffer.size());
+				assert_lt(0u,res) << "Unexpected end of stream!";
+				if (res == 0) return;
+				cur = buffer.data();
+				end = cur + res;
+				auto step = std::min(count,res);
+				std::memcpy(dst,cur,step);
+				dst += step;
+				count -= step;
+				cur += step;
+			}
+		}
+
+		/**
+		 * Reads a sequence of n trivially serializable values from the underlying buffer.
+		 * If the position in the buffer is suitably aligned, the resulting span references
+		 * the data within the archive, which has thus to out-live the span. Otherwise, the
+		 * data is copied. Views obtained from streaming readers are only valid until
+		 * the next read operation.
+		 */
+		template<typename T>
+		ArchiveSpan<T> read_span(std::size_t n) {
+			static_assert(is_trivially_serializable<T>::value, "Spans may only be read for trivially serializable types.");
+
+			// fall back to a copy if the data is not aligned or not yet buffered
+			if (reinterpret_cast<std::uintptr_t>(cur) % alignof(T) != 0 || sizeof(T) * n > std::size_t(end - cur)) {
+				std::vector<T> res(n);
+				if (n > 0) read(reinterpret_cast<char*>(res.data()),sizeof(T)*n);
+				return res;
+			}
 
-			// make sure that we did not cross the end of the buffer
-			assert_le(cur,end);
+			// reference the data within the buffer
+			auto res = reinterpret_cast<const T*>(cur);
+			cur += sizeof(T) * n;
+			return { res, n };
 		}
 
 		/**
@@ -314,6 +870,26 @@ namespace utils {
 		template<typename T>
 		std::enable_if_t<is_serializable<T>::value,T>
 		read() {
+			return readValue<T>(detail::is_block_serializable<T>());
+		}
+
+	private:
+
+		void release() {
+			if (rewind && cur != end) rewind(end - cur);
+			cur = end;
+		}
+
+		template<typename T>
+		T readValue(std::true_type) {
+			// fixed-layout values are read as a single block
+			T res;
+			read(reinterpret_cast<char*>(&res),sizeof(T));
+			return res;
+		}
+
+		template<typename T>
+		T readValue(std::false_type) {
 			// use serializer to restore object of this type
 			return serializer<T>::load(*this);
 		}
@@ -333,6 +909,18 @@ namespace utils {
             ar_ & hpx::serialization::make_array(dst, count);
 		}
 
+		/**
+		 * Reads a sequence of n trivially serializable values. HPX archives do not
+		 * expose their buffers, thus the data is always copied.
+		 */
+		template<typename T>
+		ArchiveSpan<T> read_span(std::size_t n) {
+			static_assert(is_trivially_serializable<T>::value, "Spans may only be read for trivially serializable types.");
+			std::vector<T> res(n);
+			if (n > 0) read(reinterpret_cast<char*>(res.data()),sizeof(T)*n);
+			return res;
+		}
+
 		/**
 		 * A utility function wrapping up the de-serialization of an object
 		 * of type T from the underlying buffer.
@@ -440,6 +1028,21 @@ namespace utils {
 	template <typename T, typename _>
 	struct is_serializable : public std::false_type {};
 
+	template <typename T, typename _>
+	struct is_trivially_serializable : public std::false_type {};
+
+	/**
+	 * All primitive types are serialized through their memory representation.
+	 */
+	template <typename T>
+	struct is_trivially_serializable<T, typename std::enable_if<std::is_arithmetic<T>::value,void>::type> : public std::true_type {};
+
+	/**
+	 * Const qualifiers do not alter the serialized form.
+	 */
+	template <typename T>
+	struct is_trivially_serializable<const T, typename std::enable_if<is_trivially_serializable<T>::value && !std::is_arithmetic<T>::value,void>::type> : public std::true_type {};
+
 	template <typename T>
 	struct is_serializable<T, typename std::enable_if<
 			std::is_same<decltype((T(*)(Archive&))(&serializer<T>::load)), T(*)(Archive&)>::value &&
@@ -447,13 +1050,104 @@ namespace utils {
 		void>::type> : public std::true_type {};
 
 
+	namespace detail {
+
+		/**
+		 * The dynamic fallback for serialized sizes, measuring the size through a dry run
+		 * of the serializer.
+		 */
+		template<typename T>
+		struct measured_serialized_size {
+
+			static constexpr bool is_fixed = false;
+
+			static std::size_t get(const T& value) {
+#if !defined(ALLSCALE_WITH_HPX)
+				// a writer without buffer, passing all data to a sink ignoring it
+				ArchiveWriter counter([](const char*, std::size_t) {}, 0);
+				counter.write(value);
+				return counter.size();
+#else
+				// not supported by HPX archives
+				return 0;
+#endif
+			}
+		};
+
+		/**
+		 * A base for serialized sizes known at compile time.
+		 */
+		template<std::size_t size>
+		struct fixed_serialized_size {
+
+			static constexpr bool is_fixed = true;
+
+			static constexpr std::size_t value = size;
+
+			template<typename T>
+			static constexpr std::size_t get(const T&) {
+				return size;
+			}
+		};
+
+		template<std::size_t size>
+		constexpr std::size_t fixed_serialized_size<size>::value;
+
+		/**
+		 * Sums up the serialized sizes of the elements of the given range.
+		 */
+		template<typename Iter>
+		std::size_t sumSerializedSizes(const Iter& begin, const Iter& end, std::true_type) {
+			using value_type = typename std::iterator_traits<Iter>::value_type;
+			return std::size_t(std::distance(begin,end)) * serialized_size<value_type>::value;
+		}
+
+		template<typename Iter>
+		std::size_t sumSerializedSizes(const Iter& begin, const Iter& end, std::false_type) {
+			using value_type = typename std::iterator_traits<Iter>::value_type;
+			std::size_t res = 0;
+			for(auto it = begin; it != end; ++it) {
+				res += serialized_size<value_type>::get(*it);
+			}
+			return res;
+		}
+
+		template<typename Iter>
+		std::size_t sumSerializedSizes(const Iter& begin, const Iter& end) {
+			using value_type = typename std::iterator_traits<Iter>::value_type;
+			return sumSerializedSizes(begin,end,std::integral_constant<bool,serialized_size<value_type>::is_fixed>());
+		}
+
+		/**
+		 * Obtains the expected size of the serialized form of the given value, if it can
+		 * be determined without a dry run, or 0 otherwise.
+		 */
+		template<typename T>
+		std::size_t getSerializedSizeHint(const T& value) {
+			if (std::is_base_of<measured_serialized_size<T>,serialized_size<T>>::value) return 0;
+			return serialized_size<T>::get(value);
+		}
+
+	} // end namespace detail
+
+	template <typename T, typename _>
+	struct serialized_size : public detail::measured_serialized_size<T> {};
+
+	/**
+	 * The size of trivially serializable types is the size of their memory representation.
+	 */
+	template <typename T>
+	struct serialized_size<T, typename std::enable_if<is_trivially_serializable<T>::value,void>::type>
+		: public detail::fixed_serialized_size<sizeof(T)> {};
+
+
 
 	// -- facade functions --
 #if !defined(ALLSCALE_WITH_HPX)
 	template<typename T>
 	typename std::enable_if<is_serializable<T>::value,Archive>::type
 	serialize(const T& value) {
-		ArchiveWriter writer;
+		ArchiveWriter writer(detail::getSerializedSizeHint(value));
 		writer.write(value);
 		return std::move(writer).toArchive();
 	}
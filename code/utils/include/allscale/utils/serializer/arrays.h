@@ -42,7 +42,7 @@ namespace utils {
 	 * Add support for serializing / de-serializing arrays.
 	 */
 	template<typename T, std::size_t size>
-	struct serializer<std::array<T,size>,typename std::enable_if<is_serializable<T>::value,void>::type> {
+	struct serializer<std::array<T,size>,typename std::enable_if<is_serializable<T>::value && !is_trivially_serializable<T>::value,void>::type> {
 
 		static std::array<T,size> load(ArchiveReader& reader) {
 			// support loading of array for elements without default constructor
@@ -55,6 +55,49 @@ namespace utils {
 		}
 	};
 
+	/**
+	 * Add support for serializing / de-serializing arrays of trivially serializable elements
+	 * as a single block of memory.
+	 */
+	template<typename T, std::size_t size>
+	struct serializer<std::array<T,size>,typename std::enable_if<is_trivially_serializable<T>::value,void>::type> {
+
+		static std::array<T,size> load(ArchiveReader& reader) {
+			std::array<T,size> res;
+			reader.read(reinterpret_cast<char*>(res.data()),sizeof(T)*size);
+			return res;
+		}
+		static void store(ArchiveWriter& writer, const std::array<T,size>& value) {
+			writer.write(reinterpret_cast<const char*>(value.data()),sizeof(T)*size);
+		}
+	};
+
+	/**
+	 * Arrays of trivially serializable elements are trivially serializable.
+	 */
+	template<typename T, std::size_t size>
+	struct is_trivially_serializable<std::array<T,size>,typename std::enable_if<is_trivially_serializable<T>::value,void>::type> : public std::true_type {};
+
+	/**
+	 * Arrays of elements of fixed serialized size have a fixed serialized size.
+	 */
+	template<typename T, std::size_t size>
+	struct serialized_size<std::array<T,size>,typename std::enable_if<!is_trivially_serializable<T>::value && serialized_size<T>::is_fixed,void>::type>
+		: public detail::fixed_serialized_size<size * serialized_size<T>::value> {};
+
+	/**
+	 * For other arrays, the serialized size depends on the elements.
+	 */
+	template<typename T, std::size_t size>
+	struct serialized_size<std::array<T,size>,typename std::enable_if<is_serializable<T>::value && !serialized_size<T>::is_fixed,void>::type> {
+
+		static constexpr bool is_fixed = false;
+
+		static std::size_t get(const std::array<T,size>& value) {
+			return detail::sumSerializedSizes(value.begin(),value.end());
+		}
+	};
+
 } // end namespace utils
 } // end namespace allscale
 
@@ -30,5 +30,18 @@ namespace utils {
 		}
 	};
 
+	/**
+	 * The serialized size of strings depends on their length.
+	 */
+	template<>
+	struct serialized_size<std::string> {
+
+		static constexpr bool is_fixed = false;
+
+		static std::size_t get(const std::string& value) {
+			return sizeof(std::size_t) + value.size();
+		}
+	};
+
 } // end namespace utils
 } // end namespace allscale
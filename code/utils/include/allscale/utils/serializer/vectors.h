@@ -4,6 +4,7 @@
 	#include "allscale/utils/serializer.h"
 #endif
 
+#include <algorithm>
 #include <vector>
 
 #include "allscale/utils/serializer/arrays.h"
@@ -11,11 +12,23 @@
 namespace allscale {
 namespace utils {
 
+	namespace detail {
+
+		/**
+		 * Determines whether the elements of a std::vector<T> can be serialized as a single block of memory.
+		 */
+		template<typename T>
+		struct is_bulk_serializable_vector_element : public std::integral_constant<bool,
+				is_trivially_serializable<T>::value && !std::is_same<T,bool>::value		// std::vector<bool> is not contiguous
+			> {};
+
+	} // end namespace detail
+
 	/**
 	 * Add support for serializing / de-serializing std::vectors.
 	 */
 	template<typename T, typename Allocator>
-	struct serializer<std::vector<T,Allocator>,typename std::enable_if<is_serializable<T>::value,void>::type> {
+	struct serializer<std::vector<T,Allocator>,typename std::enable_if<is_serializable<T>::value && !detail::is_bulk_serializable_vector_element<T>::value,void>::type> {
 
 		static std::vector<T,Allocator> load(ArchiveReader& reader) {
 
@@ -48,5 +61,55 @@ namespace utils {
 		}
 	};
 
+	/**
+	 * Add support for serializing / de-serializing std::vectors of trivially serializable
+	 * elements, transferring all elements as a single block of memory.
+	 */
+	template<typename T, typename Allocator>
+	struct serializer<std::vector<T,Allocator>,typename std::enable_if<detail::is_bulk_serializable_vector_element<T>::value,void>::type> {
+
+		static std::vector<T,Allocator> load(ArchiveReader& reader) {
+
+			// load the size
+			auto size = reader.read<std::size_t>();
+
+			// create the result, without initializing its elements
+			std::vector<T,Allocator> res;
+			res.reserve(size);
+
+			// append the elements in blocks, taken from the archive's buffer where possible,
+			// such that the storage of the result is written only once
+			constexpr std::size_t blockSize = std::max<std::size_t>(1, (1 << 14) / sizeof(T));
+			while(res.size() < size) {
+				auto block = reader.read_span<T>(std::min(blockSize, size - res.size()));
+				res.insert(res.end(), block.begin(), block.end());
+			}
+
+			// done
+			return res;
+		}
+		static void store(ArchiveWriter& writer, const std::vector<T,Allocator>& value) {
+
+			// start with the size
+			writer.write(value.size());
+
+			// followed by the block of elements
+			if (!value.empty()) writer.write(reinterpret_cast<const char*>(value.data()),sizeof(T)*value.size());
+		}
+	};
+
+	/**
+	 * The serialized size of vectors depends on the number of elements.
+	 */
+	template<typename T, typename Allocator>
+	struct serialized_size<std::vector<T,Allocator>,typename std::enable_if<is_serializable<T>::value,void>::type> {
+
+		static constexpr bool is_fixed = false;
+
+		static std::size_t get(const std::vector<T,Allocator>& value) {
+			return sizeof(std::size_t) + detail::sumSerializedSizes(value.begin(),value.end());
+		}
+	};
+
 } // end namespace utils
 } // end namespace allscale
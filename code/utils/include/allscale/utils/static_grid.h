@@ -36,6 +36,10 @@ namespace utils {
 
 	public:
 
+		StaticGrid() = default;
+
+		StaticGrid(const StaticGrid&) = default;
+
 		StaticGrid& operator=(const StaticGrid& other) {
 			if (this == &other) return *this;
 			assignInternal<Cell>(other);
@@ -95,6 +99,11 @@ namespace utils {
 		}
 
 		void store(utils::ArchiveWriter& writer) const {
+			// trivially serializable cells are written as a single block
+			if (is_trivially_serializable<Cell>::value) {
+				writer.write(reinterpret_cast<const char*>(&data),sizeof(data_type));
+				return;
+			}
 			for(const auto& e : data) {
 				writer.write(e);
 			}
@@ -102,6 +111,11 @@ namespace utils {
 
 		static StaticGrid load(utils::ArchiveReader& reader) {
 			StaticGrid grid;
+			// trivially serializable cells are read as a single block
+			if (is_trivially_serializable<Cell>::value) {
+				reader.read(reinterpret_cast<char*>(&grid.data),sizeof(data_type));
+				return grid;
+			}
 			for(auto& e : grid.data) {
 				e = reader.read<typename data_type::value_type>();
 			}
@@ -160,6 +174,10 @@ namespace utils {
 
 	public:
 
+		StaticGrid() = default;
+
+		StaticGrid(const StaticGrid&) = default;
+
 		StaticGrid& operator=(const StaticGrid& other) {
 			if (this == &other) return *this;
 			assignInternal<Cell>(other);
@@ -241,5 +259,11 @@ namespace utils {
 
 	};
 
+	/**
+	 * Static grids of trivially serializable cells are trivially serializable.
+	 */
+	template<typename Cell, size_t ... size>
+	struct is_trivially_serializable<StaticGrid<Cell,size...>,typename std::enable_if<is_trivially_serializable<Cell>::value,void>::type> : public std::true_type {};
+
 } // end utils
 } // end namespace allscale
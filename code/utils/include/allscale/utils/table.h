@@ -5,6 +5,7 @@
 #include "allscale/utils/assert.h"
 #include "allscale/utils/io_utils.h"
 #include "allscale/utils/raw_buffer.h"
+#include "allscale/utils/serializer.h"
 #include "allscale/utils/printer/join.h"
 
 namespace allscale {
@@ -205,6 +206,53 @@ namespace utils {
 			return res;
 		}
 
+		/**
+		 * Stores this table in the given archive. Tables of trivially serializable
+		 * elements are written as a single block.
+		 */
+		void store(ArchiveWriter& writer) const {
+			writer.write(length);
+			storeElements(writer,is_trivially_serializable<T>());
+		}
+
+		/**
+		 * Loads a table from the given archive.
+		 */
+		static Table load(ArchiveReader& reader) {
+
+			Table res;
+
+			res.owned = true;
+			res.length = reader.read<std::size_t>();
+			res.data = allocate(res.length);
+			res.loadElements(reader,is_trivially_serializable<T>());
+
+			return res;
+		}
+
+		/**
+		 * Interprets a table stored in the given archive. If possible, the resulting table
+		 * references the data within the archive instead of owning a copy, in which case
+		 * the archive has to out-live the table.
+		 */
+		static Table interpret(ArchiveReader& reader) {
+			static_assert(is_trivially_serializable<T>::value, "Only tables of trivially serializable types can be interpreted.");
+
+			auto length = reader.read<std::size_t>();
+			auto span = reader.template read_span<T>(length);
+
+			// reference the archive directly if possible
+			if (span.isView()) return Table(const_cast<T*>(span.data()),length);
+
+			// otherwise take a copy
+			Table res;
+			res.owned = true;
+			res.length = length;
+			res.data = allocate(length);
+			span.copyTo(res.data);
+			return res;
+		}
+
 		static Table interpret(utils::RawBuffer& buffer) {
 
 			Table res;
@@ -228,6 +276,26 @@ namespace utils {
 			return reinterpret_cast<T*>(malloc(sizeof(T)*size));
 		}
 
+		void storeElements(ArchiveWriter& writer, std::true_type) const {
+			if (length > 0) writer.write(reinterpret_cast<const char*>(data),sizeof(T)*length);
+		}
+
+		void storeElements(ArchiveWriter& writer, std::false_type) const {
+			for(const auto& cur : *this) {
+				writer.write(cur);
+			}
+		}
+
+		void loadElements(ArchiveReader& reader, std::true_type) {
+			if (length > 0) reader.read(reinterpret_cast<char*>(data),sizeof(T)*length);
+		}
+
+		void loadElements(ArchiveReader& reader, std::false_type) {
+			for(auto& cur : *this) {
+				new (&cur) T(reader.read<T>());
+			}
+		}
+
 		template<typename Body>
 		void forEachPaddingByte(const Body& body) const {
 			auto c = (sizeof(T)*length) % 8;
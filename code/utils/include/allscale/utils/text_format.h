@@ -0,0 +1,803 @@
+#pragma once
+
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <locale.h>
+#include <stdlib.h>
+#ifdef __APPLE__
+	#include <xlocale.h>
+#endif
+
+namespace allscale {
+namespace utils {
+
+	// ---------------------------------------------------------------------------------
+	//								Numeric Conversion
+	// ---------------------------------------------------------------------------------
+
+	/**
+	 * The maximum number of characters produced by formatting a single numeric value.
+	 */
+	constexpr std::size_t MAX_FORMATTED_NUMBER_LENGTH = 32;
+
+	namespace detail {
+
+		inline bool isDigit(char c) {
+			return '0' <= c && c <= '9';
+		}
+
+		inline bool isSpace(char c) {
+			return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+		}
+
+		// -- conversions of the C library, fixed to the "C" locale --
+
+#ifdef _MSC_VER
+
+		inline _locale_t getCLocale() {
+			static _locale_t locale = _create_locale(LC_ALL, "C");
+			return locale;
+		}
+
+		inline void toFloating(const char* str, float& value) {
+			value = _strtof_l(str, nullptr, getCLocale());
+		}
+
+		inline void toFloating(const char* str, double& value) {
+			value = _strtod_l(str, nullptr, getCLocale());
+		}
+
+		inline void toFloating(const char* str, long double& value) {
+			value = _strtold_l(str, nullptr, getCLocale());
+		}
+
+		inline int formatScientific(char* out, std::size_t size, int precision, double value) {
+			return _snprintf_l(out, size, "%.*e", getCLocale(), precision, value);
+		}
+
+#else
+
+		inline locale_t getCLocale() {
+			static locale_t locale = newlocale(LC_ALL_MASK, "C", locale_t(0));
+			return locale;
+		}
+
+		inline void toFloating(const char* str, float& value) {
+			value = strtof_l(str, nullptr, getCLocale());
+		}
+
+		inline void toFloating(const char* str, double& value) {
+			value = strtod_l(str, nullptr, getCLocale());
+		}
+
+		inline void toFloating(const char* str, long double& value) {
+			value = strtold_l(str, nullptr, getCLocale());
+		}
+
+		inline int formatScientific(char* out, std::size_t size, int precision, double value) {
+			// there is no snprintf_l, thus the locale of the current thread is replaced temporarily
+			locale_t previous = uselocale(getCLocale());
+			int res = std::snprintf(out, size, "%.*e", precision, value);
+			uselocale(previous);
+			return res;
+		}
+
+#endif
+
+		template<typename T>
+		struct is_parsable_integer : public std::integral_constant<bool,
+				std::is_integral<T>::value && !std::is_same<T,bool>::value && !std::is_same<T,char>::value
+			> {};
+
+		template<typename T>
+		const char* parseUnsigned(const char* begin, const char* end, T& value) {
+			const char* cur = begin;
+			T res = 0;
+			while(cur != end && isDigit(*cur)) {
+				T digit = T(*cur - '0');
+				// check for overflows
+				if (res > (std::numeric_limits<T>::max() - digit) / 10) return begin;
+				res = T(res * 10 + digit);
+				++cur;
+			}
+			if (cur == begin) return begin;
+			value = res;
+			return cur;
+		}
+
+		template<typename T>
+		const char* parseSigned(const char* begin, const char* end, T& value) {
+			using U = std::make_unsigned_t<T>;
+
+			// parse the sign and the magnitude
+			bool negative = (begin != end && *begin == '-');
+			const char* start = begin + (negative ? 1 : 0);
+			U magnitude = 0;
+			const char* next = parseUnsigned(start, end, magnitude);
+			if (next == start) return begin;
+
+			// check the range
+			U limit = U(std::numeric_limits<T>::max());
+			if (magnitude > limit + (negative ? 1 : 0)) return begin;
+
+			// compute the value
+			value = (!negative) ? T(magnitude) : (magnitude > limit) ? std::numeric_limits<T>::min() : T(-T(magnitude));
+			return next;
+		}
+
+		inline bool startsWith(const char* begin, const char* end, const char* word) {
+			for(; *word; ++word, ++begin) {
+				if (begin == end || (*begin | 0x20) != *word) return false;
+			}
+			return true;
+		}
+
+		template<typename T>
+		const char* parseSpecialFloating(const char* begin, const char* end, bool negative, T& value) {
+			const char* cur = begin;
+			if (startsWith(cur, end, "infinity")) {
+				value = std::numeric_limits<T>::infinity();
+				cur += 8;
+			} else if (startsWith(cur, end, "inf")) {
+				value = std::numeric_limits<T>::infinity();
+				cur += 3;
+			} else if (startsWith(cur, end, "nan")) {
+				value = std::numeric_limits<T>::quiet_NaN();
+				cur += 3;
+			} else {
+				return nullptr;
+			}
+			if (negative) value = -value;
+			return cur;
+		}
+
+		/**
+		 * The limits of values of type T that can be converted from decimal notation by a single,
+		 * correctly rounded operation: mantissas and powers of 10 up to those limits are exact in T.
+		 */
+		template<typename T>
+		struct exact_conversion {
+			static constexpr std::uint64_t max_mantissa = 0;
+			static constexpr int max_exponent = -1;
+		};
+
+		template<>
+		struct exact_conversion<float> {
+			static constexpr std::uint64_t max_mantissa = std::uint64_t(1) << 24;
+			static constexpr int max_exponent = 10;
+		};
+
+		template<>
+		struct exact_conversion<double> {
+			static constexpr std::uint64_t max_mantissa = std::uint64_t(1) << 53;
+			static constexpr int max_exponent = 22;
+		};
+
+		template<typename T>
+		const char* parseFloating(const char* begin, const char* end, T& value) {
+
+			// exactly representable powers of 10
+			static const T powers[] = {
+				T(1e0),  T(1e1),  T(1e2),  T(1e3),  T(1e4),  T(1e5),  T(1e6),  T(1e7),  T(1e8),  T(1e9),  T(1e10), T(1e11),
+				T(1e12), T(1e13), T(1e14), T(1e15), T(1e16), T(1e17), T(1e18), T(1e19), T(1e20), T(1e21), T(1e22)
+			};
+
+			const char* cur = begin;
+
+			// parse the sign
+			bool negative = (cur != end && *cur == '-');
+			if (negative) ++cur;
+
+			// parse the digits of the mantissa, keeping up to 19 significant digits
+			std::uint64_t mantissa = 0;
+			int digits = 0;
+			int exponent = 0;
+			bool any = false;
+			bool truncated = false;
+			auto addDigit = [&](char c, bool fraction) {
+				any = true;
+				if (mantissa == 0 && c == '0') {
+					// a leading zero
+					if (fraction) exponent--;
+				} else if (digits < 19) {
+					mantissa = mantissa * 10 + (c - '0');
+					digits++;
+					if (fraction) exponent--;
+				} else {
+					// an additional digit
+					truncated = true;
+					if (!fraction) exponent++;
+				}
+			};
+
+			while(cur != end && isDigit(*cur)) {
+				addDigit(*cur++, false);
+			}
+			if (cur != end && *cur == '.') {
+				++cur;
+				while(cur != end && isDigit(*cur)) {
+					addDigit(*cur++, true);
+				}
+			}
+
+			// if there are no digits, this could still be a special value
+			if (!any) {
+				auto next = parseSpecialFloating(cur, end, negative, value);
+				return (next) ? next : begin;
+			}
+
+			// parse the exponent, if present
+			if (cur != end && (*cur == 'e' || *cur == 'E')) {
+				const char* pos = cur + 1;
+				bool negativeExponent = false;
+				if (pos != end && (*pos == '+' || *pos == '-')) {
+					negativeExponent = (*pos == '-');
+					++pos;
+				}
+				if (pos != end && isDigit(*pos)) {
+					int e = 0;
+					while(pos != end && isDigit(*pos)) {
+						if (e < 100000) e = e * 10 + (*pos - '0');
+						++pos;
+					}
+					exponent += (negativeExponent) ? -e : e;
+					cur = pos;
+				}
+			}
+
+			// fast path: mantissa and power of 10 are exact, thus the result is correctly rounded
+			using limits = exact_conversion<T>;
+			if (!truncated && mantissa <= limits::max_mantissa && -limits::max_exponent <= exponent && exponent <= limits::max_exponent) {
+				T res = T(mantissa);
+				res = (exponent < 0) ? res / powers[-exponent] : res * powers[exponent];
+				value = (negative) ? -res : res;
+				return cur;
+			}
+
+			// otherwise, resort to the C library
+			std::size_t length = cur - begin;
+			char buffer[64];
+			if (length < sizeof(buffer)) {
+				std::memcpy(buffer, begin, length);
+				buffer[length] = '\0';
+				toFloating(buffer, value);
+			} else {
+				toFloating(std::string(begin, cur).c_str(), value);
+			}
+			return cur;
+		}
+
+		template<typename T>
+		char* formatUnsigned(char* out, T value) {
+			// generate digits in reverse order
+			char buffer[24];
+			char* pos = buffer + sizeof(buffer);
+			do {
+				*--pos = char('0' + value % 10);
+				value = T(value / 10);
+			} while(value != 0);
+
+			// copy digits to output
+			std::size_t length = buffer + sizeof(buffer) - pos;
+			std::memcpy(out, pos, length);
+			return out + length;
+		}
+
+#ifdef __SIZEOF_INT128__
+
+		/**
+		 * Computes the given number (up to 17) of significant decimal digits of the given positive, finite
+		 * double, correctly rounded, such that value ~= digits * 10^(exponent-precision+1). This is covered
+		 * by 128-bit integer arithmetic for values between 1e-5 and about 1e38, other values are rejected.
+		 */
+		inline bool exactDigits(double value, int precision, std::uint64_t& digits, int& exponent) {
+			__extension__ typedef unsigned __int128 uint128;
+
+			std::uint64_t lower = 1;
+			for(int i = 1; i < precision; ++i) lower *= 10;
+			if (!(1e-5 <= value && value < 1e38)) return false;
+
+			// decompose the value into value = mantissa * 2^e
+			int e;
+			std::uint64_t mantissa = std::uint64_t(std::ldexp(std::frexp(value, &e), 53));
+			e -= 53;
+
+			// estimate the decimal exponent, corrected below if necessary
+			int x = int(std::floor(std::log10(value)));
+			for(int attempt = 0; attempt < 3; ++attempt) {
+
+				// compute round(value * 10^k), where k = precision - 1 - x
+				int k = precision - 1 - x;
+				uint128 scale = 1;
+				for(int i = 0; i < ((k < 0) ? -k : k); ++i) scale *= 10;
+
+				uint128 num = mantissa;
+				uint128 den = 1;
+				if (k >= 0) {
+					num *= scale;
+				} else {
+					den = scale;
+				}
+				if (e >= 0) {
+					if (e >= 64 || (num >> (127 - e)) != 0) return false;
+					num <<= e;
+				} else if (-e >= 127) {
+					return false;
+				} else {
+					den <<= -e;
+					if (k < 0) return false;
+				}
+
+				// divide, rounding half to even
+				uint128 res = num / den;
+				uint128 rem = num % den;
+				if (rem > den - rem || (rem == den - rem && (res & 1))) res++;
+
+				// check the number of digits
+				if (res < lower) {
+					x--;
+				} else if (res >= lower * 10) {
+					if (res == lower * 10) {
+						digits = lower;
+						exponent = x + 1;
+						return true;
+					}
+					x++;
+				} else {
+					digits = std::uint64_t(res);
+					exponent = x;
+					return true;
+				}
+			}
+			return false;
+		}
+
+#endif
+
+		/**
+		 * Writes the given significant digits d.ddd * 10^exponent the way printf's %g
+		 * conversion does for the given precision.
+		 */
+		inline char* formatGeneral(char* out, bool negative, const char* digits, int length, int exponent, int precision) {
+			if (negative) *out++ = '-';
+
+			// scientific notation
+			if (exponent < -4 || exponent >= precision) {
+				*out++ = digits[0];
+				if (length > 1) {
+					*out++ = '.';
+					std::memcpy(out, digits + 1, length - 1);
+					out += length - 1;
+				}
+				*out++ = 'e';
+				*out++ = (exponent < 0) ? '-' : '+';
+				unsigned magnitude = unsigned((exponent < 0) ? -exponent : exponent);
+				if (magnitude < 10) *out++ = '0';
+				return formatUnsigned(out, magnitude);
+			}
+
+			// values less than 1
+			if (exponent < 0) {
+				*out++ = '0';
+				*out++ = '.';
+				for(int i = exponent + 1; i < 0; ++i) *out++ = '0';
+				std::memcpy(out, digits, length);
+				return out + length;
+			}
+
+			// values of at least 1
+			for(int i = 0; i <= exponent; ++i) {
+				*out++ = (i < length) ? digits[i] : '0';
+			}
+			if (length > exponent + 1) {
+				*out++ = '.';
+				std::memcpy(out, digits + exponent + 1, length - exponent - 1);
+				out += length - exponent - 1;
+			}
+			return out;
+		}
+
+		/**
+		 * The maximum precision supported for formatting floating point values, such that the result
+		 * fits into MAX_FORMATTED_NUMBER_LENGTH characters.
+		 */
+		constexpr int MAX_FORMAT_PRECISION = int(MAX_FORMATTED_NUMBER_LENGTH) - 8;
+
+		/**
+		 * Writes the given number (up to MAX_FORMAT_PRECISION) of significant digits of the given finite
+		 * value, correctly rounded and without trailing zeros, and obtains its decimal exponent, such that
+		 * value ~= d.ddd * 10^exponent.
+		 *
+		 * @return the number of digits written
+		 */
+		template<typename T>
+		int significantDigits(T value, int precision, char* digits, int& exponent) {
+			int numDigits = 0;
+#ifdef __SIZEOF_INT128__
+			// floats are covered as well, since they are converted to double exactly
+			std::uint64_t exact;
+			if (precision <= 17 && exactDigits(std::fabs(double(value)), precision, exact, exponent)) {
+				numDigits = int(formatUnsigned(digits, exact) - digits);
+			} else
+#endif
+			{
+				// resort to the C library, formatting the value as [-]d.ddde[+-]xx
+				char buffer[2 * MAX_FORMATTED_NUMBER_LENGTH];
+				formatScientific(buffer, sizeof(buffer), precision - 1, double(value));
+				const char* pos = buffer;
+				for(; *pos != 'e'; ++pos) {
+					if (isDigit(*pos)) digits[numDigits++] = *pos;
+				}
+				exponent = std::atoi(pos + 1);
+			}
+			while(numDigits > 1 && digits[numDigits-1] == '0') numDigits--;
+			return numDigits;
+		}
+
+	} // end namespace detail
+
+	/**
+	 * Parses an integer from the given character range, similar to std::from_chars. Leading
+	 * white space and a leading '+' are not accepted, parsing stops at the first character not
+	 * being part of the number. The conversion is independent of the current locale.
+	 *
+	 * @return the position after the parsed value, or begin if no value could be parsed
+	 * 		or it is out of the range of T, in which case value is not modified
+	 */
+	template<typename T>
+	std::enable_if_t<detail::is_parsable_integer<T>::value && std::is_unsigned<T>::value, const char*>
+	parse(const char* begin, const char* end, T& value) {
+		return detail::parseUnsigned(begin, end, value);
+	}
+
+	template<typename T>
+	std::enable_if_t<detail::is_parsable_integer<T>::value && std::is_signed<T>::value, const char*>
+	parse(const char* begin, const char* end, T& value) {
+		return detail::parseSigned(begin, end, value);
+	}
+
+	/**
+	 * Parses a boolean, represented by 0 or 1, from the given character range.
+	 *
+	 * @return the position after the parsed value, or begin if no value could be parsed
+	 */
+	inline const char* parse(const char* begin, const char* end, bool& value) {
+		unsigned res;
+		auto next = parse(begin, end, res);
+		if (next == begin || res > 1) return begin;
+		value = (res == 1);
+		return next;
+	}
+
+	/**
+	 * Parses a floating point value in decimal notation, including "inf" and "nan", from
+	 * the given character range, similar to std::from_chars. Values whose significant digits
+	 * and power of 10 are exact in T are converted directly, others through the C library,
+	 * using the "C" locale. Either way, the conversion is independent of the current locale.
+	 *
+	 * @return the position after the parsed value, or begin if no value could be parsed
+	 */
+	template<typename T>
+	std::enable_if_t<std::is_floating_point<T>::value, const char*>
+	parse(const char* begin, const char* end, T& value) {
+		return detail::parseFloating(begin, end, value);
+	}
+
+	/**
+	 * Writes the decimal representation of the given integer to the given location, which
+	 * has to provide space for at least MAX_FORMATTED_NUMBER_LENGTH characters.
+	 *
+	 * @return the position after the last character written
+	 */
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value && !std::is_same<T,bool>::value, char*> format(char* out, T value) {
+		using U = std::make_unsigned_t<T>;
+		if (value >= 0) return detail::formatUnsigned(out, U(value));
+		*out++ = '-';
+		return detail::formatUnsigned(out, U(U(0) - U(value)));
+	}
+
+	/**
+	 * Writes the given boolean as 0 or 1 to the given location, the representation accepted by parse.
+	 *
+	 * @return the position after the character written
+	 */
+	inline char* format(char* out, bool value) {
+		*out++ = value ? '1' : '0';
+		return out;
+	}
+
+	/**
+	 * Writes the representation of the given floating point value to the given location, which
+	 * has to provide space for at least MAX_FORMATTED_NUMBER_LENGTH characters, in the layout of
+	 * printf's %g conversion in the "C" locale. If no precision is given, the fewest significant
+	 * digits between digits10 and max_digits10 of T restoring the value when being parsed are
+	 * used; larger precisions are limited to detail::MAX_FORMAT_PRECISION.
+	 *
+	 * @return the position after the last character written
+	 */
+	template<typename T>
+	std::enable_if_t<std::is_floating_point<T>::value, char*> format(char* out, T value, int precision = 0) {
+
+		// handle special values
+		if (value != value) {
+			std::memcpy(out, "nan", 3);
+			return out + 3;
+		}
+		if (value == std::numeric_limits<T>::infinity() || value == -std::numeric_limits<T>::infinity()) {
+			if (value < 0) *out++ = '-';
+			std::memcpy(out, "inf", 3);
+			return out + 3;
+		}
+
+		bool negative = std::signbit(value);
+		char digits[2 * MAX_FORMATTED_NUMBER_LENGTH];
+
+		// use the requested precision
+		if (precision > 0) {
+			precision = std::min(precision, detail::MAX_FORMAT_PRECISION);
+			int exponent = 0;
+			int length = detail::significantDigits(value, precision, digits, exponent);
+			return detail::formatGeneral(out, negative, digits, length, exponent, precision);
+		}
+
+		// find the fewest significant digits restoring the value
+		const int maxPrecision = std::numeric_limits<T>::max_digits10;
+		for(int p = std::numeric_limits<T>::digits10; ; ++p) {
+			int exponent = 0;
+			int length = detail::significantDigits(value, p, digits, exponent);
+			char* end = detail::formatGeneral(out, negative, digits, length, exponent, p);
+			if (p == maxPrecision) return end;
+			T restored = T();
+			if (parse(out, end, restored) == end && restored == value) return end;
+		}
+	}
+
+
+
+	// ---------------------------------------------------------------------------------
+	//								Text Readers and Writers
+	// ---------------------------------------------------------------------------------
+
+	/**
+	 * A utility for parsing text stored in a memory buffer, e.g. a memory mapped file,
+	 * as a fast alternative to std::istream based formatted input. Values are separated
+	 * by white space. Once a value could not be parsed, the reader enters a failed state
+	 * and ignores further read operations.
+	 */
+	class TextReader {
+
+		const char* cur;
+
+		const char* end;
+
+		bool ok;
+
+	public:
+
+		TextReader(const char* begin, const char* end)
+			: cur(begin), end(end), ok(true) {}
+
+		/**
+		 * The position of the next character to be consumed.
+		 */
+		const char* getPosition() const {
+			return cur;
+		}
+
+		/**
+		 * The end of the text covered by this reader.
+		 */
+		const char* getEnd() const {
+			return end;
+		}
+
+		/**
+		 * Determines whether all values have been consumed, thus only white space is left.
+		 */
+		bool atEnd() {
+			skipWhitespace();
+			return cur == end;
+		}
+
+		/**
+		 * Determines whether all read operations have been successful so far.
+		 */
+		explicit operator bool() const {
+			return ok;
+		}
+
+		/**
+		 * Reads a value of the given type.
+		 */
+		template<typename T>
+		T read() {
+			T res = T();
+			*this >> res;
+			return res;
+		}
+
+		/**
+		 * Reads a numeric value.
+		 */
+		template<typename T>
+		std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T,char>::value, TextReader&>
+		operator>>(T& value) {
+			if (!ok) return *this;
+			skipWhitespace();
+			auto next = parse(cur, end, value);
+			if (next == cur) {
+				ok = false;
+			}
+			cur = next;
+			return *this;
+		}
+
+		/**
+		 * Reads the next character that is not white space.
+		 */
+		TextReader& operator>>(char& value) {
+			if (!ok) return *this;
+			skipWhitespace();
+			if (cur == end) {
+				ok = false;
+				return *this;
+			}
+			value = *cur++;
+			return *this;
+		}
+
+		/**
+		 * Reads a word, delimited by white space.
+		 */
+		TextReader& operator>>(std::string& value) {
+			if (!ok) return *this;
+			skipWhitespace();
+			const char* begin = cur;
+			while(cur != end && !detail::isSpace(*cur)) ++cur;
+			if (begin == cur) {
+				ok = false;
+				return *this;
+			}
+			value.assign(begin, cur);
+			return *this;
+		}
+
+		/**
+		 * Obtains a reader for the rest of the current line, excluding the line break,
+		 * and moves this reader to the start of the next line.
+		 */
+		TextReader nextLine() {
+			const char* begin = cur;
+			const char* pos = static_cast<const char*>(std::memchr(cur, '\n', end - cur));
+			const char* lineEnd = (pos) ? pos : end;
+			cur = (pos) ? pos + 1 : end;
+			if (lineEnd != begin && *(lineEnd - 1) == '\r') --lineEnd;
+			return TextReader(begin, lineEnd);
+		}
+
+		/**
+		 * Moves this reader to the start of the next line.
+		 */
+		void skipLine() {
+			nextLine();
+		}
+
+	private:
+
+		void skipWhitespace() {
+			while(cur != end && detail::isSpace(*cur)) ++cur;
+		}
+
+	};
+
+	/**
+	 * A utility for formatting text into a memory buffer, as a fast alternative to
+	 * std::ostream based formatted output. Floating point values are written with as many
+	 * digits as needed to restore their value, unless a precision is set.
+	 */
+	class TextWriter {
+
+		std::string buffer;
+
+		int precision;
+
+	public:
+
+		TextWriter() : precision(0) {}
+
+		/**
+		 * Sets the number of significant digits of floating point values, or 0 for
+		 * the shortest representation restoring the value.
+		 */
+		void setPrecision(int digits) {
+			precision = digits;
+		}
+
+		/**
+		 * Writes a numeric value.
+		 */
+		template<typename T>
+		std::enable_if_t<std::is_integral<T>::value && !std::is_same<T,char>::value && !std::is_same<T,bool>::value, TextWriter&>
+		operator<<(T value) {
+			auto pos = buffer.size();
+			buffer.resize(pos + MAX_FORMATTED_NUMBER_LENGTH);
+			auto next = format(&buffer[pos], value);
+			buffer.resize(next - buffer.data());
+			return *this;
+		}
+
+		template<typename T>
+		std::enable_if_t<std::is_floating_point<T>::value, TextWriter&>
+		operator<<(T value) {
+			auto pos = buffer.size();
+			buffer.resize(pos + MAX_FORMATTED_NUMBER_LENGTH);
+			auto next = format(&buffer[pos], value, precision);
+			buffer.resize(next - buffer.data());
+			return *this;
+		}
+
+		TextWriter& operator<<(char value) {
+			buffer.push_back(value);
+			return *this;
+		}
+
+		/**
+		 * Writes a boolean as 0 or 1.
+		 */
+		TextWriter& operator<<(bool value) {
+			buffer.push_back(value ? '1' : '0');
+			return *this;
+		}
+
+		TextWriter& operator<<(const char* value) {
+			buffer.append(value);
+			return *this;
+		}
+
+		TextWriter& operator<<(const std::string& value) {
+			buffer.append(value);
+			return *this;
+		}
+
+		/**
+		 * Appends the given number of characters.
+		 */
+		TextWriter& write(const char* data, std::size_t count) {
+			buffer.append(data, count);
+			return *this;
+		}
+
+		const char* data() const {
+			return buffer.data();
+		}
+
+		std::size_t size() const {
+			return buffer.size();
+		}
+
+		const std::string& str() const {
+			return buffer;
+		}
+
+		void reserve(std::size_t size) {
+			buffer.reserve(size);
+		}
+
+		void clear() {
+			buffer.clear();
+		}
+
+	};
+
+} // end namespace utils
+} // end namespace allscale
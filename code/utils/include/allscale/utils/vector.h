@@ -414,5 +414,11 @@ namespace utils {
 	template<typename T, std::size_t Dims>
 	struct serializer<Vector<T,Dims>,typename std::enable_if<is_serializable<T>::value,void>::type> : public serializer<std::array<T,Dims>> {};
 
+	/**
+	 * Vectors of trivially serializable elements are trivially serializable.
+	 */
+	template<typename T, std::size_t Dims>
+	struct is_trivially_serializable<Vector<T,Dims>,typename std::enable_if<is_trivially_serializable<T>::value && sizeof(Vector<T,Dims>) == sizeof(std::array<T,Dims>),void>::type> : public std::true_type {};
+
 } // end namespace utils
 } // end namespace allscale
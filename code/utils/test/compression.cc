@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "allscale/utils/compression.h"
+#include "allscale/utils/serializer/strings.h"
+#include "allscale/utils/serializer/vectors.h"
+
+namespace allscale {
+namespace utils {
+
+	namespace {
+
+		std::vector<char> roundTrip(const std::vector<char>& data, const CompressionOptions& options) {
+			auto compressed = compress(data.data(), data.size(), options);
+			std::vector<char> res;
+			EXPECT_TRUE(decompress(compressed.data(), compressed.size(), res));
+			return res;
+		}
+
+		template<typename T>
+		std::vector<char> toBytes(const std::vector<T>& values) {
+			auto begin = reinterpret_cast<const char*>(values.data());
+			return std::vector<char>(begin, begin + values.size() * sizeof(T));
+		}
+
+	}
+
+	TEST(Compression, Filters) {
+		std::vector<char> data(103);
+		for(std::size_t i = 0; i < data.size(); ++i) data[i] = char(i * 7);
+
+		for(std::size_t size : { 1, 2, 3, 4, 8, 12 }) {
+			std::vector<char> shuffled(data.size()), restored(data.size());
+			detail::shuffle(data.data(), shuffled.data(), data.size(), size);
+			detail::unshuffle(shuffled.data(), restored.data(), data.size(), size);
+			EXPECT_EQ(data, restored) << "Element size: " << size;
+		}
+
+		// the first bytes of all elements are grouped
+		std::vector<char> shuffled(8);
+		detail::shuffle("abcdefgh", shuffled.data(), 8, 2);
+		EXPECT_EQ("acegbdfh", std::string(shuffled.begin(), shuffled.end()));
+
+		for(std::size_t size : { 1, 2, 4, 8 }) {
+			auto copy = data;
+			detail::delta(copy.data(), copy.size(), size, false);
+			detail::delta(copy.data(), copy.size(), size, true);
+			EXPECT_EQ(data, copy) << "Element size: " << size;
+		}
+	}
+
+	TEST(Compression, Codec) {
+		std::mt19937 random(42);
+
+		std::vector<std::vector<char>> inputs;
+		inputs.push_back({});
+		inputs.push_back({ 'a' });
+		inputs.push_back(std::vector<char>(100000, 'x'));
+
+		// random data is not compressible
+		std::vector<char> noise(100000);
+		for(auto& cur : noise) cur = char(random());
+		inputs.push_back(noise);
+
+		// text with repetitions of various lengths and distances
+		std::string text;
+		for(int i = 0; i < 20000; ++i) text += "node " + std::to_string(i % 97) + " edge " + std::to_string(i % 13) + "\n";
+		inputs.push_back(std::vector<char>(text.begin(), text.end()));
+
+		for(const auto& input : inputs) {
+			std::vector<char> buffer(input.size() + 1);
+			auto size = detail::lzCompress(input.data(), input.size(), buffer.data(), buffer.size());
+			if (size == 0) continue;
+			std::vector<char> res(input.size());
+			EXPECT_TRUE(detail::lzDecompress(buffer.data(), size, res.data(), res.size()));
+			EXPECT_EQ(input, res);
+
+			// truncated data is rejected
+			if (size > 1) {
+				EXPECT_FALSE(detail::lzDecompress(buffer.data(), size - 1, res.data(), res.size()));
+			}
+		}
+
+		// repetitive data is compressed considerably
+		std::vector<char> buffer(text.size());
+		auto size = detail::lzCompress(text.data(), text.size(), buffer.data(), buffer.size());
+		EXPECT_LT(0, size);
+		EXPECT_LT(size * 2, text.size());
+
+		// incompressible data does not fit
+		buffer.resize(noise.size());
+		EXPECT_EQ(0, detail::lzCompress(noise.data(), noise.size(), buffer.data(), buffer.size()));
+	}
+
+	TEST(Compression, RoundTrip) {
+
+		// a smooth field of doubles
+		std::vector<double> field(100000);
+		for(std::size_t i = 0; i < field.size(); ++i) field[i] = std::sin(i * 0.001) * 100;
+		auto data = toBytes(field);
+
+		// a sequence of increasing indices
+		std::vector<std::int32_t> indices(100000);
+		for(std::size_t i = 0; i < indices.size(); ++i) indices[i] = std::int32_t(i * 3 + i % 5);
+		auto index = toBytes(indices);
+
+		for(auto filter : { CompressionFilter::None, CompressionFilter::Shuffle, CompressionFilter::Delta, CompressionFilter::DeltaShuffle }) {
+			CompressionOptions options;
+			options.filter = filter;
+			options.chunkSize = 10000;
+			EXPECT_EQ(data, roundTrip(data, options));
+
+			options.elementSize = 4;
+			EXPECT_EQ(index, roundTrip(index, options));
+
+			// incomplete elements are supported
+			std::vector<char> odd(data.begin(), data.begin() + 12345);
+			EXPECT_EQ(odd, roundTrip(odd, options));
+		}
+
+		// filters improve the compression of numeric data
+		CompressionOptions plain;
+		plain.filter = CompressionFilter::None;
+		CompressionOptions filtered;
+		filtered.filter = CompressionFilter::DeltaShuffle;
+		filtered.elementSize = 4;
+		auto a = compress(index.data(), index.size(), plain);
+		auto b = compress(index.data(), index.size(), filtered);
+		EXPECT_LT(b.size() * 4, a.size());
+
+		// nothing to compress
+		EXPECT_TRUE(compress(nullptr, 0).empty());
+	}
+
+	TEST(Compression, Malformed) {
+		std::string text;
+		for(int i = 0; i < 1000; ++i) text += std::to_string(i % 10);
+		auto compressed = compress(text.data(), text.size());
+
+		std::vector<char> res;
+		EXPECT_FALSE(decompress(compressed.data(), compressed.size() - 1, res));
+		res.clear();
+		EXPECT_FALSE(decompress(compressed.data(), 5, res));
+
+		// an unknown codec
+		compressed[10] = 7;
+		res.clear();
+		EXPECT_FALSE(decompress(compressed.data(), compressed.size(), res));
+	}
+
+	TEST(Compression, Archives) {
+
+		std::vector<double> values(50000);
+		for(std::size_t i = 0; i < values.size(); ++i) values[i] = i * 0.25;
+		std::vector<std::string> names = { "a", "bc", std::string(1000, 'd') };
+
+		// stream the archive through a compressor into a buffer
+		std::vector<char> stored;
+		{
+			CompressionOptions options;
+			options.chunkSize = 4096;
+			auto writer = createCompressingWriter([&](const char* data, std::size_t size) {
+				stored.insert(stored.end(), data, data + size);
+			}, options);
+			writer.write(values);
+			writer.write(names);
+			writer.write(12);
+		}
+		EXPECT_LT(stored.size() * 2, values.size() * sizeof(double));
+
+		// followed by some unrelated data
+		std::size_t archiveSize = stored.size();
+		std::string trailer = "trailing data";
+		stored.insert(stored.end(), trailer.begin(), trailer.end());
+
+		std::size_t pos = 0;
+		auto source = [&](char* dst, std::size_t count) -> std::size_t {
+			std::size_t res = std::min<std::size_t>({ count, 100, stored.size() - pos });
+			std::memcpy(dst, stored.data() + pos, res);
+			pos += res;
+			return res;
+		};
+
+		// read it back in small pieces, stopping at the end of the compressed data
+		{
+			auto reader = createDecompressingReader(source);
+			EXPECT_EQ(values, reader.read<std::vector<double>>());
+			EXPECT_EQ(names, reader.read<std::vector<std::string>>());
+			EXPECT_EQ(12, reader.read<int>());
+		}
+		EXPECT_EQ(archiveSize, pos);
+
+		// the same holds if not all the data is consumed
+		pos = 0;
+		{
+			auto reader = createDecompressingReader(source);
+			EXPECT_EQ(values, reader.read<std::vector<double>>());
+		}
+		EXPECT_EQ(archiveSize, pos);
+		EXPECT_EQ(trailer, std::string(stored.data() + pos, stored.size() - pos));
+
+		// empty archives are terminated as well
+		stored.clear();
+		{
+			auto writer = createCompressingWriter([&](const char* data, std::size_t size) {
+				stored.insert(stored.end(), data, data + size);
+			});
+		}
+		EXPECT_FALSE(stored.empty());
+		archiveSize = stored.size();
+		stored.insert(stored.end(), trailer.begin(), trailer.end());
+		pos = 0;
+		{
+			auto reader = createDecompressingReader(source);
+		}
+		EXPECT_EQ(archiveSize, pos);
+	}
+
+} // end namespace utils
+} // end namespace allscale
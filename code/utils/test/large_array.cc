@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
 #include "allscale/utils/large_array.h"
 #include "allscale/utils/string_utils.h"
 
@@ -8,6 +12,16 @@ namespace utils {
 
 	using namespace detail;
 
+	namespace {
+
+		// a path for a temporary file of the given name, placed in the temp directory instead of the working directory
+		std::string getTempFile(const std::string& name) {
+			const char* dir = std::getenv("TMPDIR");
+			return std::string((dir && *dir) ? dir : "/tmp") + "/" + name;
+		}
+
+	}
+
 	TEST(Intervals,Covered) {
 
 		Intervals r;
@@ -355,6 +369,101 @@ namespace utils {
 
 
 
+	}
+
+	TEST(Intervals,FromRanges) {
+
+		EXPECT_EQ("{}",toString(Intervals::fromRanges({})));
+		EXPECT_EQ("{[10-20]}",toString(Intervals::fromRanges({{10,20}})));
+
+		// unsorted, overlapping, adjacent and empty ranges
+		EXPECT_EQ("{[10-30],[40-50]}",toString(Intervals::fromRanges({{40,50},{20,30},{10,20},{12,15},{35,35}})));
+
+	}
+
+	TEST(Intervals,AddIntervals) {
+
+		Intervals a = Intervals::fromRanges({{10,20},{40,50},{70,80}});
+
+		// adding nothing
+		Intervals b = a;
+		b.add(Intervals());
+		EXPECT_EQ(a,b);
+
+		// adding to nothing
+		b = Intervals();
+		b.add(a);
+		EXPECT_EQ(a,b);
+
+		// adding overlapping and gap-closing intervals
+		b = a;
+		b.add(Intervals::fromRanges({{5,12},{20,40},{60,65},{75,90}}));
+		EXPECT_EQ("{[5-50],[60-65],[70-90]}",toString(b));
+
+		// the result must be the same as when adding individually
+		Intervals c = a;
+		c.add(5,12);
+		c.add(20,40);
+		c.add(60,65);
+		c.add(75,90);
+		EXPECT_EQ(c,b);
+
+	}
+
+	TEST(Intervals,RemoveIntervals) {
+
+		Intervals a = Intervals::fromRanges({{10,20},{40,50},{70,80}});
+
+		Intervals b = a;
+		b.remove(Intervals::fromRanges({{5,12},{15,16},{18,45},{60,65},{75,90}}));
+		EXPECT_EQ("{[12-15],[16-18],[45-50],[70-75]}",toString(b));
+
+		// remove everything
+		b = a;
+		b.remove(Intervals::fromRange(0,100));
+		EXPECT_TRUE(b.empty());
+
+		// compare with individual removals
+		Intervals c = a;
+		c.remove(5,12);
+		c.remove(15,16);
+		c.remove(18,45);
+		c.remove(60,65);
+		c.remove(75,90);
+		b = a;
+		b.remove(Intervals::fromRanges({{5,12},{15,16},{18,45},{60,65},{75,90}}));
+		EXPECT_EQ(c,b);
+
+	}
+
+	TEST(Intervals,RandomizedBatchUpdates) {
+
+		// compare batched updates with individual updates on pseudo-random input
+		unsigned seed = 1;
+		auto next = [&]() { seed = seed * 1103515245 + 12345; return (seed / 65536) % 1000; };
+
+		Intervals batched;
+		Intervals individual;
+		for(int round=0; round<100; round++) {
+			std::vector<std::pair<std::size_t,std::size_t>> ranges;
+			for(int i=0; i<10; i++) {
+				std::size_t from = next();
+				ranges.push_back({ from, from + next() % 50 });
+			}
+
+			if (round % 2 == 0) {
+				batched.add(Intervals::fromRanges(ranges));
+				for(const auto& cur : ranges) individual.add(cur.first,cur.second);
+			} else {
+				batched.remove(Intervals::fromRanges(ranges));
+				for(const auto& cur : ranges) individual.remove(cur.first,cur.second);
+			}
+
+			for(std::size_t i=0; i<1100; i++) {
+				ASSERT_EQ(individual.covers(i),batched.covers(i)) << "Round " << round << ", index " << i;
+			}
+		}
+
 	}
 
 	TEST(LargeArray, Basic) {
@@ -441,6 +550,98 @@ namespace utils {
 
 	}
 
+	TEST(LargeArray, HugePages) {
+
+		// create a large array of 64 MiB backed by huge pages
+		int N = (64 * 1024 * 1024) / sizeof(int);
+		LargeArray<int> a(N, PagingPolicy::HugePages);
+
+		// the reservation should be aligned to huge pages
+		a.allocate(0,N);
+		EXPECT_EQ(0, ((uintptr_t)&a[0]) % LargeArray<int>::HUGE_PAGE_SIZE);
+
+		// initialize range
+		for(int i=0; i<N; i++) {
+			a[i] = i;
+		}
+
+		// free a section in the middle
+		a.free(N/4+17,N/2+33);
+
+		for(int i=0; i<N; i++) {
+			if (i < N/4+17 || i >= N/2+33) {
+				EXPECT_EQ(a[i],i) << "Error at index " << i;
+			}
+		}
+
+		// re-allocate and use the freed section
+		a.allocate(N/4+17,N/2+33);
+		for(int i=N/4+17; i<N/2+33; i++) {
+			a[i] = i;
+		}
+		for(int i=0; i<N; i++) {
+			EXPECT_EQ(a[i],i) << "Error at index " << i;
+		}
+
+		// move to another instance
+		LargeArray<int> b(std::move(a));
+		EXPECT_EQ(N-1,b[N-1]);
+
+	}
+
+	TEST(LargeArray, Prefault) {
+
+		// create a large array
+		int N = 1000000;
+		LargeArray<int> a(N);
+
+		// allocate and initialize a range
+		a.allocate(100,2000);
+		for(int i=100; i<2000; i++) {
+			a[i] = i;
+		}
+
+		// prefaulting an initialized range does not alter its content
+		a.prefault(100,2000);
+		for(int i=100; i<2000; i++) {
+			EXPECT_EQ(a[i],i) << "Error at index " << i;
+		}
+
+		// prefault a fresh range
+		a.allocate(5000,N);
+		a.prefault(5000,N);
+		for(int i=5000; i<N; i++) {
+			EXPECT_EQ(0,a[i]) << "Error at index " << i;
+		}
+
+		// empty ranges are ignored
+		a.prefault(10,10);
+
+	}
+
+	TEST(LargeArray, BatchedAllocateAndFree) {
+
+		// create a large array
+		int N = 1000000;
+		LargeArray<int> a(N);
+
+		// allocate a list of ranges at once
+		a.allocate(Intervals::fromRanges({{0,1000},{5000,300000},{400000,N}}));
+
+		for(int i=0; i<1000; i++) a[i] = i;
+		for(int i=5000; i<300000; i++) a[i] = i;
+		for(int i=400000; i<N; i++) a[i] = i;
+
+		// free a list of ranges at once
+		a.free(Intervals::fromRanges({{500,6000},{100000,200000}}));
+
+		for(int i=0; i<500; i++) EXPECT_EQ(i,a[i]);
+		for(int i=6000; i<100000; i++) EXPECT_EQ(i,a[i]);
+		for(int i=200000; i<300000; i++) EXPECT_EQ(i,a[i]);
+		for(int i=400000; i<N; i++) EXPECT_EQ(i,a[i]);
+
+	}
+
 #ifndef _MSC_VER
 
 	TEST(DISABLED_LargeArray, MemoryManagement) {
@@ -516,6 +717,109 @@ namespace utils {
 	}
 
 
+	TEST(LargeArray, FileBacked) {
+
+		const std::string file = getTempFile("large_array_file_backed.bin");
+
+		// create a file-backed array of 1 MiB
+		int N = (1024 * 1024) / sizeof(int);
+		{
+			LargeArray<int> a(N, file);
+			EXPECT_TRUE(a.isFileBacked());
+
+			// allocate and fill the array
+			a.allocate(0,N);
+			a.advise(0,N,AccessPattern::Sequential);
+			for(int i=0; i<N; i++) {
+				a[i] = i;
+			}
+
+			// free a section in the middle, punching a hole into the file
+			a.free(N/4+17,N/2+33);
+
+			// drop the remaining data from memory, it has to be preserved in the file
+			a.flush();
+			a.advise(0,N,AccessPattern::DontNeed);
+
+			for(int i=0; i<N; i++) {
+				if (i < N/4+17 || i >= N/2+33) {
+					EXPECT_EQ(a[i],i) << "Error at index " << i;
+				}
+			}
+
+			// re-allocate the freed section
+			a.allocate(N/4+17,N/2+33);
+			for(int i=N/4+17; i<N/2+33; i++) {
+				a[i] = i;
+			}
+
+			// move to another instance
+			LargeArray<int> b(std::move(a));
+			EXPECT_FALSE(a.isFileBacked());
+			EXPECT_TRUE(b.isFileBacked());
+			b.flush(0,N);
+		}
+
+		// the content is persisted in the file
+		{
+			LargeArray<int> a(N, file);
+			a.allocate(0,N);
+			for(int i=0; i<N; i++) {
+				EXPECT_EQ(a[i],i) << "Error at index " << i;
+			}
+		}
+
+		std::remove(file.c_str());
+	}
+
+	TEST(LargeArray, FileBackedEmpty) {
+
+		const std::string file = getTempFile("large_array_file_backed_empty.bin");
+
+		// the lowest free descriptor is handed out by the next open call
+		int probe = open("/dev/null", O_RDONLY);
+		ASSERT_NE(-1,probe);
+		close(probe);
+
+		// empty arrays still open their backing file
+		for(int i=0; i<10; i++) {
+			LargeArray<int> a(0, file);
+			EXPECT_TRUE(a.isFileBacked());
+			LargeArray<int> b(std::move(a));
+			EXPECT_TRUE(b.isFileBacked());
+		}
+
+		// but do not leak its descriptor
+		int next = open("/dev/null", O_RDONLY);
+		EXPECT_EQ(probe,next);
+		close(next);
+
+		std::remove(file.c_str());
+	}
+
+	TEST(LargeArray, Advise) {
+
+		// hints are supported for anonymous arrays, yet must not discard any data
+		int N = 1000000;
+		LargeArray<int> a(N);
+		EXPECT_FALSE(a.isFileBacked());
+
+		a.allocate(0,N);
+		for(int i=0; i<N; i++) {
+			a[i] = i;
+		}
+
+		a.advise(0,N,AccessPattern::Random);
+		a.advise(0,N,AccessPattern::WillNeed);
+		a.advise(0,N,AccessPattern::DontNeed);
+		a.advise(0,N,AccessPattern::Normal);
+		a.flush();
+
+		for(int i=0; i<N; i++) {
+			EXPECT_EQ(a[i],i) << "Error at index " << i;
+		}
+	}
+
 	struct InstanceCounted {
 
 		static int num_instances;
@@ -585,6 +889,31 @@ namespace utils {
 
 	}
 
+	TEST(LargeArray,BatchedCtorsAndDtors) {
+
+		EXPECT_EQ(0,InstanceCounted::num_instances);
+
+		{
+			LargeArray<InstanceCounted> a(10000);
+
+			// allocate some elements
+			a.allocate(Intervals::fromRanges({{100,200},{300,400}}));
+			EXPECT_EQ(200,InstanceCounted::num_instances);
+
+			// allocate overlapping elements
+			a.allocate(Intervals::fromRanges({{150,250},{350,450}}));
+			EXPECT_EQ(300,InstanceCounted::num_instances);
+
+			// free partially allocated ranges
+			a.free(Intervals::fromRanges({{0,120},{240,320},{440,500}}));
+			EXPECT_EQ(240,InstanceCounted::num_instances);
+
+		}
+
+		EXPECT_EQ(0,InstanceCounted::num_instances);
+
+	}
+
 #endif
 
 } // end namespace utils
@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
 #include "allscale/utils/serializer.h"
+#include "allscale/utils/serializer/arrays.h"
+#include "allscale/utils/serializer/strings.h"
+#include "allscale/utils/serializer/vectors.h"
 
 namespace allscale {
 namespace utils {
@@ -115,6 +123,309 @@ namespace utils {
 		EXPECT_EQ(x,reader2.read<int>());
 	}
 
+	TEST(ArchiveWriter, Reserve) {
+
+		ArchiveWriter writer(1000);
+		EXPECT_EQ(0,writer.size());
+
+		writer.write(0);
+		EXPECT_EQ(sizeof(int),writer.size());
+		EXPECT_EQ(sizeof(int),std::move(writer).toArchive().getBuffer().size());
+
+		ArchiveWriter writer2;
+		writer2.reserve(100 * sizeof(int));
+		for(int i=0; i<100; i++) {
+			writer2.write(i);
+		}
+		EXPECT_EQ(100 * sizeof(int),writer2.size());
+
+		Archive a = std::move(writer2).toArchive();
+		ArchiveReader reader(a);
+		for(int i=0; i<100; i++) {
+			EXPECT_EQ(i,reader.read<int>());
+		}
+	}
+
+	TEST(ArchiveWriter, BufferReuse) {
+
+		// pools are maintained per thread, thus a fresh thread starts with an empty pool
+		std::thread([]{
+			// a released buffer is handed out again
+			std::vector<char> buffer;
+			buffer.reserve(1024);
+			auto ptr = buffer.data();
+			detail::BufferPool::release(std::move(buffer));
+
+			auto reused = detail::BufferPool::acquire(1000);
+			EXPECT_EQ(ptr,reused.data());
+			EXPECT_TRUE(reused.empty());
+			EXPECT_LE(1024,reused.capacity());
+
+			// buffers are only handed out for requests of a similar size
+			detail::BufferPool::release(std::move(reused));
+			EXPECT_EQ(0,detail::BufferPool::acquire(4096).capacity());
+			EXPECT_EQ(0,detail::BufferPool::acquire(16).capacity());
+			EXPECT_EQ(ptr,detail::BufferPool::acquire(300).data());
+
+			// large buffers are not retained
+			std::vector<char> large;
+			large.reserve(64 * 1024 * 1024);
+			detail::BufferPool::release(std::move(large));
+			EXPECT_EQ(0,detail::BufferPool::acquire(64 * 1024 * 1024).capacity());
+
+			// nor are more buffers than the retained bytes are limited to
+			for(int i=0; i<4; i++) {
+				std::vector<char> cur;
+				cur.reserve(3 * 1024 * 1024);
+				detail::BufferPool::release(std::move(cur));
+			}
+			int retained = 0;
+			while(detail::BufferPool::acquire(3 * 1024 * 1024).capacity() > 0) retained++;
+			EXPECT_EQ(2,retained);
+
+			// archives return their buffers to the pool when being destroyed
+			const char* last = nullptr;
+			for(int i=0; i<10; i++) {
+				Archive a = serialize(i);
+				EXPECT_EQ(i,deserialize<int>(a));
+				if (last) {
+					EXPECT_EQ(last,a.getBuffer().data());
+				}
+				last = a.getBuffer().data();
+			}
+		}).join();
+
+		// writers without a size hint reuse the most recently released buffer
+		std::thread([]{
+			const char* ptr = nullptr;
+			{
+				ArchiveWriter writer;
+				for(int i=0; i<1000; i++) writer.write(i);
+				Archive a = std::move(writer).toArchive();
+				ptr = a.getBuffer().data();
+			}
+
+			ArchiveWriter writer;
+			writer.write(std::string("hello"));
+			Archive a = std::move(writer).toArchive();
+			EXPECT_EQ(ptr,a.getBuffer().data());
+		}).join();
+	}
+
+	TEST(ArchiveReader, ReadSpan) {
+
+		ArchiveWriter writer;
+		writer.write(5);
+		writer.write(char('x'));
+		for(int i=0; i<10; i++) {
+			writer.write(i);
+		}
+
+		Archive a = std::move(writer).toArchive();
+
+		// the aligned sequence is referenced in place
+		ArchiveReader reader1(a);
+		auto aligned = reader1.read_span<int>(2);
+		EXPECT_TRUE(aligned.isView());
+		EXPECT_EQ(a.getBuffer().data(),reinterpret_cast<const char*>(aligned.data()));
+		EXPECT_EQ(5,aligned[0]);
+
+		// the unaligned sequence is copied
+		ArchiveReader reader2(a);
+		EXPECT_EQ(5,reader2.read<int>());
+		EXPECT_EQ('x',reader2.read<char>());
+		auto unaligned = reader2.read_span<int>(10);
+		EXPECT_FALSE(unaligned.isView());
+		ASSERT_EQ(10,unaligned.size());
+		int i = 0;
+		for(const auto& cur : unaligned) {
+			EXPECT_EQ(i++,cur);
+		}
+	}
+
+	TEST(ArchiveWriter, Streaming) {
+
+		std::vector<char> out;
+		std::size_t maxBlock = 0;
+		{
+			ArchiveWriter writer([&](const char* src, std::size_t count) {
+				out.insert(out.end(),src,src+count);
+				maxBlock = std::max(maxBlock,count);
+			}, 64);
+			EXPECT_TRUE(writer.isStreaming());
+
+			for(int i=0; i<1000; i++) {
+				writer.write(i);
+			}
+			EXPECT_EQ(1000 * sizeof(int),writer.size());
+
+			// large blocks are passed on directly
+			std::vector<char> block(100,'x');
+			writer.write(block.data(),block.size());
+			EXPECT_EQ(100,maxBlock);
+		}
+
+		// remaining data is flushed on destruction
+		EXPECT_EQ(1000 * sizeof(int) + 100,out.size());
+		EXPECT_EQ(100,maxBlock);
+
+		// read data through a small buffer
+		std::size_t pos = 0;
+		ArchiveReader reader([&](char* dst, std::size_t count) {
+			count = std::min(count,out.size()-pos);
+			std::memcpy(dst,&out[pos],count);
+			pos += count;
+			return count;
+		}, 48);
+
+		for(int i=0; i<1000; i++) {
+			EXPECT_EQ(i,reader.read<int>());
+		}
+		std::vector<char> block(100);
+		reader.read(block.data(),block.size());
+		EXPECT_EQ(std::vector<char>(100,'x'),block);
+	}
+
+	TEST(ArchiveWriter, MoveAssignment) {
+
+		std::vector<char> first;
+		std::vector<char> second;
+
+		ArchiveWriter writer([&](const char* src, std::size_t count) {
+			first.insert(first.end(),src,src+count);
+		}, 64);
+		writer.write(1);
+
+		// data buffered for the replaced sink is flushed
+		writer = ArchiveWriter([&](const char* src, std::size_t count) {
+			second.insert(second.end(),src,src+count);
+		}, 64);
+		EXPECT_EQ(sizeof(int),first.size());
+
+		writer.write(2);
+		writer.flush();
+		EXPECT_EQ(sizeof(int),first.size());
+		EXPECT_EQ(sizeof(int),second.size());
+	}
+
+	TEST(ArchiveReader, Rewind) {
+
+		Archive archive = serialize(std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8 });
+		const auto& data = archive.getBuffer();
+
+		std::size_t pos = 0;
+		auto source = [&](char* dst, std::size_t count) {
+			count = std::min(count,data.size()-pos);
+			std::memcpy(dst,&data[pos],count);
+			pos += count;
+			return count;
+		};
+
+		{
+			ArchiveReader reader(source, 32, [&](std::size_t count) { pos -= count; });
+			EXPECT_EQ(8,reader.read<std::size_t>());
+			EXPECT_EQ(1,reader.read<int>());
+			EXPECT_LT(sizeof(std::size_t) + sizeof(int),pos);
+		}
+
+		// the data read ahead has been given back
+		EXPECT_EQ(sizeof(std::size_t) + sizeof(int),pos);
+
+		// a reader without buffer still makes progress
+		ArchiveReader reader(source, 0);
+		for(int i=2; i<=8; i++) {
+			EXPECT_EQ(i,reader.read<int>());
+		}
+	}
+
+#ifndef _MSC_VER
+
+	TEST(ArchiveWriter, FileDescriptor) {
+
+		FILE* file = std::tmpfile();
+		ASSERT_TRUE(file);
+		int fd = fileno(file);
+
+		{
+			auto writer = ArchiveWriter::toFileDescriptor(fd,16);
+			for(int i=0; i<100; i++) {
+				writer.write(i * 0.5);
+			}
+		}
+
+		lseek(fd,0,SEEK_SET);
+
+		{
+			auto reader = ArchiveReader::fromFileDescriptor(fd,24);
+			for(int i=0; i<50; i++) {
+				EXPECT_EQ(i * 0.5,reader.read<double>());
+			}
+		}
+
+		// the remaining data is still available through the descriptor
+		auto reader = ArchiveReader::fromFileDescriptor(fd,16);
+		for(int i=50; i<100; i++) {
+			EXPECT_EQ(i * 0.5,reader.read<double>());
+		}
+
+		std::fclose(file);
+	}
+
+#endif
+
+	struct Composite {
+		int x;
+		std::string name;
+		void store(ArchiveWriter& writer) const {
+			writer.write(x);
+			writer.write(name);
+		}
+		static Composite load(ArchiveReader& reader) {
+			auto x = reader.read<int>();
+			auto name = reader.read<std::string>();
+			return { x, name };
+		}
+	};
+
+	TEST(SerializedSize, Fixed) {
+
+		static_assert(serialized_size<int>::is_fixed, "Should be fixed!");
+		static_assert(serialized_size<int>::value == sizeof(int), "Wrong size!");
+		static_assert(serialized_size<const double>::value == sizeof(double), "Wrong size!");
+		static_assert(serialized_size<std::array<int,4>>::value == 4 * sizeof(int), "Wrong size!");
+		static_assert(serialized_size<std::array<std::array<char,3>,2>>::value == 6, "Wrong size!");
+
+		EXPECT_EQ(sizeof(int),serialized_size<int>::get(12));
+		EXPECT_EQ(sizeof(int),serialize(12).getBuffer().size());
+	}
+
+	TEST(SerializedSize, Dynamic) {
+
+		EXPECT_FALSE(serialized_size<std::string>::is_fixed);
+		EXPECT_FALSE(serialized_size<std::vector<int>>::is_fixed);
+		EXPECT_FALSE(serialized_size<Composite>::is_fixed);
+
+		std::string str = "Hello";
+		EXPECT_EQ(serialize(str).getBuffer().size(),serialized_size<std::string>::get(str));
+
+		std::vector<int> ints = { 1, 2, 3 };
+		EXPECT_EQ(serialize(ints).getBuffer().size(),serialized_size<std::vector<int>>::get(ints));
+
+		std::vector<std::string> strs = { "a", "bc", "def" };
+		EXPECT_EQ(serialize(strs).getBuffer().size(),serialized_size<std::vector<std::string>>::get(strs));
+
+		std::array<std::string,2> arr = {{ "x", "yz" }};
+		EXPECT_EQ(serialize(arr).getBuffer().size(),(serialized_size<std::array<std::string,2>>::get(arr)));
+
+		// others are measured by a dry run
+		Composite c { 12, "Hello" };
+		EXPECT_EQ(serialize(c).getBuffer().size(),serialized_size<Composite>::get(c));
+		EXPECT_EQ(sizeof(int)+sizeof(std::size_t)+5,serialized_size<Composite>::get(c));
+
+		std::vector<Composite> cs = { c, c };
+		EXPECT_EQ(serialize(cs).getBuffer().size(),serialized_size<std::vector<Composite>>::get(cs));
+	}
+
 	TEST(SerializeDeserialize, Int) {
 
 		int x = 10;
@@ -124,5 +435,45 @@ namespace utils {
 
 	}
 
+	TEST(DISABLED_Serializer, Benchmark) {
+
+		// boxes of the same layout as a 3D grid box: two corners of three coordinates
+		using box = std::array<std::array<int64_t,3>,2>;
+		static_assert(is_trivially_serializable<box>::value, "Should be trivially serializable!");
+
+		std::vector<box> boxes(1000);
+		for(std::size_t i = 0; i < boxes.size(); ++i) {
+			boxes[i] = {{ {{ int64_t(i), 0, 0 }}, {{ int64_t(i+1), 10, 10 }} }};
+		}
+
+		auto time = [](const std::string& name, const auto& op) {
+			auto begin = std::chrono::high_resolution_clock::now();
+			op();
+			auto end = std::chrono::high_resolution_clock::now();
+			std::cout << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+		};
+
+		const int N = 2000;
+		time("vector of boxes, round trip", [&]{
+			for(int i = 0; i < N; ++i) {
+				Archive a = serialize(boxes);
+				EXPECT_EQ(boxes.size(),deserialize<std::vector<box>>(a).size());
+			}
+		});
+
+		const int M = 2000000;
+		time("single box, round trip", [&]{
+			int64_t sum = 0;
+			for(int i = 0; i < M; ++i) {
+				ArchiveWriter writer(sizeof(box));
+				writer.write(boxes[i % boxes.size()]);
+				Archive a = std::move(writer).toArchive();
+				ArchiveReader reader(a);
+				sum += reader.read<box>()[1][0];
+			}
+			EXPECT_LT(0,sum);
+		});
+	}
+
 } // end namespace utils
 } // end namespace allscale
@@ -91,5 +91,19 @@ namespace utils {
 		EXPECT_EQ(in,out);
 	}
 
+	TEST(Serializer,ArraysBulk) {
+
+		EXPECT_TRUE((is_trivially_serializable<std::array<double,4>>::value));
+		EXPECT_TRUE((is_trivially_serializable<std::array<std::array<double,4>,3>>::value));
+		EXPECT_FALSE((is_trivially_serializable<std::array<std::string,4>>::value));
+
+		std::array<std::array<double,4>,3> in {{ {{ 1, 2, 3, 4 }}, {{ 5, 6, 7, 8 }}, {{ 9, 10, 11, 12 }} }};
+		auto archive = serialize(in);
+		EXPECT_EQ(sizeof(in), archive.getBuffer().size());
+
+		auto out = deserialize<std::array<std::array<double,4>,3>>(archive);
+		EXPECT_EQ(in,out);
+	}
+
 } // end namespace utils
 } // end namespace allscale
@@ -96,5 +96,61 @@ namespace utils {
 		EXPECT_EQ(in,out);
 	}
 
+	TEST(Serializer,StdVectorBulk) {
+
+		// elements of primitive types are serialized as a block
+		EXPECT_TRUE(is_trivially_serializable<double>::value);
+		EXPECT_FALSE(is_trivially_serializable<std::string>::value);
+		EXPECT_FALSE(is_trivially_serializable<std::vector<double>>::value);
+
+		std::vector<double> in;
+		for(int i=0; i<1000; i++) {
+			in.push_back(i * 0.5);
+		}
+
+		auto archive = serialize(in);
+		EXPECT_EQ(sizeof(std::size_t) + 1000 * sizeof(double), archive.getBuffer().size());
+
+		// the format is the same as for element-wise serialization
+		ArchiveWriter writer;
+		writer.write(in.size());
+		for(const auto& cur : in) {
+			writer.write(cur);
+		}
+		EXPECT_EQ(std::move(writer).toArchive().getBuffer(), archive.getBuffer());
+
+		auto out = deserialize<std::vector<double>>(archive);
+		EXPECT_EQ(in,out);
+
+		// also empty vectors are supported
+		std::vector<double> empty;
+		archive = serialize(empty);
+		EXPECT_EQ(empty, deserialize<std::vector<double>>(archive));
+	}
+
+	TEST(Serializer,StdVectorBool) {
+		// std::vector<bool> is not stored contiguously, yet supported
+		std::vector<bool> in { true, false, false, true, true };
+		auto archive = serialize(in);
+		auto out = deserialize<std::vector<bool>>(archive);
+		EXPECT_EQ(in,out);
+	}
+
+	TEST(Serializer,StdVectorOfArraysBulk) {
+
+		EXPECT_TRUE((is_trivially_serializable<std::array<int,3>>::value));
+
+		std::vector<std::array<int,3>> in;
+		for(int i=0; i<100; i++) {
+			in.push_back({{ i, i+1, i+2 }});
+		}
+
+		auto archive = serialize(in);
+		EXPECT_EQ(sizeof(std::size_t) + 300 * sizeof(int), archive.getBuffer().size());
+
+		auto out = deserialize<std::vector<std::array<int,3>>>(archive);
+		EXPECT_EQ(in,out);
+	}
+
 } // end namespace utils
 } // end namespace allscale
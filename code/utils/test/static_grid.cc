@@ -104,6 +104,31 @@ namespace utils {
 
 	}
 
+	TEST(StaticGrid3D, BulkSerialization) {
+
+		using grid_type = StaticGrid<double, 4, 5, 6>;
+
+		EXPECT_TRUE(utils::is_trivially_serializable<grid_type>::value);
+
+		grid_type grid;
+		double count = 0;
+		grid.forEach([&count](double& element) {
+			element = count++;
+		});
+
+		// the grid is written as a single block
+		utils::Archive archive = utils::serialize(grid);
+		EXPECT_EQ(4*5*6*sizeof(double), archive.getBuffer().size());
+
+		grid_type newGrid = utils::deserialize<grid_type>(archive);
+
+		count = 0;
+		newGrid.forEach([&count](const double& element) {
+			EXPECT_EQ(count++, element);
+		});
+
+	}
+
 	TEST(StaticGrid2D, NonTrivialElements) {
 
 		struct A {
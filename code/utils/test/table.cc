@@ -5,6 +5,7 @@
 #include "allscale/utils/table.h"
 #include "allscale/utils/string_utils.h"
 #include "allscale/utils/printer/vectors.h"
+#include "allscale/utils/serializer/vectors.h"
 
 namespace allscale {
 namespace utils {
@@ -131,5 +132,63 @@ namespace utils {
 		EXPECT_EQ("[1,2,3,4]",toString(table));
 	}
 
+	TEST(Table,Serialization) {
+
+		Table<double> in(100);
+		for(std::size_t i=0; i<in.size(); i++) {
+			in[i] = i * 0.25;
+		}
+
+		EXPECT_TRUE(is_serializable<Table<double>>::value);
+
+		auto archive = serialize(in);
+		EXPECT_EQ(sizeof(std::size_t) + 100 * sizeof(double), archive.getBuffer().size());
+
+		auto out = deserialize<Table<double>>(archive);
+		EXPECT_TRUE(out.isOwner());
+		EXPECT_EQ(toString(in), toString(out));
+	}
+
+	TEST(Table,InterpretArchive) {
+
+		Table<double> in(100);
+		for(std::size_t i=0; i<in.size(); i++) {
+			in[i] = i * 0.25;
+		}
+
+		auto archive = serialize(in);
+
+		// the table data is referenced within the archive
+		ArchiveReader reader(archive);
+		auto view = Table<double>::interpret(reader);
+		EXPECT_FALSE(view.isOwner());
+		EXPECT_EQ(archive.getBuffer().data() + sizeof(std::size_t), reinterpret_cast<const char*>(view.begin()));
+		EXPECT_EQ(toString(in), toString(view));
+
+		// if not aligned, a copy is created
+		ArchiveWriter writer;
+		writer.write(char(1));
+		writer.write(in);
+		auto archive2 = std::move(writer).toArchive();
+
+		ArchiveReader reader2(archive2);
+		EXPECT_EQ(1,reader2.read<char>());
+		auto copy = Table<double>::interpret(reader2);
+		EXPECT_TRUE(copy.isOwner());
+		EXPECT_EQ(toString(in), toString(copy));
+	}
+
+	TEST(Table,SerializationNonTrivial) {
+
+		Table<std::vector<int>> in(3);
+		in[0].push_back(1);
+		in[2].push_back(2);
+		in[2].push_back(3);
+
+		auto archive = serialize(in);
+		auto out = deserialize<Table<std::vector<int>>>(archive);
+		EXPECT_EQ("[[1],[],[2,3]]", toString(out));
+	}
+
 } // end namespace utils
 } // end namespace allscale
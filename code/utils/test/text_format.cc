@@ -0,0 +1,371 @@
+#include <gtest/gtest.h>
+
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "allscale/utils/text_format.h"
+
+namespace allscale {
+namespace utils {
+
+	template<typename T>
+	bool parseAll(const std::string& text, T& value) {
+		const char* begin = text.c_str();
+		const char* end = begin + text.size();
+		auto next = parse(begin, end, value);
+		return next != begin && next == end;
+	}
+
+	template<typename T>
+	std::string formatValue(T value) {
+		char buffer[MAX_FORMATTED_NUMBER_LENGTH];
+		return std::string(buffer, format(buffer, value));
+	}
+
+	TEST(TextFormat,ParseIntegers) {
+
+		int i = 0;
+		EXPECT_TRUE(parseAll("0", i));
+		EXPECT_EQ(0, i);
+		EXPECT_TRUE(parseAll("12345", i));
+		EXPECT_EQ(12345, i);
+		EXPECT_TRUE(parseAll("-42", i));
+		EXPECT_EQ(-42, i);
+		EXPECT_TRUE(parseAll("2147483647", i));
+		EXPECT_EQ(2147483647, i);
+		EXPECT_TRUE(parseAll("-2147483648", i));
+		EXPECT_EQ(std::numeric_limits<int>::min(), i);
+
+		// invalid inputs and overflows leave the value unchanged
+		i = 7;
+		EXPECT_FALSE(parseAll("", i));
+		EXPECT_FALSE(parseAll("-", i));
+		EXPECT_FALSE(parseAll("+1", i));
+		EXPECT_FALSE(parseAll(" 1", i));
+		EXPECT_FALSE(parseAll("2147483648", i));
+		EXPECT_FALSE(parseAll("-2147483649", i));
+		EXPECT_EQ(7, i);
+
+		unsigned u = 0;
+		EXPECT_FALSE(parseAll("-1", u));
+		EXPECT_TRUE(parseAll("4294967295", u));
+		EXPECT_EQ(4294967295u, u);
+
+		std::uint64_t l = 0;
+		EXPECT_TRUE(parseAll("18446744073709551615", l));
+		EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), l);
+		EXPECT_FALSE(parseAll("18446744073709551616", l));
+
+		std::int8_t s = 0;
+		EXPECT_TRUE(parseAll("-128", s));
+		EXPECT_EQ(-128, s);
+		EXPECT_FALSE(parseAll("128", s));
+
+		bool b = false;
+		EXPECT_TRUE(parseAll("1", b));
+		EXPECT_TRUE(b);
+		EXPECT_FALSE(parseAll("2", b));
+
+		// parsing stops at the first non-digit
+		std::string text = "123abc";
+		EXPECT_EQ(text.c_str() + 3, parse(text.c_str(), text.c_str() + text.size(), i));
+		EXPECT_EQ(123, i);
+	}
+
+	TEST(TextFormat,ParseFloatingPoint) {
+
+		double d = 0;
+		EXPECT_TRUE(parseAll("1.5", d));
+		EXPECT_EQ(1.5, d);
+		EXPECT_TRUE(parseAll("-0.125", d));
+		EXPECT_EQ(-0.125, d);
+		EXPECT_TRUE(parseAll("3", d));
+		EXPECT_EQ(3.0, d);
+		EXPECT_TRUE(parseAll(".5", d));
+		EXPECT_EQ(0.5, d);
+		EXPECT_TRUE(parseAll("5.", d));
+		EXPECT_EQ(5.0, d);
+		EXPECT_TRUE(parseAll("1e3", d));
+		EXPECT_EQ(1000.0, d);
+		EXPECT_TRUE(parseAll("2.5E-2", d));
+		EXPECT_EQ(0.025, d);
+		EXPECT_TRUE(parseAll("1e-320", d));
+		EXPECT_EQ(1e-320, d);
+		EXPECT_TRUE(parseAll("1.7976931348623157e308", d));
+		EXPECT_EQ(std::numeric_limits<double>::max(), d);
+		EXPECT_TRUE(parseAll("0.1000000000000000055511151231257827", d));
+		EXPECT_EQ(0.1, d);
+		EXPECT_TRUE(parseAll("-inf", d));
+		EXPECT_EQ(-std::numeric_limits<double>::infinity(), d);
+		EXPECT_TRUE(parseAll("nan", d));
+		EXPECT_TRUE(std::isnan(d));
+
+		// an incomplete exponent is not part of the number
+		std::string text = "2e+";
+		EXPECT_EQ(text.c_str() + 1, parse(text.c_str(), text.c_str() + text.size(), d));
+		EXPECT_EQ(2.0, d);
+
+		d = 7;
+		EXPECT_FALSE(parseAll("", d));
+		EXPECT_FALSE(parseAll("-", d));
+		EXPECT_FALSE(parseAll(".", d));
+		EXPECT_FALSE(parseAll("e5", d));
+		EXPECT_EQ(7.0, d);
+
+		float f = 0;
+		EXPECT_TRUE(parseAll("0.1", f));
+		EXPECT_EQ(0.1f, f);
+	}
+
+	TEST(TextFormat,ParseFloatDirectly) {
+		// just below the midpoint of two floats, but rounded onto it when converted to double first
+		float f = 0;
+		EXPECT_TRUE(parseAll("1.00000017881393432617187499", f));
+		EXPECT_EQ(1.00000011920928955078125f, f);
+
+		// exact conversions
+		EXPECT_TRUE(parseAll("16777216", f));
+		EXPECT_EQ(16777216.0f, f);
+		EXPECT_TRUE(parseAll("3.4e38", f));
+		EXPECT_EQ(3.4e38f, f);
+	}
+
+	TEST(TextFormat,ParseMatchesStrtod) {
+		std::mt19937_64 gen(42);
+		std::uniform_int_distribution<std::uint64_t> mantissas;
+		std::uniform_int_distribution<int> exponents(-40,40);
+		std::uniform_int_distribution<int> lengths(1,20);
+		for(int i=0; i<100000; i++) {
+			// create a random decimal number
+			std::string text = std::to_string(mantissas(gen)).substr(0, lengths(gen));
+			text.insert(text.size() / 2, ".");
+			text += "e" + std::to_string(exponents(gen));
+
+			double d;
+			EXPECT_TRUE(parseAll(text, d)) << text;
+			EXPECT_EQ(std::strtod(text.c_str(), nullptr), d) << text;
+		}
+	}
+
+	TEST(TextFormat,Format) {
+
+		EXPECT_EQ("0", formatValue(0));
+		EXPECT_EQ("-17", formatValue(-17));
+		EXPECT_EQ("-2147483648", formatValue(std::numeric_limits<int>::min()));
+		EXPECT_EQ("18446744073709551615", formatValue(std::numeric_limits<std::uint64_t>::max()));
+		EXPECT_EQ("-128", formatValue(std::int8_t(-128)));
+		EXPECT_EQ("1", formatValue(true));
+		EXPECT_EQ("0", formatValue(false));
+
+		EXPECT_EQ("0", formatValue(0.0));
+		EXPECT_EQ("1.5", formatValue(1.5));
+		EXPECT_EQ("0.1", formatValue(0.1));
+		EXPECT_EQ("0.1", formatValue(0.1f));
+		EXPECT_EQ("1e+100", formatValue(1e100));
+		EXPECT_EQ("-0", formatValue(-0.0));
+		EXPECT_EQ("123456.789", formatValue(123456.789));
+		EXPECT_EQ("0.0001234", formatValue(0.0001234));
+		EXPECT_EQ("1.234e-05", formatValue(0.00001234));
+		EXPECT_EQ("100000000000000", formatValue(1e14));
+		EXPECT_EQ("1e+15", formatValue(1e15));
+		EXPECT_EQ("0.30000000000000004", formatValue(0.1 + 0.2));
+		EXPECT_EQ("-0.3333333333333333", formatValue(-1 / 3.0));
+		EXPECT_EQ("4.94065645841247e-324", formatValue(std::numeric_limits<double>::denorm_min()));
+		EXPECT_EQ("1.7976931348623157e+308", formatValue(std::numeric_limits<double>::max()));
+		EXPECT_EQ("inf", formatValue(std::numeric_limits<double>::infinity()));
+		EXPECT_EQ("nan", formatValue(std::numeric_limits<double>::quiet_NaN()));
+
+		char buffer[MAX_FORMATTED_NUMBER_LENGTH];
+		EXPECT_EQ("3.14", std::string(buffer, format(buffer, 3.14159, 3)));
+	}
+
+	TEST(TextFormat,RoundTrip) {
+		std::mt19937_64 gen(42);
+		for(int i=0; i<100000; i++) {
+			// create random bit patterns for doubles
+			std::uint64_t bits = gen();
+			double value;
+			std::memcpy(&value, &bits, sizeof(value));
+			if (std::isnan(value)) continue;
+
+			double restored;
+			std::string text = formatValue(value);
+			EXPECT_TRUE(parseAll(text, restored)) << text;
+			EXPECT_EQ(value, restored) << text;
+
+			std::int64_t l = std::int64_t(bits);
+			std::int64_t restoredLong;
+			EXPECT_TRUE(parseAll(formatValue(l), restoredLong));
+			EXPECT_EQ(l, restoredLong);
+		}
+	}
+
+	TEST(TextFormat,FormatMatchesPrintf) {
+		std::mt19937_64 gen(42);
+		std::uniform_real_distribution<double> mantissas(1,10);
+		std::uniform_int_distribution<int> exponents(-10,40);
+		for(int i=0; i<100000; i++) {
+			double value = mantissas(gen) * std::pow(10.0, exponents(gen));
+
+			// the reference: the first printf %g precision restoring the value
+			char expected[MAX_FORMATTED_NUMBER_LENGTH];
+			for(int p = 15; p <= 17; p++) {
+				std::snprintf(expected, sizeof(expected), "%.*g", p, value);
+				if (std::strtod(expected, nullptr) == value) break;
+			}
+			EXPECT_EQ(std::string(expected), formatValue(value));
+			EXPECT_EQ("-" + std::string(expected), formatValue(-value));
+		}
+	}
+
+	TEST(TextFormat,FormatPrecisionMatchesPrintf) {
+		std::mt19937_64 gen(42);
+		std::uniform_real_distribution<double> mantissas(1,10);
+		std::uniform_int_distribution<int> exponents(-320,300);
+		std::uniform_int_distribution<int> precisions(1,20);
+		for(int i=0; i<100000; i++) {
+			double value = mantissas(gen) * std::pow(10.0, exponents(gen));
+			int precision = precisions(gen);
+
+			char expected[MAX_FORMATTED_NUMBER_LENGTH];
+			std::snprintf(expected, sizeof(expected), "%.*g", precision, value);
+			char buffer[MAX_FORMATTED_NUMBER_LENGTH];
+			EXPECT_EQ(std::string(expected), std::string(buffer, format(buffer, value, precision)));
+
+			std::snprintf(expected, sizeof(expected), "%.*g", precision, double(float(value)));
+			EXPECT_EQ(std::string(expected), std::string(buffer, format(buffer, float(value), precision)));
+		}
+	}
+
+	TEST(TextFormat,LocaleIndependence) {
+
+		// switch to a locale with a decimal comma, if there is any
+		std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+		for(auto name : { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR" }) {
+			if (std::setlocale(LC_NUMERIC, name)) break;
+		}
+
+		// values converted through the C library
+		double d = 0;
+		EXPECT_TRUE(parseAll("1.00000000000000000000001", d));
+		EXPECT_EQ(1.0, d);
+		float f = 0;
+		EXPECT_TRUE(parseAll("0.1", f));
+		EXPECT_EQ(0.1f, f);
+
+		EXPECT_EQ("1.7976931348623157e+308", formatValue(std::numeric_limits<double>::max()));
+		EXPECT_EQ("9.99988867182683e-321", formatValue(1e-320));
+		EXPECT_EQ("3.4028235e+38", formatValue(std::numeric_limits<float>::max()));
+		char buffer[MAX_FORMATTED_NUMBER_LENGTH];
+		EXPECT_EQ("0.33333333333333331483", std::string(buffer, format(buffer, 1 / 3.0, 21)));
+
+		std::setlocale(LC_NUMERIC, previous.c_str());
+	}
+
+	TEST(TextReader,Basic) {
+
+		std::string text = "  12 -3.5\n word x\t7 ";
+		TextReader reader(text.c_str(), text.c_str() + text.size());
+
+		int i;
+		double d;
+		std::string s;
+		char c;
+		EXPECT_TRUE(reader >> i >> d >> s >> c);
+		EXPECT_EQ(12, i);
+		EXPECT_EQ(-3.5, d);
+		EXPECT_EQ("word", s);
+		EXPECT_EQ('x', c);
+		EXPECT_EQ(7, reader.read<int>());
+		EXPECT_TRUE(reader.atEnd());
+		EXPECT_TRUE(reader);
+
+		// reading beyond the end fails
+		EXPECT_FALSE(reader >> i);
+		EXPECT_FALSE(reader >> s);
+	}
+
+	TEST(TextReader,Failure) {
+
+		std::string text = "1 abc 2";
+		TextReader reader(text.c_str(), text.c_str() + text.size());
+
+		int i = 0;
+		EXPECT_TRUE(reader >> i);
+		EXPECT_EQ(1, i);
+		EXPECT_FALSE(reader >> i);
+		EXPECT_EQ(1, i);
+
+		// the reader remains in the failed state
+		std::string s;
+		EXPECT_FALSE(reader >> s);
+	}
+
+	TEST(TextReader,Lines) {
+
+		std::string text = "1 2\r\n3\n\n4 5 6";
+		TextReader reader(text.c_str(), text.c_str() + text.size());
+
+		std::vector<std::vector<int>> lines;
+		while(reader.getPosition() != reader.getEnd()) {
+			auto line = reader.nextLine();
+			std::vector<int> values;
+			while(!line.atEnd()) {
+				values.push_back(line.read<int>());
+			}
+			EXPECT_TRUE(line);
+			lines.push_back(values);
+		}
+
+		EXPECT_EQ(4, lines.size());
+		EXPECT_EQ((std::vector<int>{ 1, 2 }), lines[0]);
+		EXPECT_EQ((std::vector<int>{ 3 }), lines[1]);
+		EXPECT_EQ((std::vector<int>{ }), lines[2]);
+		EXPECT_EQ((std::vector<int>{ 4, 5, 6 }), lines[3]);
+	}
+
+	TEST(TextWriter,Basic) {
+
+		TextWriter writer;
+		writer << 12 << ' ' << -3.5 << " word " << std::string("x") << '\n';
+		writer << 0.1 << " " << 1u << " " << 2.5f;
+		EXPECT_EQ("12 -3.5 word x\n0.1 1 2.5", writer.str());
+		EXPECT_EQ(writer.str().size(), writer.size());
+
+		// booleans are written as parsed
+		writer.clear();
+		writer << true << ' ' << false;
+		EXPECT_EQ("1 0", writer.str());
+		bool b = false;
+		EXPECT_TRUE(parseAll(writer.str().substr(0,1), b));
+		EXPECT_TRUE(b);
+
+		writer.clear();
+		writer.setPrecision(3);
+		writer << 3.14159;
+		EXPECT_EQ("3.14", writer.str());
+
+		// the output can be read by streams
+		writer.clear();
+		writer.setPrecision(0);
+		for(int i=0; i<100; i++) {
+			writer << i << " " << (i / 7.0) << "\n";
+		}
+		std::stringstream in(writer.str());
+		for(int i=0; i<100; i++) {
+			int x;
+			double y;
+			in >> x >> y;
+			EXPECT_EQ(i, x);
+			EXPECT_EQ(i / 7.0, y);
+		}
+	}
+
+} // end namespace utils
+} // end namespace allscale
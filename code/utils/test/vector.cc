@@ -4,6 +4,7 @@
 #include "allscale/utils/vector.h"
 
 #include "allscale/utils/serializer/strings.h"
+#include "allscale/utils/serializer/vectors.h"
 
 namespace allscale {
 namespace utils {
@@ -382,5 +383,25 @@ namespace utils {
 		EXPECT_EQ(in,out);
 	}
 
+	TEST(Vector, BulkSerialization) {
+
+		EXPECT_TRUE((is_trivially_serializable<Vector<double,2>>::value));
+		EXPECT_TRUE((is_trivially_serializable<Vector<double,3>>::value));
+		EXPECT_TRUE((is_trivially_serializable<Vector<int,5>>::value));
+		EXPECT_FALSE((is_trivially_serializable<Vector<std::string,3>>::value));
+
+		// a list of vectors is written as a single block
+		std::vector<Vector<double,3>> in;
+		for(int i=0; i<10; i++) {
+			in.push_back(Vector<double,3>(i+0.0, i+0.5, i+0.25));
+		}
+
+		auto archive = serialize(in);
+		EXPECT_EQ(sizeof(std::size_t) + 30 * sizeof(double), archive.getBuffer().size());
+
+		auto out = deserialize<std::vector<Vector<double,3>>>(archive);
+		EXPECT_EQ(in,out);
+	}
+
 } // end namespace utils
 } // end namespace allscale